@@ -2,8 +2,49 @@
 #include <QPainter>
 #include <QMessageBox>
 #include <algorithm>
+#include <cmath>
 #include <QPainterPath>
 
+#include "BooleanOp.h"
+#include "ConvexIntersection.h"
+#include "MartinezClipper.h"
+#include "ConvexHull.h"
+#include "PolygonUtils.h"
+#include "Triangulation.h"
+#include "ConstrainedDelaunay.h"
+#include "Voronoi.h"
+
+namespace {
+
+// QPointF 与几何库 Point 之间的转换，是界面层与算法层之间唯一的数据边界
+inline Geometry::Point toGeometry(const QPointF &p)
+{
+    return {p.x(), p.y()};
+}
+
+std::vector<Geometry::Point> toGeometry(const QVector<QPointF> &pts)
+{
+    std::vector<Geometry::Point> out;
+    out.reserve(pts.size());
+    for (const QPointF &p : pts) out.push_back(toGeometry(p));
+    return out;
+}
+
+inline QPointF toQt(const Geometry::Point &p)
+{
+    return QPointF(p.x, p.y);
+}
+
+QVector<QPointF> toQt(Geometry::PointSpan pts)
+{
+    QVector<QPointF> out;
+    out.reserve(static_cast<int>(pts.size()));
+    for (const Geometry::Point &p : pts) out.push_back(toQt(p));
+    return out;
+}
+
+} // namespace
+
 /**
  * @brief DrawingWidget 类的构造函数
  * @param parent 父窗口部件指针
@@ -56,7 +97,7 @@ void DrawingWidget::setMode(Mode newMode)
 {
     /*在用户点击菜单项时被调用，负责完成几项关键任务：清空当前图形、更新模式状态、弹出提示指导用户下一步操作*/
 
-    clearScreen();//清除所有绘图数据，包括：已添加的点（points）、多边形顶点（polygonVertices）、三角形剖分结果（triangles）、面积数据（polygonArea）
+    clearScreen();//清除所有绘图数据，包括：已添加的点（points）、多边形顶点（polygonVertices）、三角形剖分结果（triangleMesh）、面积数据（polygonArea）
     currentMode = newMode;
 
     if (currentMode == ADD_POINTS_CONVEX_HULL) {
@@ -90,6 +131,10 @@ void DrawingWidget::clearScreen()
     taskToPerform.clear();//清空任务标识，例如 "convexHull"、"area" 或 "triangulate"
     points.clear();//清除凸包计算的点集
     convexHull.clear();//清除凸包结果的点集
+    delaunayEdges.clear();//清除点集的 Delaunay 边
+    voronoiEdges.clear();//清除 Voronoi 边
+    incrementalHull.clear();//清除在线维护的凸包
+    dynamicHull.clear();//清除动态凸包
     convexHullAlgorithm.clear(); //重置算法选择
 
     polygonsReadyForOperation = false;//标记为“尚未准备好”状态，防止执行交并操作
@@ -97,11 +142,24 @@ void DrawingWidget::clearScreen()
     emit polygonsReady(false); //在还没画好多边形时发射信号通知主窗口禁用交并菜单项
     polygonA.clear();
     polygonB.clear();
+    polygonAVersion.touch();
+    polygonBVersion.touch();
     intersectionPolygons.clear();
     unionPath.clear();
+    clipResultPolygons.clear();
+    booleanOpCache.clear();
 
     polygonVertices.clear();//清除用户绘制的多边形顶点
-    triangles.clear();//清除三角剖分生成的三角形列表
+    steinerPoints.clear();//清除约束 Delaunay 的附加内部点
+    outerRingClosed = false;//带孔洞模式重新从外边界开始画
+    polygonHoles.clear();//清除已闭合的孔洞
+    currentHole.clear();//清除正在绘制的孔洞
+    polygonVerticesVersion.touch();
+    currentHoleVersion.touch();
+    drawingRing.clear();//清除逐点检查用的边索引
+    drawingRingSource = nullptr;
+    rejectedEdges.clear();
+    triangleMesh = Geometry::HalfEdgeMesh();//清除三角剖分生成的网格
     polygonArea = -1.0;//重置面积值为无效状态（负值表示未计算）
     triangleCount = -1;//重置三角形数量
     showGrid = false;//重置网格显示状态
@@ -123,6 +181,14 @@ void DrawingWidget::performCalculation()
             calculateConvexHull_Andrew();
         } else if (convexHullAlgorithm == "Graham") {
             calculateConvexHull_Graham();
+        } else if (convexHullAlgorithm == "Chan") {
+            calculateConvexHull_Chan();
+        } else if (convexHullAlgorithm == "Parallel") {
+            calculateConvexHull_Parallel();
+        } else if (convexHullAlgorithm == "Incremental") {
+            calculateConvexHull_Incremental();
+        } else if (convexHullAlgorithm == "Dynamic") {
+            calculateConvexHull_Dynamic();
         } else {
             // 提供一个备用提示，以防用户未通过菜单选择
             QMessageBox::information(this, "提示", "请先从“算法”->“计算凸包”菜单中选择一种具体算法。");
@@ -138,7 +204,7 @@ void DrawingWidget::performCalculation()
 
         // 在这里进行最终的、完整的合法性检查
         // 注意：现在 isSimplePolygon 内部已经包含了对零长度边的检查
-        if (!isSimplePolygon(polygonVertices)) {
+        if (!isSimplePolygon(polygonVertices, polygonVerticesVersion)) {
             QMessageBox::warning(this, "错误", "多边形存在自相交或不合法（如零长度边），无法计算！");
             return;
         }
@@ -152,7 +218,7 @@ void DrawingWidget::performCalculation()
 
         //处理交集计算的逻辑
         else if (currentMode == DRAW_POLYGON_B && polygonB.size() >= 3) {
-            calculateIntersectionAndUnion();
+            calculateBooleanOp_QPainterPath(Geometry::BooleanOpType::Intersection);
         }
     }
     update();
@@ -180,6 +246,115 @@ void DrawingWidget::startGrahamConvexHull()
     emit modeChanged("当前模式：计算凸包 (Graham)。请添加点后点击“执行计算”。");
 }
 
+/**
+ * @brief 响应菜单，开始准备进行 Chan 算法凸包计算
+ * @details 将模式设置为 ADD_POINTS_CONVEX_HULL，并记录用户的算法选择。
+ */
+void DrawingWidget::startChanConvexHull()
+{
+    setMode(ADD_POINTS_CONVEX_HULL);
+    convexHullAlgorithm = "Chan";
+    emit modeChanged("当前模式：计算凸包 (Chan)。请添加点后点击“执行计算”。");
+}
+
+/**
+ * @brief 响应菜单，开始准备进行多线程分治凸包计算
+ * @details 将模式设置为 ADD_POINTS_CONVEX_HULL，并记录用户的算法选择。
+ */
+void DrawingWidget::startParallelConvexHull()
+{
+    setMode(ADD_POINTS_CONVEX_HULL);
+    convexHullAlgorithm = "Parallel";
+    emit modeChanged("当前模式：计算凸包 (并行分治)。请添加点后点击“执行计算”。");
+}
+
+/**
+ * @brief 响应菜单，开始在线增量凸包
+ * @details 将模式设置为 ADD_POINTS_CONVEX_HULL。与其他算法不同，此模式下每次左键加点都会
+ * 立即更新凸包，无需点击“执行计算”。
+ */
+void DrawingWidget::startIncrementalConvexHull()
+{
+    setMode(ADD_POINTS_CONVEX_HULL);
+    convexHullAlgorithm = "Incremental";
+    emit modeChanged("当前模式：计算凸包 (增量)。每添加一个点凸包都会实时更新。");
+}
+
+/**
+ * @brief 响应菜单，开始全动态凸包
+ * @details 将模式设置为 ADD_POINTS_CONVEX_HULL。此模式下左键加点、右键删除最近的点，
+ * 凸包在每次增删后立即更新。
+ */
+void DrawingWidget::startDynamicConvexHull()
+{
+    setMode(ADD_POINTS_CONVEX_HULL);
+    convexHullAlgorithm = "Dynamic";
+    emit modeChanged("当前模式：计算凸包 (动态)。左键添加点，右键删除点，凸包实时更新。");
+}
+
+/**
+ * @brief 设置凸包计算前的 Akl–Toussaint 内点预过滤方式
+ * @param prefilter 不过滤、四边形或八边形
+ * @details 该选项对 Andrew、Graham、Chan 三种算法都生效，属于用户设置，clearScreen() 不会重置它。
+ */
+void DrawingWidget::setConvexHullPrefilter(Geometry::HullPrefilter prefilter)
+{
+    hullOptions.prefilter = prefilter;
+}
+
+/**
+ * @brief 设置并行分治凸包使用的线程数
+ * @param threadCount 线程数，0 表示使用全部硬件核心
+ * @details 与预过滤方式一样属于用户设置，clearScreen() 不会重置它。
+ */
+void DrawingWidget::setConvexHullThreadCount(int threadCount)
+{
+    hullOptions.threadCount = static_cast<unsigned>(std::max(0, threadCount));
+}
+
+/**
+ * @brief 设置三角剖分使用的算法
+ * @param algorithm 耳切法、单调多边形分解法或约束 Delaunay
+ * @details 由“三角剖分”子菜单在进入绘制模式时设置，clearScreen() 不会重置它。
+ * 选择约束 Delaunay 时在状态栏提示 Shift + 左键可以添加内部点；带孔洞模式下提示孔洞的画法。
+ */
+void DrawingWidget::setTriangulationAlgorithm(Geometry::TriangulationAlgorithm algorithm)
+{
+    triangulationAlgorithm = algorithm;
+    const bool cdt = (algorithm == Geometry::TriangulationAlgorithm::ConstrainedDelaunay);
+    if (holedTriangulation) {
+        emit modeChanged(QString("带孔洞多边形：左键画外边界，右键闭合；再逐个画孔洞，每个孔洞右键闭合；不再画孔洞时右键执行剖分%1。")
+                             .arg(cdt ? "（Shift + 左键添加内部点）" : ""));
+    } else if (cdt) {
+        emit modeChanged("约束 Delaunay：左键添加多边形顶点，Shift + 左键添加内部点，右键完成。");
+    }
+}
+
+/**
+ * @brief 设置三角剖分的输入是否带孔洞
+ * @param holed 为 true 时右键先闭合外边界，之后左键绘制孔洞，每个孔洞同样用右键闭合
+ * @details 属于用户设置，clearScreen() 不会重置它；正在绘制待剖分的多边形时切换会清空画布重新开始。
+ */
+void DrawingWidget::setHoledTriangulation(bool holed)
+{
+    holedTriangulation = holed;
+    if (currentMode == DRAW_POLYGON && taskToPerform == "triangulate") {
+        setMode(DRAW_POLYGON);
+        setTask("triangulate");
+        setTriangulationAlgorithm(triangulationAlgorithm);
+    }
+}
+
+/**
+ * @brief 设置凸包计算时是否同时求点集的 Delaunay 三角剖分与 Voronoi 图
+ * @param show 为 true 时 Andrew / Graham / Chan / 并行分治四种算法算完凸包后接着剖分同一组点
+ * @details 属于用户设置，clearScreen() 不会重置它；线程数沿用 hullOptions.threadCount。
+ */
+void DrawingWidget::setShowDelaunayVoronoi(bool show)
+{
+    showDelaunayVoronoi = show;
+}
+
 /**
  * @brief 核心绘图事件处理函数
  * @param event 绘图事件指针
@@ -245,7 +420,7 @@ void DrawingWidget::paintEvent(QPaintEvent *event)
         }
 
         //如果已完成三角剖分，则边界也画虚线，否则画实线
-        if (triangles.isEmpty()) {
+        if (triangleMesh.empty()) {
             painter.setPen(QPen(Qt::blue, 2)); // 正常实线
         } else {
             painter.setPen(QPen(Qt::blue, 2, Qt::DashLine)); // 三角剖分后，边界也为虚线
@@ -255,9 +430,30 @@ void DrawingWidget::paintEvent(QPaintEvent *event)
         if (polygonVertices.size() > 2) {
             painter.drawLine(polygonVertices.last(), polygonVertices.first());
         }
+
+        //孔洞：已闭合的画成闭环，正在画的画成折线
+        painter.setBrush(Qt::NoBrush);
+        for (const QVector<QPointF> &hole : polygonHoles) {
+            painter.drawPolygon(hole);
+        }
+        painter.drawPolyline(currentHole);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(Qt::red);
+        for (const QVector<QPointF> &hole : polygonHoles) {
+            for (const QPointF &p : hole) painter.drawEllipse(p, 4, 4);
+        }
+        for (const QPointF &p : currentHole) painter.drawEllipse(p, 4, 4);
     }
 
-    // 3. 绘制凸包 (红色)
+    // 3. 绘制凸包 (红色)，以及同一点集的 Voronoi 图（青色）与 Delaunay 三角剖分（灰色细线）
+    if (!voronoiEdges.isEmpty()) {
+        painter.setPen(QPen(QColor(0, 200, 200), 1));
+        painter.drawLines(voronoiEdges);
+    }
+    if (!delaunayEdges.isEmpty()) {
+        painter.setPen(QPen(Qt::lightGray, 1));
+        painter.drawLines(delaunayEdges);
+    }
     if (!convexHull.isEmpty()) {
         painter.setPen(QPen(Qt::red, 2));
         painter.setBrush(Qt::NoBrush);//没有填充颜色
@@ -305,7 +501,7 @@ void DrawingWidget::paintEvent(QPaintEvent *event)
         painter.setPen(Qt::NoPen);
 
         // QPainterPath 法 (不变)
-        if (displayMode == "intersection_qpath") {
+        if (displayMode == "intersection_qpath" || displayMode == "intersection_convex") {
             painter.setBrush(QColor(139, 69, 19, 150));
             for (const QPolygonF &poly : intersectionPolygons) painter.drawPolygon(poly);
         } else if (displayMode == "union_qpath") {
@@ -327,37 +523,72 @@ void DrawingWidget::paintEvent(QPaintEvent *event)
             resultPath.setFillRule(Qt::WindingFill);
             painter.drawPath(resultPath);
         }
+        // Martinez 扫描线裁剪法
+        else if (displayMode.endsWith("_martinez")) {
+            if (displayMode == "intersection_martinez") painter.setBrush(QColor(139, 69, 19, 150));
+            else if (displayMode == "union_martinez") painter.setBrush(QColor(0, 255, 0, 150));
+            else if (displayMode == "difference_martinez") painter.setBrush(QColor(30, 144, 255, 150));
+            else painter.setBrush(QColor(148, 0, 211, 150));
+
+            QPainterPath resultPath;
+            for (const QPolygonF &poly : clipResultPolygons) {
+                resultPath.addPolygon(poly);
+            }
+            // 外边界与孔洞方向相反，奇偶规则同样能正确挖出孔洞
+            resultPath.setFillRule(Qt::OddEvenFill);
+            painter.drawPath(resultPath);
+        }
     }
 
     // 7. 绘制三角剖分 (虚线)
-    if (!triangles.isEmpty()) {
+    //约束 Delaunay 的附加内部点（剖分前后都显示）
+    if (!steinerPoints.isEmpty()) {
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QColor(255, 165, 0));
+        for (const QPointF &p : steinerPoints) {
+            painter.drawEllipse(p, 4, 4);
+        }
+    }
+    if (!triangleMesh.empty()) {
+        const std::vector<Geometry::Point> &vertices = triangleMesh.vertices;
+        const std::vector<std::uint32_t> &indices = triangleMesh.indices;
+
         //步骤1：先用半透明蓝色填充所有三角形
         painter.setPen(Qt::NoPen);
         painter.setBrush(QColor(0, 0, 255, 60)); // 蓝色，60/255 的透明度
-        for (const auto& t : triangles) {
-            QPointF points[3] = {QPointF(t.p1), QPointF(t.p2), QPointF(t.p3)};
+        for (std::size_t i = 0; i < indices.size(); i += 3) {
+            QPointF points[3] = {toQt(vertices[indices[i]]), toQt(vertices[indices[i + 1]]), toQt(vertices[indices[i + 2]])};
             painter.drawPolygon(points, 3);
         }
 
-        //步骤2：绘制加粗的虚线边界
-        painter.setPen(QPen(Qt::darkGray, 2, Qt::DashLine)); // 宽度从1改为2
-        for (int k = 0; k < triangles.size(); ++k) {
-            Triangle t = triangles[k];
-            // 只画非边界的虚线
-            if (!isPolygonEdge(t.p1, t.p2)) painter.drawLine(t.p1, t.p2);
-            if (!isPolygonEdge(t.p2, t.p3)) painter.drawLine(t.p2, t.p3);
-            if (!isPolygonEdge(t.p3, t.p1)) painter.drawLine(t.p3, t.p1);
+        //步骤2：绘制加粗的虚线内部边。边界半边没有反向半边，O(1) 即可排除；
+        //每条内部边对应两条方向相反的半边，只取编号较小的那条，整体线性时间
+        QVector<QLineF> interiorEdges;
+        interiorEdges.reserve(static_cast<int>(indices.size() / 2));
+        for (std::uint32_t h = 0; h < indices.size(); ++h) {
+            if (triangleMesh.isBoundary(h) || triangleMesh.twins[h] < h) continue;
+            interiorEdges.push_back(QLineF(toQt(vertices[triangleMesh.origin(h)]), toQt(vertices[triangleMesh.target(h)])));
         }
+        painter.setPen(QPen(Qt::darkGray, 2, Qt::DashLine)); // 宽度从1改为2
+        painter.drawLines(interiorEdges);
     }
 
-    // 8. 显示多边形面积
+    // 8. 高亮被拒绝的点击：虚线为被拒绝的新边，实线为与它相交的已有边
+    if (!rejectedEdges.isEmpty()) {
+        painter.setPen(QPen(Qt::red, 2, Qt::DashLine));
+        painter.drawLine(rejectedEdges.first());
+        painter.setPen(QPen(Qt::red, 4));
+        painter.drawLines(rejectedEdges.mid(1));
+    }
+
+    // 9. 显示多边形面积
     if (polygonArea >= 0) {
         painter.setPen(Qt::white);
         painter.setFont(QFont("Arial", 12, QFont::Bold));
         painter.drawText(20, 30, QString("面积: %1").arg(polygonArea, 0, 'f', 2));
     }
 
-    // 9. 显示三角形数量
+    // 10. 显示三角形数量
     if (triangleCount >= 0) {
         painter.setPen(Qt::white);
         painter.setFont(QFont("Arial", 12, QFont::Bold));
@@ -378,14 +609,30 @@ void DrawingWidget::mousePressEvent(QMouseEvent *event)
 {
     // 左键点击添加点
     if (event->button() == Qt::LeftButton) {
+        //绘制多边形时逐点检查：新边与已有边相交的点击被拒绝并高亮，已画的顶点保持不变
         if (currentMode == DRAW_POLYGON_A) {
-            polygonA.append(event->pos());
+            appendRingVertex(polygonA, polygonAVersion, event->pos());
         } else if (currentMode == DRAW_POLYGON_B) {
-            polygonB.append(event->pos());
+            appendRingVertex(polygonB, polygonBVersion, event->pos());
         } else if (currentMode == DRAW_POLYGON) {
-            polygonVertices.append(event->pos());
+            //约束 Delaunay 剖分时 Shift + 左键添加内部点，普通左键仍添加多边形顶点
+            //带孔洞模式下外边界闭合后，左键添加的是当前孔洞的顶点
+            if (taskToPerform == "triangulate"
+                && triangulationAlgorithm == Geometry::TriangulationAlgorithm::ConstrainedDelaunay
+                && (event->modifiers() & Qt::ShiftModifier)) {
+                steinerPoints.append(event->pos());
+            } else if (taskToPerform == "triangulate" && holedTriangulation && outerRingClosed) {
+                appendRingVertex(currentHole, currentHoleVersion, event->pos());
+            } else {
+                appendRingVertex(polygonVertices, polygonVerticesVersion, event->pos());
+            }
         } else if (currentMode == ADD_POINTS_CONVEX_HULL) {
             points.append(event->pos());
+            if (convexHullAlgorithm == "Incremental") {
+                insertIncrementalHullPoint(points.back());
+            } else if (convexHullAlgorithm == "Dynamic") {
+                insertDynamicHullPoint(points.back());
+            }
         }
         update();
         return; // 添加完点后直接返回
@@ -393,11 +640,18 @@ void DrawingWidget::mousePressEvent(QMouseEvent *event)
 
     // 右键点击结束绘制并验证
     if (event->button() == Qt::RightButton) {
-        // 结束多边形A的绘制
+        // 动态凸包模式下右键用于删除点，而不是触发计算
+        if (currentMode == ADD_POINTS_CONVEX_HULL && convexHullAlgorithm == "Dynamic") {
+            if (removeDynamicHullPoint(event->pos())) {
+                update();
+            }
+            return;
+        }
+        // 结束多边形A的绘制。各边在添加时已逐条检查过，这里只检查闭合边；不合法时保留已画的顶点
         if (currentMode == DRAW_POLYGON_A && polygonA.size() >= 3) {
-            if (!isSimplePolygon(polygonA)) {
-                QMessageBox::warning(this, "错误", "多边形 A 存在自相交，请重新绘制！");
-                clearScreen(); // 清屏重置
+            if (!checkRingClosable(polygonA, polygonAVersion)) {
+                emit modeChanged("多边形 A 的闭合边与红色高亮的边相交，请继续添加顶点后再右键完成。");
+                update();
             } else {
                 currentMode = DRAW_POLYGON_B; // 切换到绘制B的模式
                 emit modeChanged("多边形 A 合法。请用左键添加顶点绘制多边形 B，右键完成。");
@@ -405,9 +659,9 @@ void DrawingWidget::mousePressEvent(QMouseEvent *event)
         }
         // 结束多边形B的绘制
         else if (currentMode == DRAW_POLYGON_B && polygonB.size() >= 3) {
-            if (!isSimplePolygon(polygonB)) {
-                QMessageBox::warning(this, "错误", "多边形 B 存在自相交，请重新绘制！");
-                clearScreen(); // 清屏重置
+            if (!checkRingClosable(polygonB, polygonBVersion)) {
+                emit modeChanged("多边形 B 的闭合边与红色高亮的边相交，请继续添加顶点后再右键完成。");
+                update();
             } else {
                 currentMode = IDLE; // 两个多边形都合法，进入空闲模式
                 polygonsReadyForOperation = true; // 标记已准备好
@@ -415,10 +669,36 @@ void DrawingWidget::mousePressEvent(QMouseEvent *event)
                 emit modeChanged("两个多边形均合法。请从菜单选择求交集或并集。");
             }
         }
+        // 带孔洞的三角剖分：右键依次闭合外边界与各个孔洞，没有正在画的孔洞时才执行计算
+        else if (currentMode == DRAW_POLYGON && taskToPerform == "triangulate" && holedTriangulation
+                 && polygonVertices.size() >= 3 && (!outerRingClosed || !currentHole.isEmpty())) {
+            QVector<QPointF> &ring = outerRingClosed ? currentHole : polygonVertices;
+            PolygonVersion &ringVersion = outerRingClosed ? currentHoleVersion : polygonVerticesVersion;
+            if (ring.size() < 3) {
+                QMessageBox::warning(this, "错误", "孔洞至少需要 3 个顶点！");
+                return;
+            }
+            if (!checkRingClosable(ring, ringVersion)) {
+                emit modeChanged(outerRingClosed ? "孔洞的闭合边与红色高亮的边相交，请继续添加顶点后再右键闭合。"
+                                                 : "外边界的闭合边与红色高亮的边相交，请继续添加顶点后再右键闭合。");
+                update();
+                return;
+            }
+            if (outerRingClosed) {
+                if (!checkHoleClosable(currentHole)) return; //原因已在状态栏说明
+                polygonHoles.append(currentHole);
+                currentHole.clear();
+                currentHoleVersion.touch();
+            }
+            outerRingClosed = true;
+            emit modeChanged(QString("已闭合外边界与 %1 个孔洞。左键绘制下一个孔洞，右键直接执行剖分。").arg(polygonHoles.size()));
+            update();
+        }
         // 处理其他模式的右键点击（例如三角剖分）
         else if (currentMode == DRAW_POLYGON && polygonVertices.size() >= 3) {
-            if (!isSimplePolygon(polygonVertices)) {
-                QMessageBox::warning(this, "错误", "多边形存在自相交，无法计算！");
+            if (!checkRingClosable(polygonVertices, polygonVerticesVersion)) {
+                emit modeChanged("多边形的闭合边与红色高亮的边相交，请继续添加顶点后再右键计算。");
+                update();
                 return;
             }
             performCalculation();
@@ -433,47 +713,159 @@ void DrawingWidget::mousePressEvent(QMouseEvent *event)
 // =================================================================
 //                              算法实现
 // =================================================================
+// 具体算法均位于几何库 GeometryCore 中（见 geometry/ 目录），
+// 这里只负责把界面数据转换成库的输入，并把结果写回成员变量供 paintEvent 绘制。
+
 /**
  * @brief 使用 Andrew's Monotone Chain 算法计算点集的凸包。
- * @details 算法首先按X坐标对所有点进行排序，然后分别构建上凸包和下凸包，最后合并得到最终结果。
- * 这是一个高效且稳健的凸包算法。
- * @note 此函数直接操作成员变量 `points` 和 `convexHull`。
+ * @details 调用 Geometry::convexHullAndrew，按 X 坐标排序后分别构建上下凸包再合并。
+ * @note 此函数读取成员变量 `points`，结果写入 `convexHull`。
  * @complexity O(n log n)，主要瓶颈在于排序。
  */
 void DrawingWidget::calculateConvexHull_Andrew()
 {
-    if (points.size() < 3) return;
+    runConvexHull(Geometry::HullAlgorithm::Andrew, "Andrew");
+}
+
+/**
+ * @brief 使用 Graham Scan (格雷厄姆扫描法) 计算点集的凸包。
+ * @details 调用 Geometry::convexHullGraham，以Y坐标最小的点为锚点按极角排序后用栈构建凸包。
+ * @note 算法在 `points` 的副本上操作，不会修改原始点集。
+ * @complexity O(n log n)，主要瓶颈在于极角排序。
+ */
+void DrawingWidget::calculateConvexHull_Graham()
+{
+    runConvexHull(Geometry::HullAlgorithm::Graham, "Graham");
+}
 
-    // 1. 按 x 坐标排序，x 相同则按 y 坐标排序
-    QVector<QPointF> sortedPoints = points;
-    std::sort(sortedPoints.begin(), sortedPoints.end(), [](const QPointF &a, const QPointF &b) {
-        return a.x() < b.x() || (a.x() == b.x() && a.y() < b.y());
-    });
+/**
+ * @brief 使用 Chan 算法计算点集的凸包。
+ * @details 调用 Geometry::convexHullChan：分组求小凸包，再在小凸包上做带二分切线的 Jarvis 步进，
+ * 猜测的凸包大小不够时平方重试。
+ * @complexity O(n log h)，h 为凸包顶点数，点多而凸包小时优于前两种算法。
+ */
+void DrawingWidget::calculateConvexHull_Chan()
+{
+    runConvexHull(Geometry::HullAlgorithm::Chan, "Chan");
+}
 
-    QVector<QPointF> upper, lower;
+/**
+ * @brief 使用多线程分治算法计算点集的凸包。
+ * @details 调用 Geometry::convexHullParallel：按 x 分桶后各线程并行排序、求子凸包，
+ * 再沿上下公共切线合并。线程数由 hullOptions.threadCount 决定。
+ * @complexity O((n log n) / T)，T 为线程数；点数较少时自动退化为单线程 Andrew 算法。
+ */
+void DrawingWidget::calculateConvexHull_Parallel()
+{
+    runConvexHull(Geometry::HullAlgorithm::Parallel, "并行分治");
+}
 
-    // 2. 构建下凸包
-    for (const QPointF &p : sortedPoints) {
-        while (lower.size() >= 2 && crossProduct(lower[lower.size()-2], lower.last(), p) <= 0) {
-            lower.pop_back();
-        }
-        lower.push_back(p);
+/**
+ * @brief 报告在线增量凸包的当前结果
+ * @details 增量模式下凸包在每次点击时已经由 insertIncrementalHullPoint 更新，
+ * 这里不做任何重算，只在状态栏报告规模。模式保持不变，用户可以继续加点。
+ */
+void DrawingWidget::calculateConvexHull_Incremental()
+{
+    emit modeChanged(QString("增量凸包：n = %1，h = %2")
+                         .arg(static_cast<qulonglong>(incrementalHull.pointCount()))
+                         .arg(static_cast<qulonglong>(incrementalHull.hullSize())));
+}
+
+/**
+ * @brief 把一个新点插入在线凸包
+ * @param p 新加入的点
+ * @details 调用 Geometry::IncrementalHull::insert，只在凸包真正改变（新点落在凸包外）时
+ * 才重新生成用于绘制的 convexHull。
+ * @complexity 插入均摊 O(log h)；凸包改变时生成绘制用顶点 O(h)
+ */
+void DrawingWidget::insertIncrementalHullPoint(const QPointF &p)
+{
+    if (incrementalHull.insert(toGeometry(p))) {
+        convexHull = toQt(incrementalHull.hull());
     }
+    calculateConvexHull_Incremental();
+}
+
+/**
+ * @brief 报告动态凸包的当前结果
+ * @details 与增量模式相同，凸包在每次增删时已经更新，这里只在状态栏报告规模，模式保持不变。
+ */
+void DrawingWidget::calculateConvexHull_Dynamic()
+{
+    emit modeChanged(QString("动态凸包：n = %1，h = %2")
+                         .arg(static_cast<qulonglong>(dynamicHull.pointCount()))
+                         .arg(convexHull.size()));
+}
+
+/**
+ * @brief 把一个新点加入动态凸包
+ * @param p 新加入的点
+ * @complexity 插入均摊 O(log² n)；生成绘制用顶点 O(h log n)
+ */
+void DrawingWidget::insertDynamicHullPoint(const QPointF &p)
+{
+    dynamicHull.insert(toGeometry(p));
+    convexHull = toQt(dynamicHull.hull());
+    calculateConvexHull_Dynamic();
+}
 
-    // 3. 构建上凸包
-    for (int i = sortedPoints.size() - 1; i >= 0; --i) {
-        const QPointF &p = sortedPoints[i];
-        while (upper.size() >= 2 && crossProduct(upper[upper.size()-2], upper.last(), p) <= 0) {
-            upper.pop_back();
+/**
+ * @brief 删除鼠标位置附近的一个点
+ * @param pos 鼠标右键点击的位置
+ * @return 拾取半径内存在点并已删除时返回 true
+ * @details 在 `points` 中找出距 pos 最近且不超过拾取半径的点，
+ * 同时从 `points` 与 dynamicHull 中移除它，然后刷新 convexHull。
+ * @complexity 拾取 O(n)，删除均摊 O(log² n)
+ */
+bool DrawingWidget::removeDynamicHullPoint(const QPointF &pos)
+{
+    const double pickRadius = 8.0;
+    int nearest = -1;
+    double bestDistSq = pickRadius * pickRadius;
+    for (int i = 0; i < points.size(); ++i) {
+        const double dx = points[i].x() - pos.x();
+        const double dy = points[i].y() - pos.y();
+        const double distSq = dx * dx + dy * dy;
+        if (distSq <= bestDistSq) {
+            bestDistSq = distSq;
+            nearest = i;
         }
-        upper.push_back(p);
     }
+    if (nearest < 0) return false;
+
+    dynamicHull.erase(toGeometry(points[nearest]));
+    points.remove(nearest);
+    convexHull = toQt(dynamicHull.hull());
+    calculateConvexHull_Dynamic();
+    return true;
+}
+
+/**
+ * @brief 三种凸包算法的公共执行流程
+ * @param algorithm 几何库中的算法选择
+ * @param name 算法名称，用于状态栏提示
+ * @details 通过 Geometry::computeConvexHull 计算凸包（按 hullOptions 决定是否预过滤）并取得统计信息，
+ * 把凸包顶点数 h、墙钟耗时以及预过滤剔除的点数发到状态栏，便于对比不同算法。
+ */
+void DrawingWidget::runConvexHull(Geometry::HullAlgorithm algorithm, const QString &name)
+{
+    if (points.size() < 3) return;
 
-    // 4. 合并上下凸包
-    convexHull = lower;
-    convexHull.pop_back(); // 移除重复的终点
-    convexHull += upper;
-    convexHull.pop_back(); // 移除重复的起点
+    Geometry::HullStats stats;
+    convexHull = toQt(Geometry::computeConvexHull(toGeometry(points), algorithm, hullOptions, &stats));
+    QString message = QString("凸包计算完成 (%1)：n = %2，h = %3，耗时 %4 ms")
+                          .arg(name)
+                          .arg(static_cast<qulonglong>(stats.inputCount))
+                          .arg(static_cast<qulonglong>(stats.hullCount))
+                          .arg(stats.elapsedMs, 0, 'f', 3);
+    if (hullOptions.prefilter != Geometry::HullPrefilter::None) {
+        message += QString("，预过滤剔除 %1 个点").arg(static_cast<qulonglong>(stats.discardedCount));
+    }
+    if (showDelaunayVoronoi) {
+        message += calculateDelaunayVoronoi();
+    }
+    emit modeChanged(message);
 
     currentMode = IDLE;
     //交互式绘图窗口，所以它有不同的模式控制
@@ -485,114 +877,100 @@ void DrawingWidget::calculateConvexHull_Andrew()
 }
 
 /**
- * @brief 使用 Graham Scan (格雷厄姆扫描法) 计算点集的凸包。
- * @details 算法首先找到Y坐标最小的点作为锚点，然后将其余点按与锚点的极角排序，最后通过栈操作构建出凸包。
- * @note 此函数在 `points` 的副本上操作，不会修改原始点集。
- * @complexity O(n log n)，主要瓶颈在于极角排序。
+ * @brief 求凸包点集 `points` 的 Delaunay 三角剖分及其对偶 Voronoi 图
+ * @details 调用 Geometry::delaunayTriangulationParallel（点多时按条带多线程剖分）与 Geometry::voronoiDiagram，
+ * 线程数沿用 hullOptions.threadCount。每条 Delaunay 边恰好对应一条 Voronoi 边，所以两组线段一次生成；
+ * 凸包边对应的 Voronoi 射线截断到画布对角线长度之外，画出来就是一条通到窗口边缘的线。
+ * @return 附加到状态栏的说明；点全部共线时返回提示并清空结果
+ * @complexity 期望 O(n log n)
  */
-void DrawingWidget::calculateConvexHull_Graham()
+QString DrawingWidget::calculateDelaunayVoronoi()
 {
-    if (points.size() < 3) return;
-
-    // 创建 points 的副本，所有操作都在这个副本上进行
-    QVector<QPointF> tempPoints = points;
+    delaunayEdges.clear();
+    voronoiEdges.clear();
 
-    // 1. 找到Y坐标最小的点（P0）
-    int minY_idx = 0;
-    for (int i = 1; i < tempPoints.size(); ++i) {
-        if (tempPoints[i].y() < tempPoints[minY_idx].y() ||
-            (tempPoints[i].y() == tempPoints[minY_idx].y() && tempPoints[i].x() < tempPoints[minY_idx].x())) {
-            minY_idx = i;
-        }
+    Geometry::CdtStats stats;
+    const auto mesh = Geometry::delaunayTriangulationParallel(toGeometry(points), hullOptions.threadCount, &stats);
+    if (!mesh) {
+        return "；点全部共线，无法三角剖分";
     }
-    std::swap(tempPoints[0], tempPoints[minY_idx]);
-    QPointF p0 = tempPoints[0];
-
-    // 2. 将其他点根据与P0的极角进行排序
-    std::sort(tempPoints.begin() + 1, tempPoints.end(), [&](const QPointF& a, const QPointF& b) {
-        double order = crossProduct(p0, a, b);
-
-        // 处理共线情况
-        if (std::abs(order) < 1e-9) {
-            //直接手动计算距离的平方进行比较
-            // 不再使用不存在的 lengthSquared() 函数
-            double distSqA = (p0.x() - a.x()) * (p0.x() - a.x()) + (p0.y() - a.y()) * (p0.y() - a.y());
-            double distSqB = (p0.x() - b.x()) * (p0.x() - b.x()) + (p0.y() - b.y()) * (p0.y() - b.y());
-            return distSqA < distSqB; // 距离近的排在前面
-        }
-
-        // 叉积 > 0 表示 p0->a 在 p0->b 的逆时针方向
-        return order > 0;
-    });
-
-    // 3. 构建凸包
-    convexHull.clear();
-    if (tempPoints.size() < 3) {
-        convexHull = tempPoints;
-        currentMode = IDLE;
-        return;
-    }
-
-    convexHull.push_back(tempPoints[0]);
-    convexHull.push_back(tempPoints[1]);
-
-    for (int i = 2; i < tempPoints.size(); ++i) {
-        while (convexHull.size() > 1 &&
-               crossProduct(convexHull[convexHull.size()-2], convexHull.last(), tempPoints[i]) <= 0) {
-            convexHull.pop_back();
-        }
-        convexHull.push_back(tempPoints[i]);
+    const Geometry::VoronoiDiagram voronoi = Geometry::voronoiDiagram(*mesh, hullOptions.threadCount);
+
+    const double rayLength = std::hypot(width(), height()) * 2;
+    delaunayEdges.reserve(static_cast<int>(voronoi.edges.size()));
+    voronoiEdges.reserve(static_cast<int>(voronoi.edges.size()));
+    for (const Geometry::VoronoiEdge &edge : voronoi.edges) {
+        delaunayEdges.push_back(QLineF(toQt(mesh->vertices[edge.site1]), toQt(mesh->vertices[edge.site2])));
+        const Geometry::Point from = voronoi.vertices[edge.vertex1];
+        const Geometry::Point to = edge.vertex2 >= 0 ? voronoi.vertices[edge.vertex2]
+                                                     : Geometry::Point{from.x + edge.direction.x * rayLength,
+                                                                       from.y + edge.direction.y * rayLength};
+        voronoiEdges.push_back(QLineF(toQt(from), toQt(to)));
     }
-
-    currentMode = IDLE;
+    return QString("；Delaunay 三角形 %1 个，Voronoi 边 %2 条，剖分耗时 %3 ms")
+        .arg(static_cast<qulonglong>(stats.triangleCount))
+        .arg(static_cast<qulonglong>(voronoi.edges.size()))
+        .arg(stats.elapsedMs, 0, 'f', 3);
 }
 
 /**
- * @brief 使用 Qt 内置的 QPainterPath 计算两个多边形的交集和并集。
- * @details 这是最高效、最可靠的矢量布尔运算方法。
- * 它将多边形转换为 QPainterPath 对象，然后直接调用其 intersected() 和 united() 方法。
- * @note 结果分别存储在成员变量 `intersectionPolygons` 和 `unionPath` 中。
+ * @brief 使用 Qt 内置的 QPainterPath 计算两个多边形的交集或并集。
+ * @param opType 交集或并集，只计算请求的这一种。
+ * @details 将多边形转换为 QPainterPath 对象，再调用其 intersected() 或 united() 方法。
+ * 两个多边形都是凸多边形时，交集改由 calculateIntersection_Convex 在 O(n+m) 时间内求出。
+ * 两个多边形都没有改动时直接取用缓存的结果，在交集与并集之间来回切换不会重新计算。
+ * @note 交集存储在成员变量 `intersectionPolygons` 中，并集存储在 `unionPath` 中。
  */
-void DrawingWidget::calculateIntersectionAndUnion()
+void DrawingWidget::calculateBooleanOp_QPainterPath(Geometry::BooleanOpType opType)
 {
-    intersectionPolygons.clear();
-    unionPath.clear();
+    const bool isUnion = (opType == Geometry::BooleanOpType::Union);
+    const BooleanOpKey key = booleanOpKey(BooleanOpEngine::QPainterPath, opType);
+    if (const BooleanOpResult *cached = findBooleanOp(key)) {
+        if (isUnion) unionPath = cached->path;
+        else intersectionPolygons = cached->polygons;
+        return;
+    }
+    //凸多边形的交集由 Convex 引擎求出并缓存
+    if (!isUnion && calculateIntersection_Convex()) return;
 
     //将多边形 (存储为点列表)转换为 Qt内部的高级图形对象
     QPainterPath pathA, pathB;
     pathA.addPolygon(QPolygonF(polygonA));
     pathB.addPolygon(QPolygonF(polygonB));
 
-    //直接调用内置的布尔运算函数
-    QPainterPath inter = pathA.intersected(pathB);
-    QPainterPath uni = pathA.united(pathB);
-
-    //存储计算结果以供后续绘制
-    intersectionPolygons = inter.toSubpathPolygons();
-    unionPath = uni; //直接保存QPainterPath 对象
+    //直接调用内置的布尔运算函数，存储计算结果以供后续绘制
+    BooleanOpResult result;
+    if (isUnion) {
+        unionPath = pathA.united(pathB); //直接保存QPainterPath 对象
+        result.path = unionPath;
+    } else {
+        intersectionPolygons = pathA.intersected(pathB).toSubpathPolygons();
+        result.polygons = intersectionPolygons;
+    }
+    storeBooleanOp(key, std::move(result));
 }
 
 /**
  * @brief 响应菜单点击，使用 QPainterPath 法计算并显示交集
  * @details 设置当前的显示模式为 "intersection_qpath"，
- * 然后调用核心的布尔运算函数，最后刷新屏幕以展示结果。
+ * 然后只计算交集（多边形未改动时直接复用上次的结果），最后刷新屏幕以展示结果。
  */
 void DrawingWidget::showIntersection_QPainterPath()
 {
     displayMode = "intersection_qpath";
-    calculateIntersectionAndUnion();
+    calculateBooleanOp_QPainterPath(Geometry::BooleanOpType::Intersection);
     update();
 }
 
 /**
  * @brief 响应菜单点击，使用 QPainterPath 法计算并显示并集
  * @details 设置当前的显示模式为 "union_qpath"，
- * 然后调用核心的布尔运算函数，最后刷新屏幕以展示结果。
+ * 然后只计算并集（多边形未改动时直接复用上次的结果），最后刷新屏幕以展示结果。
  */
 void DrawingWidget::showUnion_QPainterPath()
 {
     displayMode = "union_qpath";
-    calculateIntersectionAndUnion();
+    calculateBooleanOp_QPainterPath(Geometry::BooleanOpType::Union);
     update();
 }
 
@@ -604,8 +982,8 @@ void DrawingWidget::showUnion_QPainterPath()
  */
 void DrawingWidget::showIntersection_Weiler()
 {
-    displayMode = "union_weiler";
-    calculateBooleanOp_WeilerAtherton(Intersection);
+    displayMode = "intersection_weiler";
+    calculateBooleanOp_WeilerAtherton(Geometry::BooleanOpType::Intersection);
     update();
 }
 
@@ -617,345 +995,326 @@ void DrawingWidget::showIntersection_Weiler()
  */
 void DrawingWidget::showUnion_Weiler()
 {
-    displayMode = "intersection_weiler";
-    calculateBooleanOp_WeilerAtherton(Union);
+    displayMode = "union_weiler";
+    calculateBooleanOp_WeilerAtherton(Geometry::BooleanOpType::Union);
     update();
 }
 
 /**
- * @brief 计算两条线段 p1p2 和 p3p4 的交点
- * @details 此函数通过求解两个线段参数方程组成的线性方程组来找到交点。
- * 它首先计算系数行列式 `det`，如果 `det` 接近于零，则线段平行或共线，无交点。
- * 否则，解出参数 `t` 和 `u`。只有当 `t` 和 `u` 都严格在 (0, 1) 区间内时，
- * 交点才位于两条线段的内部，此时函数返回交点坐标。
- *
- * @param p1 线段1的起点
- * @param p2 线段1的终点
- * @param p3 线段2的起点
- * @param p4 线段2的终点
- * @param out_alpha [out] 如果相交，此参数将存储交点在线段 p1p2 上的比例位置 (t值)
- * @return std::optional<QPointF> 如果线段严格相交，则返回交点；否则返回 std::nullopt。
+ * @brief 使用 Weiler–Atherton 算法计算两个多边形的布尔运算（交集或并集）。
+ * @param opType 指定要执行的操作是 Geometry::BooleanOpType::Intersection 还是 Union。
+ * @details 调用 Geometry::booleanOpWeilerAtherton：先用扫描线找到所有交点，再构建两个多边形的增强链表，
+ * 并根据“进入/穿出”规则在两个链表之间“穿梭”，最终缝合出结果多边形。
+ * 交点发现与穿梭缝合两个阶段的耗时、内部内存峰值与分配次数显示在状态栏。
+ * 求交集且两个多边形都是凸多边形时，经 Geometry::intersectPolygons 自动改用 O(n+m) 凸多边形求交。
+ * @note 结果存储在成员变量 `weilerResultPolygons` 中；两个多边形都没有改动时直接取用缓存的结果与状态栏说明。
+ * @complexity O((n+m+I) log(n+m))，其中 I 是交点数。
  */
-std::optional<QPointF> DrawingWidget::getLineSegmentIntersection(QPointF p1, QPointF p2, QPointF p3, QPointF p4, double& out_alpha) {
-    //设置浮点误差容忍值，避免因为微小误差误判“相交”
-    const double EPSILON = 1e-9;
-    //计算行列式，相当于向量叉积：(p2−p1) × (p4−p3)，如果 det = 0 → 两线段平行或重合
-    double det = (p2.x() - p1.x()) * (p4.y() - p3.y()) - (p2.y() - p1.y()) * (p4.x() - p3.x());
-    //如果行列式接近 0 → 视为平行，不相交 → 返回空值
-    if (std::abs(det) < EPSILON)
-        return std::nullopt;
-
-    //点I(t) = P₁ + t * (P₂ - P₁) = P₃ + u * (P₄ - P₃)
-    //x 坐标: P₁.x + t * (P₂.x - P₁.x) = P₃.x + u * (P₄.x - P₃.x)
-    //y 坐标: P₁.y + t * (P₂.y - P₁.y) = P₃.y + u * (P₄.y - P₃.y)
-    //使用克莱姆法则计算
-    double t = ((p3.x() - p1.x()) * (p4.y() - p3.y()) - (p3.y() - p1.y()) * (p4.x() - p3.x())) / det;
-    double u = -((p2.x() - p1.x()) * (p3.y() - p1.y()) - (p2.y() - p1.y()) * (p3.x() - p1.x())) / det;
-
-    //最后检验
-    if (t > EPSILON && t < 1.0 - EPSILON && u > EPSILON && u < 1.0 - EPSILON) {
-        //检查 t 和 u 是否都严格在 (0, 1) 的开区间内
-        out_alpha = t;
-        return QPointF(p1.x() + t * (p2.x() - p1.x()), p1.y() + t * (p2.y() - p1.y()));
+void DrawingWidget::calculateBooleanOp_WeilerAtherton(Geometry::BooleanOpType opType) {
+    //清空旧数据并进行有效性检查
+    weilerResultPolygons.clear();
+    if (polygonA.size() < 3 || polygonB.size() < 3) return;
+
+    const BooleanOpKey key = booleanOpKey(BooleanOpEngine::WeilerAtherton, opType);
+    if (const BooleanOpResult *cached = findBooleanOp(key)) {
+        weilerResultPolygons = cached->polygons;
+        emit modeChanged(cached->status);
+        return;
+    }
+
+    Geometry::BooleanOpStats stats;
+    //求交集时两个输入都是凸多边形则自动走 O(n+m) 路径
+    const auto result = (opType == Geometry::BooleanOpType::Intersection)
+                            ? Geometry::intersectPolygons(toGeometry(polygonA), toGeometry(polygonB),
+                                                          Geometry::IntersectionEngine::Auto, &stats)
+                            : Geometry::booleanOpWeilerAtherton(toGeometry(polygonA), toGeometry(polygonB), opType, &stats);
+    for (const Geometry::Polygon &poly : result) {
+        weilerResultPolygons.push_back(QPolygonF(toQt(poly)));
     }
-    return std::nullopt;
-    //计算两条线段的交点，如果确实相交，就返回交点；否则返回“空值”（表示没有交点）
+    const QString status =
+        stats.convexFastPath
+            ? QString("输入均为凸多边形，已自动改用 O(n+m) 凸多边形求交：边界交点 %1 个，耗时 %2 ms")
+                  .arg(static_cast<qulonglong>(stats.intersectionCount))
+                  .arg(stats.traversalMs, 0, 'f', 3)
+            : QString("Weiler-Atherton 完成：交点 %1 个，交点发现 %2 ms，穿梭缝合 %3 ms，内存峰值 %4 KB，分配 %5 次")
+                  .arg(static_cast<qulonglong>(stats.intersectionCount))
+                  .arg(stats.discoveryMs, 0, 'f', 3)
+                  .arg(stats.traversalMs, 0, 'f', 3)
+                  .arg(stats.peakBytes / 1024.0, 0, 'f', 1)
+                  .arg(static_cast<qulonglong>(stats.allocationCount));
+    emit modeChanged(status);
+    storeBooleanOp(key, {weilerResultPolygons, QPainterPath(), status});
 }
 
 /**
- * @brief 使用射线法（Ray Casting）判断一个点是否在多边形内部
- *
- * @details 从测试点向右发射一条水平射线，然后统计这条射线与多边形边的交点数量。
- * 如果交点数量为奇数，则点在多边形内部；如果为偶数，则点在外部。
- * 这是一个处理非凸多边形的经典算法。
- *
- * @param point 要测试的点
- * @param polygon 多边形的顶点列表（应为封闭的）
- * @return bool 如果点在多边形内部，返回 true；否则返回 false
- * @complexity O(n)，其中 n 是多边形的顶点数。
+ * @brief 响应菜单点击，使用 Martinez 扫描线裁剪法计算并显示交集
  */
-bool DrawingWidget::isPointInsidePolygon(const QPointF& point, const QVector<QPointF>& polygon)
+void DrawingWidget::showIntersection_Martinez()
 {
-    /*
-    从测试点 向右画一条水平射线。
-    如果这条射线与多边形的边相交奇数次，点在多边形内部。
-    如果相交偶数次，点在多边形外部。
-    穿越规则：每次交叉会“切换”内外状态，奇数次意味着从外进入后停留在内。
-    */
-    bool inside = false;
-    int n = polygon.size();
-    if (n < 3) return false;//如果多边形顶点少于3个，不是合法多边形，直接返回 false
-
-    //循环遍历多边形的每一条边，时间复杂度O(n)
-    for (int i = 0, j = n - 1; i < n; j = i++) {
-        const QPointF& p_i = polygon[i];
-        const QPointF& p_j = polygon[j];
-
-        //检查点的Y坐标是否在当前边的Y坐标范围之内
-        bool y_intersect = ((p_i.y() > point.y()) != (p_j.y() > point.y()));
-
-        if (y_intersect) {
-            //计算从点向右发出的水平射线与当前边的交点的X坐标
-            //这是一个基于相似三角形的标准线性插值公式（占比，相似三角形）
-            double x_intersect = (p_j.x() - p_i.x()) * (point.y() - p_i.y()) / (p_j.y() - p_i.y()) + p_i.x();
-
-            //如果交点的X坐标在点的右侧，说明射线穿过了这条边
-            if (point.x() < x_intersect) {
-                //每穿过一次，就切换一次内外状态
-                inside = !inside;
-            }
-        }
-    }
-    return inside;
+    displayMode = "intersection_martinez";
+    calculateBooleanOp_Martinez(Geometry::BooleanOpType::Intersection);
+    update();
 }
 
 /**
- * @brief 使用 Weiler–Atherton 算法计算两个多边形的布尔运算（交集或并集）。
- * @param opType 指定要执行的操作是 Intersection 还是 Union。
- * @details 算法通过构建两个多边形的增强链表，找到所有交点，并根据“进入/穿出”规则
- * 在两个链表之间“穿梭”，最终缝合出结果多边形。可以正确处理多区域和带孔洞的情况。
- * @note 结果存储在成员变量 `weilerResultPolygons` 中。
- * @complexity O(I*log(I) + (n+m+I))，其中 I 是交点数，最坏可达 O(n*m)。
+ * @brief 响应菜单点击，使用 Martinez 扫描线裁剪法计算并显示并集
  */
-void DrawingWidget::calculateBooleanOp_WeilerAtherton(BooleanOpType opType) {
-    //清空旧数据并进行有效性检查
-    weilerResultPolygons.clear();
+void DrawingWidget::showUnion_Martinez()
+{
+    displayMode = "union_martinez";
+    calculateBooleanOp_Martinez(Geometry::BooleanOpType::Union);
+    update();
+}
+
+/**
+ * @brief 响应菜单点击，使用 Martinez 扫描线裁剪法计算并显示差集 A − B
+ */
+void DrawingWidget::showDifference_Martinez()
+{
+    displayMode = "difference_martinez";
+    calculateBooleanOp_Martinez(Geometry::BooleanOpType::Difference);
+    update();
+}
+
+/**
+ * @brief 响应菜单点击，使用 Martinez 扫描线裁剪法计算并显示异或（对称差）
+ */
+void DrawingWidget::showXor_Martinez()
+{
+    displayMode = "xor_martinez";
+    calculateBooleanOp_Martinez(Geometry::BooleanOpType::Xor);
+    update();
+}
+
+/**
+ * @brief 使用 Martinez–Rueda–Feito 扫描线算法计算两个多边形的布尔运算。
+ * @param opType 交集、并集、差集或异或。
+ * @details 调用 Geometry::booleanOpMartinez：扫描线在交点处细分所有边，并为每条边标记它相对两个多边形的内外状态，
+ * 再把属于结果的边连接成轮廓。与 Weiler–Atherton 不同，它能输出带孔洞的结果和多个分离区域，
+ * 也支持差集与异或。扫描细分与轮廓连接两个阶段的耗时显示在状态栏。
+ * @note 结果的所有环存储在成员变量 `clipResultPolygons` 中；两个多边形都没有改动时直接取用缓存的结果与状态栏说明。
+ * @complexity O((n+m+I) log(n+m))，其中 I 是交点数。
+ */
+void DrawingWidget::calculateBooleanOp_Martinez(Geometry::BooleanOpType opType)
+{
+    clipResultPolygons.clear();
     if (polygonA.size() < 3 || polygonB.size() < 3) return;
 
-    QVector<QPointF> polyA = this->polygonA;
-    QVector<QPointF> polyB = this->polygonB;
-
-    //确保两个多边形都是逆时针顺序，时间复杂度O(n+m)
-    if (computeAreaSign(polyA) > 0) std::reverse(polyA.begin(), polyA.end());
-    if (computeAreaSign(polyB) > 0) std::reverse(polyB.begin(), polyB.end());
-
-    //构建增强链表，时间复杂度O(n+m)
-    std::list<VertexNode> listA, listB;
-    for(const auto& p : polyA) listA.push_back({p});
-    for(const auto& p : polyB) listB.push_back({p});
-    //每个节点存放：point：顶点坐标
-
-    //寻找所有交点，并插入链表，时间复杂度O(n*m)
-    for (auto itA = listA.begin(); itA != listA.end(); ++itA) {
-        //遍历A中每个点
-        auto next_itA = (std::next(itA) == listA.end()) ? listA.begin() : std::next(itA);//处理首尾点
-        for (auto itB = listB.begin(); itB != listB.end(); ++itB) {
-            //遍历B中每个点
-            auto next_itB = (std::next(itB) == listB.end()) ? listB.begin() : std::next(itB);//处理首尾点
-
-            double alpha;
-            if (auto intersect_pt = getLineSegmentIntersection(itA->point, next_itA->point, itB->point, next_itB->point, alpha)) {
-                //找到交点，将交点插入到链表中
-                auto nodeA = listA.insert(next_itA, {intersect_pt.value(), true, {}, false, false, alpha});
-                auto nodeB = listB.insert(next_itB, {intersect_pt.value(), true, {}, false, false, 0});
-
-                nodeA->neighbor = nodeB;
-                nodeB->neighbor = nodeA;
-
-                //事先规定A和B都是逆时针，这里看交叉点处B多边形的方向在A多边形方向的左边还是右边
-                double cross = crossProduct({0,0}, next_itA->point - itA->point, next_itB->point - itB->point);
-                nodeA->is_entering = cross > 0;//大于零就是左侧，左侧就是内侧，进入
-                nodeB->is_entering = cross < 0;
-            }
+    const BooleanOpKey key = booleanOpKey(BooleanOpEngine::Martinez, opType);
+    if (const BooleanOpResult *cached = findBooleanOp(key)) {
+        clipResultPolygons = cached->polygons;
+        emit modeChanged(cached->status);
+        return;
+    }
+
+    const std::vector<Geometry::Polygon> subject{toGeometry(polygonA)};
+    const std::vector<Geometry::Polygon> clipping{toGeometry(polygonB)};
+    Geometry::BooleanOpStats stats;
+    const auto result = Geometry::booleanOpMartinez(subject, clipping, opType, &stats);
+    std::size_t holeCount = 0;
+    for (const Geometry::PolygonWithHoles &region : result) {
+        clipResultPolygons.push_back(QPolygonF(toQt(region.outer)));
+        for (const Geometry::Polygon &hole : region.holes) {
+            clipResultPolygons.push_back(QPolygonF(toQt(hole)));
         }
+        holeCount += region.holes.size();
     }
+    const QString status = QString("Martinez 完成：区域 %1 个，孔洞 %2 个，交点 %3 个，扫描细分 %4 ms，连接轮廓 %5 ms")
+                               .arg(static_cast<qulonglong>(result.size()))
+                               .arg(static_cast<qulonglong>(holeCount))
+                               .arg(static_cast<qulonglong>(stats.intersectionCount))
+                               .arg(stats.discoveryMs, 0, 'f', 3)
+                               .arg(stats.traversalMs, 0, 'f', 3);
+    emit modeChanged(status);
+    storeBooleanOp(key, {clipResultPolygons, QPainterPath(), status});
+}
 
-    //遍历与缝合，找出结果多边形，时间复杂度 (O(n + m + I))
-    for (auto it_start = listA.begin(); it_start != listA.end(); ++it_start) {
-        if (!it_start->is_intersection || it_start->processed) continue;
-        //is_intersection：必须是交点（否则跳过），已经处理过，就不能再用（避免重复构造）
-
-        bool is_union = (opType == Union);
-        if (is_union == it_start->is_entering) continue;
-        //如果是 并集，则必须从 退出交点开始。
-        //如果是 交集，则必须从 进入交点开始
-
-        QPolygonF current_result;//当前路径的点集合
-        auto current_iter = it_start;//当前访问的节点
-        auto* current_list = &listA;//当前在哪条链表（A 或 B）
-        int loop_guard = 0;//防止死循环（因为链表是环形的）
-        int max_loops = listA.size() + listB.size() + 1; // 增加保护
-
-        do {
-            if (++loop_guard > max_loops) break;//防止死循环
-
-            current_iter->processed = true;//标记为 processed，避免重复使用
-            if(current_iter->is_intersection) current_iter->neighbor->processed = true;
-            //如果是交点，它在另一条链表的 neighbor 也要标记
-
-            current_result.append(current_iter->point);//把当前点加入结果多边形
-
-            if (current_iter->is_intersection) {
-                //如果走到交点，需要考虑是否转换
-                if (is_union != current_iter->is_entering) {
-                    // 根据并集/交集规则决定是否切换链表
-                    //并集、往外退
-                    //交集、往里进
-                    //这两种情况换
-                    current_iter = current_iter->neighbor;//转换调到另一个多边形
-                    current_list = (current_list == &listA) ? &listB : &listA;//换链表
-                }
-            }
+/**
+ * @brief 响应菜单点击，使用凸多边形 O(n+m) 算法计算并显示交集
+ * @details 与自动分派不同，这里强制使用凸多边形算法，便于和通用算法对比耗时；
+ * 任一输入不是凸多边形时只在状态栏提示，不显示结果。
+ */
+void DrawingWidget::showIntersection_Convex()
+{
+    displayMode = "intersection_convex";
+    intersectionPolygons.clear();
+    if (!calculateIntersection_Convex()) {
+        emit modeChanged("凸多边形求交要求两个多边形都是凸多边形，请改用通用算法");
+    }
+    update();
+}
 
-            current_iter++;//看下一个点
-            if (current_iter == current_list->end()) {//衔接开头
-                current_iter = current_list->begin();
-            }
-        } while (current_iter != it_start && (!it_start->is_intersection || current_iter != it_start->neighbor));
-        //结束条件是如果回到起点，结束；如果是交点，但走回了它的邻居，说明闭环完成，结束。
-        if (current_result.size() > 2) {
-            //存结果
-            weilerResultPolygons.push_back(current_result);
-        }
+/**
+ * @brief 两个多边形都是凸多边形时，用 O(n+m) 的单调链合并算法求交集
+ * @details 调用 Geometry::intersectPolygons 并指定 Convex 引擎，
+ * 边界交点数与耗时显示在状态栏。
+ * @return 两个多边形都是凸多边形并已求出交集时返回 true（交集可能为空）；否则返回 false 且不修改结果
+ * @note 结果存储在成员变量 `intersectionPolygons` 中，两个多边形都没有改动时直接取用缓存。
+ * @complexity O(n+m)
+ */
+bool DrawingWidget::calculateIntersection_Convex()
+{
+    if (polygonA.size() < 3 || polygonB.size() < 3) return false;
+    const BooleanOpKey key = booleanOpKey(BooleanOpEngine::Convex, Geometry::BooleanOpType::Intersection);
+    if (const BooleanOpResult *cached = findBooleanOp(key)) {
+        intersectionPolygons = cached->polygons;
+        emit modeChanged(cached->status);
+        return true;
     }
+    const std::vector<Geometry::Point> a = toGeometry(polygonA);
+    const std::vector<Geometry::Point> b = toGeometry(polygonB);
+    if (!Geometry::isConvexPolygon(a) || !Geometry::isConvexPolygon(b)) return false;
 
-    //处理无交点的特殊情况（包含或相离），时间复杂度(O(n+m))
-    if (weilerResultPolygons.empty() && !polyA.isEmpty() && !polyB.isEmpty()) {
-        //没有交点导致没有结果且非空合法
-        bool a_in_b = isPointInsidePolygon(polyA[0], polyB);//A 的一个点是否在 B 内部
-        bool b_in_a = isPointInsidePolygon(polyB[0], polyA);//B 的一个点是否在 A 内部
-
-        if (opType == Intersection) {
-            //要求交集
-            if (a_in_b)
-                weilerResultPolygons.push_back(QPolygonF(polyA));//A在B中，交集为A
-            else if (b_in_a)
-                weilerResultPolygons.push_back(QPolygonF(polyB));//B在A中，交集为B
-        } else { // Union
-            if (a_in_b)
-                weilerResultPolygons.push_back(QPolygonF(polyB));//A在B中，并集为B
-            else if (b_in_a)
-                weilerResultPolygons.push_back(QPolygonF(polyA));//B在A中，并集为A
-            else {
-                //如果互不包含，并集是 A + B（两个分离区域）
-                weilerResultPolygons.push_back(QPolygonF(polyA));
-                weilerResultPolygons.push_back(QPolygonF(polyB));
-            }
-        }
+    Geometry::BooleanOpStats stats;
+    const auto result = Geometry::intersectPolygons(a, b, Geometry::IntersectionEngine::Convex, &stats);
+    intersectionPolygons.clear();
+    for (const Geometry::Polygon &poly : result) {
+        intersectionPolygons.push_back(QPolygonF(toQt(poly)));
     }
+    const QString status = QString("凸多边形 O(n+m) 求交完成：边界交点 %1 个，耗时 %2 ms")
+                               .arg(static_cast<qulonglong>(stats.intersectionCount))
+                               .arg(stats.traversalMs, 0, 'f', 3);
+    emit modeChanged(status);
+    storeBooleanOp(key, {intersectionPolygons, QPainterPath(), status});
+    return true;
 }
 
 /**
- * @brief 使用 Ear Clipping (耳朵裁剪) 算法对简单多边形进行三角剖分。
- * @details 算法循环寻找“耳朵”（一个凸顶点及其相邻两点组成的、内部不包含其他顶点的三角形），
- * 切下耳朵，直到多边形退化为一个三角形。包含了对复杂凹多边形的容错处理机制。
- * @note 结果存储在成员变量 `triangles` 中。
- * @complexity O(n^2) 在最坏情况下。
+ * @brief 按 triangulationAlgorithm 对简单多边形进行三角剖分。
+ * @details 调用 Geometry::triangulatePolygon：
+ * - 耳切法在双向链表上切耳，只用按 Morton 编码索引的反射顶点判断耳朵，典型输入接近线性；
+ * - 单调多边形分解法先用扫描线把多边形分解为 y 单调的子多边形，再逐块线性时间剖分，O(n log n)；
+ * - 约束 Delaunay 直接调用 Geometry::constrainedDelaunay，多边形边为约束，Shift + 左键添加的点作为内部点参与剖分。
+ * 三角形数与耗时显示在状态栏。
+ * @note 结果以半边网格存储在成员变量 `triangleMesh` 中，绘制时据此 O(1) 区分边界边与内部边。
  */
 void DrawingWidget::calculateTriangulation()
 {
-
-    //基础检查和预处理
-    //至少三个点
+    //基础检查：至少三个点
     if (polygonVertices.size() < 3) {
-        // 多边形至少需要3个顶点，否则无法构成三角形
         QMessageBox::warning(this, "错误", "无法剖分：顶点数不足 3 个！");
         return;
     }
 
-    //简单多边形
-    if (!isSimplePolygon(polygonVertices)) {
-        // 自相交或零边长度等非法情况 → 剖分逻辑不能保证正确性
+    //简单多边形：自相交或零边长度等非法情况 → 剖分逻辑不能保证正确性
+    if (!isSimplePolygon(polygonVertices, polygonVerticesVersion)) {
         QMessageBox::warning(this, "错误", "无法剖分：多边形不合法！");
         return;
     }
 
-    //备份各点
-    QVector<QPointF> remaining = polygonVertices;
-    triangles.clear(); //清空之前的剖分结果
+    triangleMesh = Geometry::HalfEdgeMesh(); //清空之前的剖分结果
 
-    if (!remaining.isEmpty() && remaining.first() == remaining.last()) {
-        //首尾重复点，那么移除最后一个点，避免重复边
-        remaining.removeLast();
+    if (holedTriangulation) {
+        calculateTriangulationWithHoles();
+        return;
     }
 
-    //确定点序方向为逆时针（计算有向面积符号）
-    double areaSign = 0.0;
-    for (int i = 0; i < remaining.size(); ++i) {
-        QPointF p1 = remaining[i];
-        QPointF p2 = remaining[(i + 1) % remaining.size()];
-        areaSign += (p1.x() * p2.y() - p2.x() * p1.y()); //鞋带公式核心部分
+    if (triangulationAlgorithm == Geometry::TriangulationAlgorithm::ConstrainedDelaunay) {
+        Geometry::CdtStats cdtStats;
+        const auto mesh = Geometry::constrainedDelaunay(toGeometry(polygonVertices), toGeometry(steinerPoints), &cdtStats);
+        if (!mesh) {
+            QMessageBox::warning(this, "错误", "无法剖分：约束边相交或输入退化！");
+            return;
+        }
+        triangleMesh = Geometry::toHalfEdgeMesh(*mesh);
+        triangleCount = static_cast<int>(triangleMesh.triangleCount());
+        emit modeChanged(QString("约束 Delaunay 完成：顶点 %1 个（内部点 %2 个被忽略），三角形 %3 个，翻转 %4 次，耗时 %5 ms")
+                             .arg(static_cast<qulonglong>(cdtStats.vertexCount))
+                             .arg(static_cast<qulonglong>(cdtStats.ignoredPointCount))
+                             .arg(static_cast<qulonglong>(cdtStats.triangleCount))
+                             .arg(static_cast<qulonglong>(cdtStats.flipCount))
+                             .arg(cdtStats.elapsedMs, 0, 'f', 3));
+        currentMode = IDLE;
+        return;
     }
 
-    if (areaSign < 0) {
-        // 如果面积是负值，说明顶点是顺时针排列（在 Qt 坐标中方向相反）
-        // 为了统一处理，手动翻转点序
-        std::reverse(remaining.begin(), remaining.end());
+    Geometry::TriangulationStats stats;
+    auto result = Geometry::triangulatePolygonMesh(toGeometry(polygonVertices), triangulationAlgorithm, &stats);
+    if (!result) {
+        //最大尝试次数触发或检测到退化输入 → 算法终止
+        QMessageBox::warning(this, "错误", "无法剖分：算法无法继续执行！");
+        return;
     }
 
-    //耳切主循环
-    int n = remaining.size();
-    int attempts = 0;
-    const int maxAttempts = n * 2; //防止死循环设置的最大容忍尝试次数
-
-    while (remaining.size() > 3 && attempts < maxAttempts) {
-        //每次剖分删除一个顶点，至多 n-3 次迭代，但在退化情况最多允许2n次尝试
-
-        // 遍历所有三连顶点，尝试找到一个耳朵
-        for (int i = 0; i < remaining.size(); ++i) {
-            //外层迭代O(n)
-            QPointF p1 = remaining[i];
-            QPointF p2 = remaining[(i + 1) % remaining.size()];
-            QPointF p3 = remaining[(i + 2) % remaining.size()];
-
-            // 判断 p2 是否是凸角（改进：允许共线，提升容忍度）
-            long long cross = crossProduct(p1, p2, p3);
-            if (cross > 0) { //凸角
-                Triangle ear(p1, p2, p3);
-                bool isValidEar = true;
-
-                // 遍历剩余顶点，判断是否有点在耳朵三角形内
-                for (int j = 0; j < remaining.size(); ++j) {
-                    //内层检查所有点是否在三角形内O(n)
-                    if (j != i && j != (i + 1) % remaining.size() && j != (i + 2) % remaining.size()) {
-                        QPointF pt = remaining[j];
-                        if (ear.contains(pt)) {
-                            isValidEar = false; //三角形内有点，不能剪耳朵
-                            break;
-                        }
-                    }
-                }
-
-                if (isValidEar) {
-                    //找到一个合法耳朵，那么添加到结果、移除中间顶点
-                    triangles.push_back(ear);
-                    remaining.remove((i + 1) % remaining.size());
-                    attempts = 0; //重置尝试计数器
-                    break;
-                }
-            }
-        }
+    triangleMesh = std::move(*result);
+    triangleCount = static_cast<int>(triangleMesh.triangleCount()); //更新总数
+    const QString name = (triangulationAlgorithm == Geometry::TriangulationAlgorithm::Monotone) ? "单调多边形分解" : "耳切法";
+    emit modeChanged(QString("三角剖分完成 (%1)：n = %2，三角形 %3 个，耗时 %4 ms")
+                         .arg(name)
+                         .arg(static_cast<qulonglong>(stats.vertexCount))
+                         .arg(static_cast<qulonglong>(stats.triangleCount))
+                         .arg(stats.elapsedMs, 0, 'f', 3));
+    currentMode = IDLE;
+}
+
+/**
+ * @brief 对带孔洞的多边形进行三角剖分。
+ * @details 外边界为 polygonVertices，孔洞为 polygonHoles（尚未闭合但已有 3 个以上顶点的孔洞也一并计入）。
+ * 耳切法先用 Geometry::bridgeHoles 把孔洞经桥边并入外边界再切耳；单调多边形分解与约束 Delaunay 直接处理多个环。
+ * 桥边由扫描线选出，孔洞再多也是 O(n log n)。
+ * @note 每个孔洞闭合时已由 checkHoleClosable 检查过与外边界、其他孔洞的关系，未闭合的孔洞在这里补做同样的检查；
+ * 几何库剖分前还会用 Geometry::isSimplePolygonWithHoles 整体检查一遍，失败时给出提示。
+ */
+void DrawingWidget::calculateTriangulationWithHoles()
+{
+    if (currentHole.size() >= 3 && isSimplePolygon(currentHole, currentHoleVersion)) {
+        if (!checkHoleClosable(currentHole)) return; //原因已在状态栏说明
+        polygonHoles.append(currentHole);
+        currentHole.clear();
+        currentHoleVersion.touch();
     }
 
-    //处理最后剩余三角形
-    if (remaining.size() == 3) {
-        triangles.push_back(Triangle(remaining[0], remaining[1], remaining[2]));
-        triangleCount = triangles.size(); //更新总数
-        currentMode = IDLE;
-    } else if (attempts >= maxAttempts) {
-        //最大尝试次数触发 → 算法终止，并清空结果
-        QMessageBox::warning(this, "错误", "无法剖分：算法无法继续执行！");
-        triangles.clear();
-        return;
+    Geometry::PolygonWithHoles polygon;
+    polygon.outer = toGeometry(polygonVertices);
+    polygon.holes.reserve(polygonHoles.size());
+    for (const QVector<QPointF> &hole : polygonHoles) polygon.holes.push_back(toGeometry(hole));
+
+    QString status;
+    if (triangulationAlgorithm == Geometry::TriangulationAlgorithm::ConstrainedDelaunay) {
+        Geometry::CdtStats cdtStats;
+        const auto mesh = Geometry::constrainedDelaunay(polygon, toGeometry(steinerPoints), &cdtStats);
+        if (!mesh) {
+            QMessageBox::warning(this, "错误", "无法剖分：约束边相交或输入退化！");
+            return;
+        }
+        triangleMesh = Geometry::toHalfEdgeMesh(*mesh);
+        status = QString("约束 Delaunay 完成：%1 个孔洞，顶点 %2 个，三角形 %3 个，翻转 %4 次，耗时 %5 ms")
+                     .arg(polygonHoles.size())
+                     .arg(static_cast<qulonglong>(cdtStats.vertexCount))
+                     .arg(static_cast<qulonglong>(cdtStats.triangleCount))
+                     .arg(static_cast<qulonglong>(cdtStats.flipCount))
+                     .arg(cdtStats.elapsedMs, 0, 'f', 3);
+    } else {
+        Geometry::TriangulationStats stats;
+        auto triangulated = Geometry::triangulatePolygonWithHolesMesh(polygon, triangulationAlgorithm, &stats);
+        if (!triangulated) {
+            QMessageBox::warning(this, "错误", "无法剖分：孔洞与外边界或其他孔洞相交，或输入退化！");
+            return;
+        }
+        triangleMesh = std::move(*triangulated);
+        const QString name = (triangulationAlgorithm == Geometry::TriangulationAlgorithm::Monotone) ? "单调多边形分解" : "桥接 + 耳切法";
+        status = QString("带孔洞三角剖分完成 (%1)：%2 个孔洞，n = %3，三角形 %4 个，耗时 %5 ms")
+                     .arg(name)
+                     .arg(polygonHoles.size())
+                     .arg(static_cast<qulonglong>(stats.vertexCount))
+                     .arg(static_cast<qulonglong>(stats.triangleCount))
+                     .arg(stats.elapsedMs, 0, 'f', 3);
     }
+
+    triangleCount = static_cast<int>(triangleMesh.triangleCount());
+    emit modeChanged(status);
+    currentMode = IDLE;
 }
 
 /**
  * @brief 使用 Shoelace (鞋带) 公式计算多边形面积。
- * @details 通过计算多边形顶点坐标的叉积和来得到面积。
+ * @details 调用 Geometry::polygonArea，通过计算多边形顶点坐标的叉积和来得到面积。
  * @note 结果存储在成员变量 `polygonArea` 中。
  * @complexity O(n)
  */
 void DrawingWidget::calculatePolygonArea()
 {
-    double area = 0.0;
-    for (int i = 0; i < polygonVertices.size(); ++i) {
-        //遍历所有点
-        QPointF p1 = polygonVertices[i];
-        QPointF p2 = polygonVertices[(i + 1) % polygonVertices.size()]; // 最后一个顶点和第一个顶点相连
-        area += (double)(p1.x() * p2.y() - p2.x() * p1.y());
-    }
-    polygonArea = std::abs(area) / 2.0;
+    polygonArea = Geometry::polygonArea(toGeometry(polygonVertices));
     currentMode = IDLE;
 }
 
@@ -964,232 +1323,181 @@ void DrawingWidget::calculatePolygonArea()
 // =================================================================
 
 /**
- * @brief 计算三点之间的二维叉积（向量 p1→p2 与 p1→p3 的有向面积）
- *
- * 此函数用于判断由三个点构成的旋转方向：
- * - 返回值 > 0：表示左转（逆时针方向）
- * - 返回值 < 0：表示右转（顺时针方向）
- * - 返回值 = 0：表示三点共线
- *
- * @param p1 第一个点（参考原点）
- * @param p2 第二个点（构成向量 p1→p2）
- * @param p3 第三个点（构成向量 p1→p3）
- * @return double 类型叉积结果
- *
- * @note 此函数常用于凸包、三角剖分、线段相交判断等几何算法中
+ * @brief 检查一个多边形是否为“简单多边形”
+ * @param poly 以 QVector<QPointF> 形式存储的多边形顶点列表
+ * @param version poly 的版本号，判定结果缓存在其中
+ * @return bool 如果多边形是简单的（没有自相交、没有重叠边与零长度边），则返回 true；否则返回 false
+ * @details 转发到 Geometry::isSimplePolygon（Shamos–Hoey 扫描线）。右键闭合、performCalculation 与
+ * calculateTriangulation 常对同一个多边形连续检查，顶点没有改动（版本号相同）时直接返回上次的结论。
+ * @note 这是执行三角剖分等高级算法前一个至关重要的合法性检查。
+ * @complexity 首次 O(n log n)，其中 n 是多边形的顶点数；同一版本再次调用 O(1)。
  */
-double DrawingWidget::crossProduct(const QPointF &p1, const QPointF &p2, const QPointF &p3)
+bool DrawingWidget::isSimplePolygon(const QVector<QPointF> &poly, PolygonVersion &version)
 {
-    return (p2.x() - p1.x()) * (p3.y() - p1.y())-(p2.y() - p1.y()) * (p3.x() - p1.x());
+    if (version.simpleVersion != version.version) {
+        version.setSimple(Geometry::isSimplePolygon(toGeometry(poly)));
+    }
+    return version.simple;
 }
 
 /**
- * @brief 检查线段 (a, b) 是否为多边形的外边界。
- * @param a 线段的一个端点。
- * @param b 线段的另一个端点。
- * @return 如果 (a, b) 是 `polygonVertices` 中的一条边，则返回 true。
- * @note 用于在三角剖分绘图时，区分外边界和内部对角线。
+ * @brief 生成布尔运算结果的缓存键
+ * @details 键中记录 A、B 当前的版本号；任一多边形的顶点改动后版本号递增，旧结果自然不再命中。
  */
-bool DrawingWidget::isPolygonEdge(const QPointF &a, const QPointF &b)
+DrawingWidget::BooleanOpKey DrawingWidget::booleanOpKey(BooleanOpEngine engine, Geometry::BooleanOpType opType) const
 {
-    for (int i = 0; i < polygonVertices.size(); ++i) {
-        //开始检查列表上的每一条边
-        QPointF p1 = polygonVertices[i];//从列表上取出一条“标准边”，由 p1 和 p2 组成
-        QPointF p2 = polygonVertices[(i + 1) % polygonVertices.size()];
-
-        //进行关键比对
-        if ((a == p1 && b == p2) || (a == p2 && b == p1)) {
-            return true; // 说明这条边是外边界
-        }
-    }
-    return false;
+    return {engine, opType, polygonAVersion.version, polygonBVersion.version};
 }
 
 /**
- * @brief 使用“面积法”判断一个点是否在三角形内部或边界上
- *
- * @details 此方法基于一个几何原理：如果一个点 P 在三角形 ABC 内部，
- * 那么由 P 和三角形三个顶点构成的三个子三角形（PAB, PBC, PCA）的面积之和，
- * 必然精确等于主三角形 ABC 的面积。如果点在外部，则子三角形面积之和会更大。
- *
- * @param pt 要测试的点
- * @return bool 如果点在三角形内或边界上，返回 true；否则返回 false
- *
- * @note 此函数通过计算叉积来得到面积的两倍，避免了除法，且全程使用绝对值，
- * 不受顶点顺序影响。最后的比较使用了浮点数容差(1e-10)来避免精度问题。
+ * @brief 查找缓存的布尔运算结果
+ * @return 命中时返回结果，未命中返回 nullptr；指针在下一次 storeBooleanOp 之前有效
  */
-bool Triangle::contains(const QPointF &pt) const {
-    double totalArea = std::abs((p2.x() - p1.x()) * (p3.y() - p1.y()) -
-                                (p2.y() - p1.y()) * (p3.x() - p1.x()));
-
-    double area1 = std::abs((p1.x() - pt.x()) * (p2.y() - pt.y()) -
-                            (p1.y() - pt.y()) * (p2.x() - pt.x()));
-    double area2 = std::abs((p2.x() - pt.x()) * (p3.y() - pt.y()) -
-                            (p2.y() - pt.y()) * (p3.x() - pt.x()));
-    double area3 = std::abs((p3.x() - pt.x()) * (p1.y() - pt.y()) -
-                            (p3.y() - pt.y()) * (p1.x() - pt.x()));
-
-    return std::abs(area1 + area2 + area3 - totalArea) < 1e-10;
+const DrawingWidget::BooleanOpResult *DrawingWidget::findBooleanOp(const BooleanOpKey &key) const
+{
+    for (const auto &entry : booleanOpCache) {
+        if (entry.first == key) return &entry.second;
+    }
+    return nullptr;
 }
 
 /**
- * @brief 检查一个多边形是否为“简单多边形”
- *
- * @details “简单多边形”指其任意两条不相邻的边都不会相交。此函数通过暴力法
- * 遍历多边形的所有不相邻边对，并调用 `segmentsIntersectStrictly`
- * 来检查它们是否严格相交。同时，它也会检查是否存在零长度的退化边。
- *
- * @param poly 以 QVector<QPointF> 形式存储的多边形顶点列表
- * @return bool 如果多边形是简单的（没有自相交），则返回 true；否则返回 false
- *
- * @note 这是执行三角剖分等高级算法前一个至关重要的合法性检查。
- * @complexity O(n^2)，其中 n 是多边形的顶点数。
+ * @brief 保存一次布尔运算的结果
+ * @details 版本号与 key 不同的条目已经过时，顺便移除；缓存中因此最多只有“引擎 × 运算”种组合，线性查找即可。
  */
-bool DrawingWidget::isSimplePolygon(const QVector<QPointF> &poly)
+void DrawingWidget::storeBooleanOp(const BooleanOpKey &key, BooleanOpResult result)
 {
-    int n = poly.size();
-    if (n < 3) return true; // 少于3个顶点，无法形成多边形，自然不自相交
-    if (n == 3) return true; // 3个顶点总是简单多边形
-
-    for (int i = 0; i < n; ++i) {
-        // 当前边 (p1, p2)
-        QPointF p1 = poly[i];
-        QPointF p2 = poly[(i + 1) % n];
-
-        // 检查零长度边（退化边）。简单多边形不允许顶点重合或边长为零。
-        if (p1 == p2) {
-            // QMessageBox::warning(this, "警告", QString("多边形存在零长度边：点 P%1 和 P%2 重合").arg(i+1).arg((i+1)%n + 1));
-            return false; // 存在零长度边，视为不合法
-        }
-
-        for (int j = 0; j < n; ++j) {
-            // 另一条边 (q1, q2)
-            QPointF q1 = poly[j];
-            QPointF q2 = poly[(j + 1) % n];
-
-            // 检查零长度边
-            if (q1 == q2) {
-                // QMessageBox::warning(this, "警告", QString("多边形存在零长度边：点 P%1 和 P%2 重合").arg(j+1).arg((j+1)%n + 1));
-                return false; // 存在零长度边，视为不合法
-            }
-
-            // 关键的排除条件：
-            // 1. i == j: 两条边是同一条边 (p1p2 == q1q2)
-            // 2. j == (i + 1) % n: 两条边是相邻边 (p1p2 和 p2p3)
-            // 3. i == (j + 1) % n: 两条边是相邻边 (p1p2 和 p_last_p1)
-            if (i == j ||
-                j == (i + 1) % n ||
-                i == (j + 1) % n)
-            {
-                continue; // 跳过这些情况，因为它们是合法连接，不构成自相交
-            }
+    booleanOpCache.erase(std::remove_if(booleanOpCache.begin(), booleanOpCache.end(),
+                                        [&key](const std::pair<BooleanOpKey, BooleanOpResult> &entry) {
+                                            return entry.first.versionA != key.versionA
+                                                   || entry.first.versionB != key.versionB;
+                                        }),
+                         booleanOpCache.end());
+    booleanOpCache.emplace_back(key, std::move(result));
+}
 
-            // 额外排除：如果两条边共享一个端点，不视为自相交。
-            // 比如 P1-P2 和 P3-P1，它们在 P1 处接触。
-            // 即使它们不相邻，但在简单多边形定义中，这种接触不算自相交。
-            // segmentsIntersectStrictly 已经排除了端点相交，所以这里不再需要额外判断。
+/**
+ * @brief 让 drawingRing 跟踪顶点容器 ring
+ * @details drawingRing 只为正在绘制的那个环建立边索引。切换到另一个环（多边形 A 画完开始画 B、
+ * 外边界闭合后开始画孔洞等）时，ring 与上次不同或顶点数对不上，就按 ring 的当前内容重建。
+ * @return bool ring 中的边是否都经过逐点检查（重建时 ring 已有边则为 false）
+ */
+bool DrawingWidget::syncDrawingRing(const QVector<QPointF> &ring)
+{
+    if (drawingRingSource == &ring && drawingRing.size() == static_cast<std::size_t>(ring.size())) return true;
+    drawingRing.clear();
+    for (const QPointF &p : ring) drawingRing.append(toGeometry(p));
+    drawingRingSource = &ring;
+    return ring.size() < 2;
+}
 
-            // 调用严格相交判断
-            if (segmentsIntersect(p1, p2, q1, q2)) {
-                return false; // 发现严格内部交叉，多边形自相交
-            }
-        }
+/**
+ * @brief 向正在绘制的环追加一个顶点
+ * @details 用 Geometry::IncrementalPolygon 检查新边：与上一条边折返、与其余的边相交或与上一个顶点重合时
+ * 拒绝这次点击，高亮冲突的两条边并在状态栏说明，已画的顶点保持不变。
+ * @return bool 顶点是否被追加
+ * @complexity 期望 O(1)，与环的顶点数无关
+ */
+bool DrawingWidget::appendRingVertex(QVector<QPointF> &ring, PolygonVersion &version, const QPointF &p)
+{
+    syncDrawingRing(ring);
+    const std::optional<std::size_t> conflict = drawingRing.findConflict(toGeometry(p));
+    if (conflict) {
+        highlightConflict(ring.last(), p, ring, *conflict);
+        emit modeChanged(*conflict == Geometry::IncrementalPolygon::kZeroLength
+                             ? QString("该点与上一个顶点重合，已忽略。")
+                             : QString("新边会与红色高亮的第 %1 条边相交，已忽略这次点击。").arg(static_cast<qulonglong>(*conflict + 1)));
+        return false;
     }
-    return true; // 没有发现自相交
+    drawingRing.append(toGeometry(p));
+    ring.append(p);
+    version.touch();
+    rejectedEdges.clear();
+    return true;
 }
 
 /**
- * @brief 判断一个点是否精确地位于一条线段之上
- *
- * @details 此函数采用两步检查法：
- * 1. **包围盒检查**：快速判断点的坐标是否在线段两个端点构成的矩形范围内。
- * 2. **共线性检查**：通过计算三点叉积是否为零，来精确判断点是否在线段所在的直线上。
- * 只有同时满足这两个条件，点才算在线段上。
- *
- * @param a 线段的起点
- * @param b 线段的终点
- * @param c 要测试的点
- * @return bool 如果点 c 在线段 ab 上，返回 true；否则返回 false
+ * @brief 检查正在绘制的环能否闭合
+ * @details 开放折线上的边对已在追加时检查过，这里只检查闭合边（最后一个顶点连回第一个顶点），
+ * 通过后直接把该版本记为简单多边形，随后的 isSimplePolygon 不再重新判定。
+ * 若环不是逐点画出的（边未经检查），退回到完整的 isSimplePolygon。
+ * @return bool 闭合后的多边形是否为简单多边形
  */
-bool DrawingWidget::onSegment(const QPointF &a, const QPointF &b, const QPointF &c) {
-    // 检查c是否在ab的包围盒内
-    if (c.x() < std::min(a.x(), b.x()) || c.x() > std::max(a.x(), b.x()) ||
-        c.y() < std::min(a.y(), b.y()) || c.y() > std::max(a.y(), b.y())) {
+bool DrawingWidget::checkRingClosable(const QVector<QPointF> &ring, PolygonVersion &version)
+{
+    if (!syncDrawingRing(ring)) return isSimplePolygon(ring, version);
+    const std::optional<std::size_t> conflict = drawingRing.findClosingConflict();
+    if (conflict) {
+        highlightConflict(ring.last(), ring.first(), ring, *conflict);
+        version.setSimple(false);
         return false;
     }
-    // 检查三点是否共线
-    return qAbs(crossProduct(a, b, c)) < 1e-10;  // 使用浮点数精度
+    rejectedEdges.clear();
+    version.setSimple(true);
+    return true;
 }
 
 /**
- * @brief 判断两条线段 p1p2 和 q1q2 是否相交（包括端点接触和共线重叠）
- *
- * @details 这是一个标准的线段相交检测算法，分为两部分：
- * 1. **跨立实验**：通过四次叉积判断，检查两条线段的端点是否分别位于对方所在直线的两侧。
- * 这能处理绝大多数“X”型的交叉情况。
- * 2. **共线检查**：处理特殊情况，即当某条线段的一个端点恰好落在另一条线段上时，
- * 也判定为相交。这需要借助 onSegment() 函数。
- *
- * @param p1 线段1的起点
- * @param p2 线段1的终点
- * @param q1 线段2的起点
- * @param q2 线段2的终点
- * @return bool 如果两条线段有任何形式的接触或交叉，返回 true；否则返回 false
+ * @brief 检查孔洞能否与外边界、已闭合的孔洞放在一起
+ * @details 先把外边界与已闭合的孔洞作为闭合的环登记到一个 Geometry::IncrementalPolygon 中，
+ * 再逐条加入孔洞的边，按逐点绘制时的规则检查是否与其他环的边相交或重合，冲突时高亮两条边；
+ * 边都不相交后用 Geometry::isSimplePolygonWithHoles 排除孔洞在外边界之外、与其他孔洞互相包含或共用顶点的情况。
+ * @return bool 孔洞是否可以加入 polygonHoles；否则已在状态栏说明原因
+ * @complexity 期望 O(n) 建立边索引 + O(n log n) 整体检查，n 为所有环的顶点总数
  */
-bool DrawingWidget::segmentsIntersect(QPointF p1, QPointF p2, QPointF q1, QPointF q2)
+bool DrawingWidget::checkHoleClosable(const QVector<QPointF> &hole)
 {
-    // 定义叉积 lambda，确保使用 long long 避免溢出
-    auto cross = [](const QPointF&a, const QPointF &b, const QPointF &c) {
-        return (long long)(b.x() - a.x()) * (c.y() - a.y()) - (long long)(b.y() - a.y()) * (c.x() - a.x());
-    };
-
-    long long o1 = cross(p1, p2, q1);
-    long long o2 = cross(p1, p2, q2);
-    long long o3 = cross(q1, q2, p1);
-    long long o4 = cross(q1, q2, p2);
-
-    // 1. 一般情况：两条线段严格相交（即，每条线段的两个端点在另一条线段的两侧）
-    // o1和o2符号不同，且o3和o4符号不同
-    if ((o1 > 0 && o2 < 0 || o1 < 0 && o2 > 0) &&
-        (o3 > 0 && o4 < 0 || o3 < 0 && o4 > 0)) {
-        return true;
+    Geometry::IncrementalPolygon rings;
+    for (const QPointF &p : polygonVertices) rings.append(toGeometry(p));
+    rings.closeRing();
+    for (const QVector<QPointF> &closed : polygonHoles) {
+        for (const QPointF &p : closed) rings.append(toGeometry(p));
+        rings.closeRing();
+    }
+    std::optional<std::size_t> conflict;
+    QLineF rejected;
+    for (int i = 0; i < hole.size() && !conflict; ++i) {
+        conflict = rings.findConflict(toGeometry(hole[i])); //孔洞的第一个顶点还没有边，不会冲突
+        if (conflict) rejected = QLineF(hole[i - 1], hole[i]);
+        else rings.append(toGeometry(hole[i]));
+    }
+    if (!conflict) {
+        conflict = rings.findClosingConflict();
+        rejected = QLineF(hole.last(), hole.first());
+    }
+    if (conflict) {
+        rejectedEdges.clear();
+        rejectedEdges.append(rejected);
+        if (*conflict != Geometry::IncrementalPolygon::kZeroLength) {
+            rejectedEdges.append(QLineF(toQt(rings.vertices()[*conflict]), toQt(rings.vertices()[rings.edgeEnd(*conflict)])));
+        }
+        emit modeChanged("孔洞的边与红色高亮的边相交或重合，请继续添加顶点后再右键闭合。");
+        update();
+        return false;
     }
 
-    // 2. 处理特殊情况：共线且有重叠（但不是严格内部相交的情况，例如端点重合）
-    // 对于简单多边形判断，我们通常不认为共线或端点接触是“自相交”
-    // 所以，这里我们只判断严格内部交叉，如果需要处理共线重叠，需要更复杂的逻辑
-    // 但对于普通简单多边形判断，这个严格判断已经足够。
-    // 如果一条线段的端点在另一条线段的内部，这也算严格相交。
-    // 以下是补充处理共线时端点在另一条线段内部的情况（此时叉积为0）
-    /*“严格相交”通常有更精确的定义，它指的是两条线段在各自的内部发生了交叉（像一个'X'），而不包括仅仅在端点处发生接触的情况*/
-    if (o1 == 0 && onSegment(p1, p2, q1) && !(q1 == p1 || q1 == p2)) return true; // q1在p1p2上且不是p1或p2
-    if (o2 == 0 && onSegment(p1, p2, q2) && !(q2 == p1 || q2 == p2)) return true; // q2在p1p2上且不是p1或p2
-    if (o3 == 0 && onSegment(q1, q2, p1) && !(p1 == q1 || p1 == q2)) return true; // p1在q1q2上且不是q1或q2
-    if (o4 == 0 && onSegment(q1, q2, p2) && !(p2 == q1 || p2 == q2)) return true; // p2在q1q2上且不是q1或q2
-
-    return false; // 其他情况（包括不相交、只在端点处接触、共线但无重叠、共线且端点重叠）
+    Geometry::PolygonWithHoles polygon;
+    polygon.outer = toGeometry(polygonVertices);
+    polygon.holes.reserve(polygonHoles.size() + 1);
+    for (const QVector<QPointF> &closed : polygonHoles) polygon.holes.push_back(toGeometry(closed));
+    polygon.holes.push_back(toGeometry(hole));
+    rejectedEdges.clear();
+    update();
+    if (!Geometry::isSimplePolygonWithHoles(polygon)) {
+        emit modeChanged("孔洞必须严格位于外边界内部，不能包含其他孔洞、落在其他孔洞内或与其他环共用顶点。");
+        return false;
+    }
+    return true;
 }
 
-/**
- * @brief 使用鞋带公式(Shoelace Formula)计算多边形的有向面积的两倍
- *
- * @details 遍历多边形的所有边，累加每条边与其下一个顶点构成的叉积。
- * 最终结果的符号可以用来判断多边形顶点的环绕方向。
- *
- * @param pts 多边形的顶点列表
- * @return double
- * - > 0: 在Qt坐标系下，表示顶点为顺时针环绕。
- * - < 0: 在Qt坐标系下，表示顶点为逆时针环绕。
- * - = 0: 多边形退化为线段或面积为零。
- * @note 此函数是确保耳切法等算法输入方向一致性的关键。
- */
-double DrawingWidget::computeAreaSign(const QVector<QPointF> &pts)
+//记录需要高亮的边：被拒绝的新边 from→to，以及与之冲突的环上第 edge 条边（零长度冲突时没有）
+void DrawingWidget::highlightConflict(const QPointF &from, const QPointF &to, const QVector<QPointF> &ring, std::size_t edge)
 {
-    double sum = 0.0;
-    for (int i = 0; i < pts.size(); ++i) {
-        const QPointF &p1 = pts[i];
-        const QPointF &p2 = pts[(i + 1) % pts.size()];
-        sum += (p1.x() * p2.y() - p2.x() * p1.y());
+    rejectedEdges.clear();
+    rejectedEdges.append(QLineF(from, to));
+    if (edge != Geometry::IncrementalPolygon::kZeroLength) {
+        const int i = static_cast<int>(edge);
+        rejectedEdges.append(QLineF(ring[i], ring[(i + 1) % ring.size()]));
     }
-    return sum;
+    update();
 }
@@ -7,21 +7,17 @@
 #include <QMouseEvent>
 #include <QPixmap> //用于背景图
 #include <QPainterPath>
-#include <list>
-#include <optional>
-
-//为 Weiler-Atherton 算法定义的顶点节点结构体
-struct VertexNode {
-    QPointF point;// 顶点坐标
-    bool is_intersection = false;// 是否为交点
-    std::list<VertexNode>::iterator neighbor;//对应另一个链表中交点的指针（配对点）
-    bool is_entering = false;// 是否为进入交点（决定是否切换边界）
-    bool processed = false;// 是否已被处理（用于封闭轮廓循环标记）
-    double alpha = 0.0; // 插值位置（在原边段上的比例，用于排序）
-};
-
-//超前声明
-struct Triangle;
+#include <QLineF>
+
+#include "BooleanOp.h"
+#include "ConvexHull.h"
+#include "DynamicHull.h"
+#include "IncrementalHull.h"
+#include "Triangulation.h"
+#include "HalfEdgeMesh.h"
+#include "IncrementalPolygon.h"
+#include "ConstrainedDelaunay.h"
+#include "Voronoi.h"
 
 class DrawingWidget : public QWidget
 {
@@ -37,9 +33,6 @@ public:
         DRAW_POLYGON_B   // 计算交时的第二个多边形
     };
 
-    // 【新增】为 Weiler-Atherton 算法定义操作类型
-    enum BooleanOpType { Intersection, Union };
-
     explicit DrawingWidget(QWidget *parent = nullptr);//构造函数
     void setTask(const QString& task);//指定当前多边形绘制任务，比如 "triangulate" 或 "area"，由菜单项触发
 
@@ -56,6 +49,15 @@ public slots:
 
     void startAndrewConvexHull();
     void startGrahamConvexHull();
+    void startChanConvexHull();
+    void startParallelConvexHull();
+    void startIncrementalConvexHull();
+    void startDynamicConvexHull();
+    void setConvexHullPrefilter(Geometry::HullPrefilter prefilter); //设置凸包的 Akl–Toussaint 预过滤方式
+    void setConvexHullThreadCount(int threadCount); //设置并行凸包的线程数，0 表示全部核心
+    void setTriangulationAlgorithm(Geometry::TriangulationAlgorithm algorithm); //设置三角剖分使用的算法
+    void setHoledTriangulation(bool holed); //三角剖分时是否绘制带孔洞的多边形（先画外边界，再逐个画孔洞）
+    void setShowDelaunayVoronoi(bool show); //凸包计算时是否同时求点集的 Delaunay 三角剖分与 Voronoi 图
 
     //QPainterPath算法的槽函数
     void showIntersection_QPainterPath();
@@ -65,44 +67,97 @@ public slots:
     void showIntersection_Weiler();
     void showUnion_Weiler();
 
+    //Martinez 扫描线裁剪的槽函数（额外支持差集与异或）
+    void showIntersection_Martinez();
+    void showUnion_Martinez();
+    void showDifference_Martinez();
+    void showXor_Martinez();
+
+    //凸多边形 O(n+m) 求交的槽函数（两个输入都必须是凸多边形）
+    void showIntersection_Convex();
+
 protected:
     // Qt事件处理函数，重写这些函数以响应鼠标和绘图事件
     void paintEvent(QPaintEvent *event) override;//重新绘制界面，负责显示点、边、凸包、多边形、三角剖分、面积等
-    void mousePressEvent(QMouseEvent *event) override;//处理用户点击：左键添加点或顶点，右键触发计算
+    void mousePressEvent(QMouseEvent *event) override;//处理用户点击：左键添加点或顶点，右键触发计算（动态凸包模式下右键删除点）
 
 private:
     // --- 算法实现函数 ---
     void calculateConvexHull_Andrew(); //重命名
     void calculateConvexHull_Graham(); //格雷厄姆扫描法
-
-    void calculateIntersectionAndUnion();
-
-    void calculateBooleanOp_WeilerAtherton(BooleanOpType opType);
+    void calculateConvexHull_Chan(); //Chan 算法（输出敏感）
+    void calculateConvexHull_Parallel(); //多线程分治
+    void calculateConvexHull_Incremental(); //在线增量（每次点击已实时更新，这里只报告结果）
+    void insertIncrementalHullPoint(const QPointF &p); //增量模式下把新点插入在线凸包并刷新 convexHull
+    void calculateConvexHull_Dynamic(); //全动态（每次增删已实时更新，这里只报告结果）
+    void insertDynamicHullPoint(const QPointF &p); //动态模式下加入一个点
+    bool removeDynamicHullPoint(const QPointF &pos); //动态模式下删除距 pos 最近的点（在拾取半径内）
+    void runConvexHull(Geometry::HullAlgorithm algorithm, const QString &name); //执行凸包计算并在状态栏报告 h 与耗时
+    QString calculateDelaunayVoronoi(); //求 points 的 Delaunay 三角剖分与 Voronoi 图，返回附加到状态栏的说明
+
+    void calculateBooleanOp_QPainterPath(Geometry::BooleanOpType opType); //只计算请求的那一种运算
+
+    void calculateBooleanOp_WeilerAtherton(Geometry::BooleanOpType opType); //只支持交集与并集
+    void calculateBooleanOp_Martinez(Geometry::BooleanOpType opType);
+    bool calculateIntersection_Convex(); //两个多边形都是凸多边形时用 O(n+m) 算法求交，结果写入 intersectionPolygons
 
     void calculateTriangulation();
+    void calculateTriangulationWithHoles(); //外边界 polygonVertices 加孔洞 polygonHoles 的三角剖分
     void calculatePolygonArea();
 
 
     // --- 辅助函数 ---
-    double crossProduct(const QPointF &p1, const QPointF &p2, const QPointF &p3);
-    bool isPolygonEdge(const QPointF &a, const QPointF &b);
-    bool isSimplePolygon(const QVector<QPointF> &poly);
-    bool onSegment(const QPointF &a, const QPointF &b, const QPointF &c);
-    bool segmentsIntersect(QPointF p1, QPointF p2, QPointF q1, QPointF q2);
-    double computeAreaSign(const QVector<QPointF> &pts);
-    std::optional<QPointF> getLineSegmentIntersection(QPointF p1, QPointF p2, QPointF p3, QPointF p4, double& out_alpha);
-    bool isPointInsidePolygon(const QPointF& point, const QVector<QPointF>& polygon);
+    //多边形顶点的版本号：顶点每改动一次调用 touch()，只依赖顶点的判定结果（如简单性）在同一版本内复用
+    struct PolygonVersion {
+        quint64 version = 1;
+        quint64 simpleVersion = 0; // simple 对应的版本，0 表示尚未判定
+        bool simple = false;
+        void touch() { ++version; }
+        void setSimple(bool isSimple) { simple = isSimple; simpleVersion = version; }
+    };
+    bool isSimplePolygon(const QVector<QPointF> &poly, PolygonVersion &version); //同一版本只判定一次
+    bool syncDrawingRing(const QVector<QPointF> &ring); //让 drawingRing 跟踪 ring，返回其中的边是否都经过逐点检查
+    bool appendRingVertex(QVector<QPointF> &ring, PolygonVersion &version, const QPointF &p); //新边与已有边相交时拒绝并高亮
+    bool checkRingClosable(const QVector<QPointF> &ring, PolygonVersion &version); //检查闭合边，冲突时高亮
+    bool checkHoleClosable(const QVector<QPointF> &hole); //检查孔洞与外边界、已闭合孔洞的相交与包含关系
+    void highlightConflict(const QPointF &from, const QPointF &to, const QVector<QPointF> &ring, std::size_t edge);
+
+    //布尔运算结果缓存：引擎、运算类型与两个多边形的版本号都相同时直接复用上次的结果
+    enum class BooleanOpEngine { QPainterPath, Convex, WeilerAtherton, Martinez };
+    struct BooleanOpKey {
+        BooleanOpEngine engine;
+        Geometry::BooleanOpType op;
+        quint64 versionA, versionB;
+        bool operator==(const BooleanOpKey &o) const
+        {
+            return engine == o.engine && op == o.op && versionA == o.versionA && versionB == o.versionB;
+        }
+    };
+    struct BooleanOpResult {
+        QVector<QPolygonF> polygons; // 结果的所有环
+        QPainterPath path;           // QPainterPath 并集直接保存路径
+        QString status;              // 状态栏说明，命中缓存时重新显示
+    };
+    BooleanOpKey booleanOpKey(BooleanOpEngine engine, Geometry::BooleanOpType opType) const; //以 A、B 当前的版本号生成键
+    const BooleanOpResult *findBooleanOp(const BooleanOpKey &key) const; //未命中时返回 nullptr
+    void storeBooleanOp(const BooleanOpKey &key, BooleanOpResult result); //同时移除版本号已过时的条目
 
     // --- 成员变量 ---
     QVector<QPointF> polygonA;//计算交时的第一个多边形
     QVector<QPointF> polygonB;//计算交时的第二个多边形
+    PolygonVersion polygonAVersion, polygonBVersion; //两个多边形的版本号
     QVector<QPolygonF> intersectionPolygons; // 交集区域（可能有多个）
     QPainterPath unionPath; //直接存储并集的结果路径
     QPainterPath weilerResultPath;
+    std::vector<std::pair<BooleanOpKey, BooleanOpResult>> booleanOpCache; //各引擎、各运算的结果，只保留当前版本
 
     Mode currentMode;               // 当前的工作模式
     QString taskToPerform;          // 在DRAW_POLYGON模式下，具体要执行的任务 ("triangulate" 或 "area")
     QString convexHullAlgorithm;
+    Geometry::HullOptions hullOptions; //凸包计算选项（预过滤方式、线程数），清屏时保留
+    Geometry::TriangulationAlgorithm triangulationAlgorithm = Geometry::TriangulationAlgorithm::EarClipping; //三角剖分算法，清屏时保留
+    bool holedTriangulation = false; //三角剖分的输入是否带孔洞，清屏时保留
+    bool showDelaunayVoronoi = false; //凸包计算时同时求 Delaunay / Voronoi，清屏时保留
     QPixmap m_background; //用于存储背景图片
     QString displayMode; //用于记录当前是显示交集 "intersection" 还是并集 "union"
     bool polygonsReadyForOperation = false;
@@ -111,19 +166,24 @@ private:
     // --- 几何数据容器 ---
     QVector<QPointF> points;         // 存储用户点击的点 (用于凸包)
     QVector<QPointF> convexHull;     // 存储计算出的凸包顶点
+    QVector<QLineF> delaunayEdges;   // 点集的 Delaunay 三角剖分的边
+    QVector<QLineF> voronoiEdges;    // Voronoi 图的边（射线截断到画布之外）
+    Geometry::IncrementalHull incrementalHull; // 增量模式下在线维护的凸包
+    Geometry::DynamicHull dynamicHull; // 动态模式下支持删除的凸包
     QVector<QPointF> polygonVertices;// 存储用户绘制的多边形顶点
-    QVector<Triangle> triangles;    // 存储剖分后的三角形
+    QVector<QPointF> steinerPoints;  // 约束 Delaunay 剖分的附加内部点（Shift + 左键添加）
+    bool outerRingClosed = false;    // 带孔洞模式下外边界是否已闭合（之后的左键用于绘制孔洞）
+    QVector<QVector<QPointF>> polygonHoles; // 已闭合的孔洞
+    QVector<QPointF> currentHole;    // 正在绘制的孔洞
+    PolygonVersion polygonVerticesVersion, currentHoleVersion; //外边界与当前孔洞的版本号
+    Geometry::IncrementalPolygon drawingRing; //正在绘制的环（外边界、孔洞、多边形 A 或 B）的边索引，逐点检查新边
+    const QVector<QPointF> *drawingRingSource = nullptr; //drawingRing 跟踪的是哪个顶点容器
+    QVector<QLineF> rejectedEdges; //被拒绝的新边及与它相交的已有边，红色高亮
+    Geometry::HalfEdgeMesh triangleMesh; // 剖分结果：共享顶点 + 下标 + 半边邻接，边界边 O(1) 判定
     QVector<QPolygonF> weilerResultPolygons;
+    QVector<QPolygonF> clipResultPolygons; // Martinez 结果的所有环（外边界与孔洞），按奇偶规则填充
     double polygonArea;             // 存储计算出的多边形面积
     int triangleCount = -1; //用于记录三角形数量，-1表示未计算
 };
 
-// 用于三角剖分的辅助结构体
-struct Triangle {
-    QPointF p1, p2, p3;
-    Triangle(const QPointF &pt1, const QPointF &pt2, const QPointF &pt3)
-        : p1(pt1), p2(pt2), p3(pt3) {}
-    bool contains(const QPointF &pt) const;
-};
-
 #endif // FUNCTION_H
@@ -10,6 +10,8 @@
 #include <QPushButton>
 #include <QLabel>
 #include <QDialog>
+#include <QActionGroup>
+#include <QInputDialog>
 #include <QCloseEvent> // 确保包含了 QCloseEvent 的头文件
 
 /**
@@ -80,6 +82,8 @@ void MainWindow::onPolygonsReady(bool ready)
     // 现在是启用或禁用整个子菜单
     intersectionMenu->setEnabled(ready);
     unionMenu->setEnabled(ready);
+    differenceMenu->setEnabled(ready);
+    xorMenu->setEnabled(ready);
 }
 
 /**
@@ -87,11 +91,18 @@ void MainWindow::onPolygonsReady(bool ready)
  * @details
  * - **文件菜单**: 包含“清空屏幕”和“退出”功能。
  * - **算法菜单**: 包含所有核心几何算法的入口。
- * - **计算凸包**: 被设置为一个子菜单，内含 "Andrew 算法" 和 "Graham 算法" 两个选项。
+ * - **计算凸包**: 被设置为一个子菜单，内含 "Andrew 算法"、"Graham 算法"、"Chan 算法"、"并行分治"、"增量" 和 "动态" 六个选项，
+ * 以及并行线程数设置、对所有算法都生效的 "Akl–Toussaint 预过滤" 单选子菜单，
+ * 和可勾选的 "同时显示 Delaunay / Voronoi"（凸包算完后对同一组点做 Delaunay 三角剖分并画出对偶的 Voronoi 图）。
  * - **计算交并集**: 也是一个子菜单，首先有一个“开始绘制”的启动项，
- * 然后是两个默认禁用的子菜单“求交集”和“求并集”，每个子菜单内都提供了
- * "QPainterPath 法" 和 "Weiler-Atherton 法" 两种算法选项。
- * - **三角剖分** 和 **计算面积**: 作为直接的菜单动作。
+ * 然后是四个默认禁用的子菜单：“求交集”和“求并集”各提供
+ * "QPainterPath 法"、"Weiler-Atherton 法" 和 "扫描线裁剪 (Martinez) 法" 三种算法选项，
+ * “求交集”另有仅适用于凸多边形的 "凸多边形 O(n+m) 法"（前两种方法遇到凸输入时也会自动改走该路径），
+ * “求差集 (A−B)”和“求异或”由 Martinez 扫描线裁剪法计算。
+ * - **三角剖分**: 子菜单，提供 "耳切法"、"单调多边形分解" 和 "约束 Delaunay" 三种算法，选择后进入多边形绘制模式；
+ *   约束 Delaunay 模式下可用 Shift + 左键添加内部点；勾选 "带孔洞多边形" 后右键先闭合外边界，再逐个绘制孔洞，
+ *   孔洞经扫描线选出的桥边并入外边界后剖分。
+ * - **计算面积**: 作为直接的菜单动作。
  * - **执行计算菜单**: 提供一个全局的“执行”按钮，用于触发已设置好的计算任务。
  *
  * 所有菜单项都通过 `connect` 函数与 DrawingWidget 中对应的槽函数相连。
@@ -119,6 +130,55 @@ void MainWindow::createMenus()
     QAction *grahamAction = new QAction("Graham 算法 (Graham Scan)", this);
     connect(grahamAction, &QAction::triggered, drawingWidget, &DrawingWidget::startGrahamConvexHull);
     convexHullMenu->addAction(grahamAction);
+    QAction *chanAction = new QAction("Chan 算法 (Output-sensitive)", this);
+    connect(chanAction, &QAction::triggered, drawingWidget, &DrawingWidget::startChanConvexHull);
+    convexHullMenu->addAction(chanAction);
+    QAction *parallelAction = new QAction("并行分治 (多线程)", this);
+    connect(parallelAction, &QAction::triggered, drawingWidget, &DrawingWidget::startParallelConvexHull);
+    convexHullMenu->addAction(parallelAction);
+    QAction *incrementalAction = new QAction("增量 (实时更新)", this);
+    connect(incrementalAction, &QAction::triggered, drawingWidget, &DrawingWidget::startIncrementalConvexHull);
+    convexHullMenu->addAction(incrementalAction);
+    QAction *dynamicAction = new QAction("动态 (右键删除点)", this);
+    connect(dynamicAction, &QAction::triggered, drawingWidget, &DrawingWidget::startDynamicConvexHull);
+    convexHullMenu->addAction(dynamicAction);
+    convexHullMenu->addSeparator();
+
+    QAction *threadCountAction = new QAction("设置并行线程数...", this);
+    connect(threadCountAction, &QAction::triggered, this, [this](){
+        bool ok = false;
+        const int threads = QInputDialog::getInt(this, "并行线程数", "线程数 (0 表示使用全部核心)：", 0, 0, 1024, 1, &ok);
+        if (ok) {
+            drawingWidget->setConvexHullThreadCount(threads);
+        }
+    });
+    convexHullMenu->addAction(threadCountAction);
+
+    // 预过滤方式是一个持久的选项，三选一
+    QMenu *prefilterMenu = convexHullMenu->addMenu("Akl–Toussaint 预过滤");
+    QActionGroup *prefilterGroup = new QActionGroup(this);
+    const struct { const char *text; Geometry::HullPrefilter mode; } prefilters[] = {
+        {"不过滤", Geometry::HullPrefilter::None},
+        {"四边形 (4 个极值点)", Geometry::HullPrefilter::Quadrilateral},
+        {"八边形 (8 个极值点)", Geometry::HullPrefilter::Octagon},
+    };
+    for (const auto &item : prefilters) {
+        QAction *action = new QAction(item.text, this);
+        action->setCheckable(true);
+        action->setChecked(item.mode == Geometry::HullPrefilter::None);
+        prefilterGroup->addAction(action);
+        const Geometry::HullPrefilter mode = item.mode;
+        connect(action, &QAction::triggered, this, [this, mode](){
+            drawingWidget->setConvexHullPrefilter(mode);
+        });
+        prefilterMenu->addAction(action);
+    }
+
+    // 同一组点的 Delaunay 三角剖分与 Voronoi 图，勾选后随凸包一起计算
+    QAction *delaunayAction = new QAction("同时显示 Delaunay / Voronoi", this);
+    delaunayAction->setCheckable(true);
+    connect(delaunayAction, &QAction::toggled, drawingWidget, &DrawingWidget::setShowDelaunayVoronoi);
+    convexHullMenu->addAction(delaunayAction);
 
     intersectionUnionMenu = algorithmMenu->addMenu("2. 计算多边形交集、并集");
     QAction *startDrawingAction = new QAction("开始绘制", this);
@@ -137,6 +197,12 @@ void MainWindow::createMenus()
     QAction *intersectActionWeiler = new QAction("Weiler-Atherton 法", this);
     connect(intersectActionWeiler, &QAction::triggered, drawingWidget, &DrawingWidget::showIntersection_Weiler);
     intersectionMenu->addAction(intersectActionWeiler);
+    QAction *intersectActionMartinez = new QAction("扫描线裁剪 (Martinez) 法", this);
+    connect(intersectActionMartinez, &QAction::triggered, drawingWidget, &DrawingWidget::showIntersection_Martinez);
+    intersectionMenu->addAction(intersectActionMartinez);
+    QAction *intersectActionConvex = new QAction("凸多边形 O(n+m) 法", this);
+    connect(intersectActionConvex, &QAction::triggered, drawingWidget, &DrawingWidget::showIntersection_Convex);
+    intersectionMenu->addAction(intersectActionConvex);
 
 
     // --- “求并集”子菜单 ---
@@ -148,14 +214,46 @@ void MainWindow::createMenus()
     QAction *unionActionWeiler = new QAction("Weiler-Atherton 法", this);
     connect(unionActionWeiler, &QAction::triggered, drawingWidget, &DrawingWidget::showUnion_Weiler);
     unionMenu->addAction(unionActionWeiler);
+    QAction *unionActionMartinez = new QAction("扫描线裁剪 (Martinez) 法", this);
+    connect(unionActionMartinez, &QAction::triggered, drawingWidget, &DrawingWidget::showUnion_Martinez);
+    unionMenu->addAction(unionActionMartinez);
+
+    // --- “求差集”“求异或”子菜单 ---
+    differenceMenu = intersectionUnionMenu->addMenu("求差集 (A−B)");
+    differenceMenu->setEnabled(false);
+    QAction *differenceActionMartinez = new QAction("扫描线裁剪 (Martinez) 法", this);
+    connect(differenceActionMartinez, &QAction::triggered, drawingWidget, &DrawingWidget::showDifference_Martinez);
+    differenceMenu->addAction(differenceActionMartinez);
+
+    xorMenu = intersectionUnionMenu->addMenu("求异或");
+    xorMenu->setEnabled(false);
+    QAction *xorActionMartinez = new QAction("扫描线裁剪 (Martinez) 法", this);
+    connect(xorActionMartinez, &QAction::triggered, drawingWidget, &DrawingWidget::showXor_Martinez);
+    xorMenu->addAction(xorActionMartinez);
 
     // --- 其他菜单项 ---
-    QAction *triangulateAction = new QAction("3. 三角剖分", this);
-    connect(triangulateAction, &QAction::triggered, this, [this](){
-        drawingWidget->setMode(DrawingWidget::DRAW_POLYGON);
-        drawingWidget->setTask("triangulate");
-    });
-    algorithmMenu->addAction(triangulateAction);
+    QMenu *triangulateMenu = algorithmMenu->addMenu("3. 三角剖分");
+    const struct { const char *text; Geometry::TriangulationAlgorithm algorithm; } triangulations[] = {
+        {"耳切法 (Ear Clipping)", Geometry::TriangulationAlgorithm::EarClipping},
+        {"单调多边形分解 (Monotone, O(n log n))", Geometry::TriangulationAlgorithm::Monotone},
+        {"约束 Delaunay (CDT)", Geometry::TriangulationAlgorithm::ConstrainedDelaunay},
+    };
+    for (const auto &item : triangulations) {
+        QAction *action = new QAction(item.text, this);
+        const Geometry::TriangulationAlgorithm algorithm = item.algorithm;
+        connect(action, &QAction::triggered, this, [this, algorithm](){
+            drawingWidget->setMode(DrawingWidget::DRAW_POLYGON);
+            drawingWidget->setTask("triangulate");
+            drawingWidget->setTriangulationAlgorithm(algorithm);
+        });
+        triangulateMenu->addAction(action);
+    }
+    // 带孔洞的输入：右键先闭合外边界，再逐个绘制并闭合孔洞
+    triangulateMenu->addSeparator();
+    QAction *holedAction = new QAction("带孔洞多边形（右键闭合外边界与各孔洞）", this);
+    holedAction->setCheckable(true);
+    connect(holedAction, &QAction::toggled, drawingWidget, &DrawingWidget::setHoledTriangulation);
+    triangulateMenu->addAction(holedAction);
     QAction *areaAction = new QAction("4. 计算多边形面积", this);
     connect(areaAction, &QAction::triggered, this, [this](){
         drawingWidget->setMode(DrawingWidget::DRAW_POLYGON);
@@ -33,5 +33,7 @@ private:
     QMenu *intersectionUnionMenu; // “交集/并集”主菜单
     QMenu *intersectionMenu;      // “求交集”子菜单
     QMenu *unionMenu;             // “求并集”子菜单
+    QMenu *differenceMenu;        // “求差集”子菜单
+    QMenu *xorMenu;               // “求异或”子菜单
 };
 #endif // MAINWINDOW_H
@@ -0,0 +1,171 @@
+#include "AklToussaint.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GEOMETRY_HAVE_SSE2 1
+#endif
+
+namespace Geometry {
+
+static_assert(sizeof(Point) == 2 * sizeof(double), "SSE2 路径按 [x, y] 连续布局直接读取 Point 数组");
+
+namespace {
+
+//极值点在原数组中的下标，按方向逆时针排列：
+//minY, max(x-y), maxX, max(x+y), maxY, min(x-y), minX, min(x+y)
+struct ExtremeIndices {
+    std::size_t idx[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+};
+
+#ifdef GEOMETRY_HAVE_SSE2
+//按掩码逐通道选择：mask 为真取 b，否则取 a
+inline __m128d select(__m128d a, __m128d b, __m128d mask)
+{
+    return _mm_or_pd(_mm_and_pd(mask, b), _mm_andnot_pd(mask, a));
+}
+#endif
+
+/**
+ * @brief 一次线性扫描同时求出 8 个方向上的极值点
+ * @details SSE2 路径把一个点 [x, y] 装入一个寄存器，同时维护 x、y 的最小/最大值，
+ * 再用一次换位得到 [x+y, x-y]，维护其最小/最大值；下标以 double 形式随值一起按比较掩码更新。
+ * 相等时保留先出现的点。没有 SSE2 的平台走等价的标量循环。
+ * @complexity O(n)
+ */
+ExtremeIndices findExtremes(PointSpan points)
+{
+    ExtremeIndices e;
+    const std::size_t n = points.size();
+
+#ifdef GEOMETRY_HAVE_SSE2
+    const double *raw = &points.data()->x;
+    __m128d v = _mm_loadu_pd(raw);
+    __m128d a = _mm_unpacklo_pd(_mm_add_pd(v, _mm_shuffle_pd(v, v, 1)), _mm_sub_pd(v, _mm_shuffle_pd(v, v, 1)));
+    __m128d minV = v, maxV = v, minA = a, maxA = a;
+    __m128d minVI = _mm_setzero_pd(), maxVI = minVI, minAI = minVI, maxAI = minVI;
+
+    for (std::size_t i = 1; i < n; ++i) {
+        v = _mm_loadu_pd(raw + 2 * i);                       // [x, y]
+        const __m128d w = _mm_shuffle_pd(v, v, 1);            // [y, x]
+        a = _mm_unpacklo_pd(_mm_add_pd(v, w), _mm_sub_pd(v, w)); // [x+y, x-y]
+        const __m128d idx = _mm_set1_pd(static_cast<double>(i));
+
+        __m128d m = _mm_cmplt_pd(v, minV);
+        minV = select(minV, v, m);
+        minVI = select(minVI, idx, m);
+        m = _mm_cmpgt_pd(v, maxV);
+        maxV = select(maxV, v, m);
+        maxVI = select(maxVI, idx, m);
+        m = _mm_cmplt_pd(a, minA);
+        minA = select(minA, a, m);
+        minAI = select(minAI, idx, m);
+        m = _mm_cmpgt_pd(a, maxA);
+        maxA = select(maxA, a, m);
+        maxAI = select(maxAI, idx, m);
+    }
+
+    double lanes[2];
+    auto lane = [&](__m128d r, int k) { _mm_storeu_pd(lanes, r); return static_cast<std::size_t>(lanes[k]); };
+    e.idx[0] = lane(minVI, 1); // minY
+    e.idx[1] = lane(maxAI, 1); // max(x-y)
+    e.idx[2] = lane(maxVI, 0); // maxX
+    e.idx[3] = lane(maxAI, 0); // max(x+y)
+    e.idx[4] = lane(maxVI, 1); // maxY
+    e.idx[5] = lane(minAI, 1); // min(x-y)
+    e.idx[6] = lane(minVI, 0); // minX
+    e.idx[7] = lane(minAI, 0); // min(x+y)
+#else
+    auto sum = [&](std::size_t i) { return points[i].x + points[i].y; };
+    auto diff = [&](std::size_t i) { return points[i].x - points[i].y; };
+    for (std::size_t i = 1; i < n; ++i) {
+        const Point &p = points[i];
+        if (p.y < points[e.idx[0]].y) e.idx[0] = i;
+        if (diff(i) > diff(e.idx[1])) e.idx[1] = i;
+        if (p.x > points[e.idx[2]].x) e.idx[2] = i;
+        if (sum(i) > sum(e.idx[3])) e.idx[3] = i;
+        if (p.y > points[e.idx[4]].y) e.idx[4] = i;
+        if (diff(i) < diff(e.idx[5])) e.idx[5] = i;
+        if (p.x < points[e.idx[6]].x) e.idx[6] = i;
+        if (sum(i) < sum(e.idx[7])) e.idx[7] = i;
+    }
+#endif
+    return e;
+}
+
+} // namespace
+
+/**
+ * @brief Akl–Toussaint 启发式：剔除不可能成为凸包顶点的内部点
+ * @details 先线性扫描找出若干方向上的极值点，它们按方向顺序构成一个内接于凸包的凸多边形
+ * （四边形或八边形）；严格位于该多边形内部的点不可能是凸包顶点，直接丢弃。
+ * 边界上的点与多边形外的点全部保留，因此过滤后再求凸包结果不变。
+ * 判定使用与 crossProduct 完全相同的运算顺序，SSE2 路径一次测试两个点。
+ * 对均匀分布的数据，八边形通常能剔除绝大部分输入，大幅减少后续排序的规模。
+ * @param points 输入点集
+ * @param mode 过滤多边形的形状；None 时原样返回
+ * @return 保留下来的点，保持原有相对顺序
+ * @complexity O(n)
+ */
+std::vector<Point> aklToussaintFilter(PointSpan points, HullPrefilter mode)
+{
+    const std::size_t n = points.size();
+    if (mode == HullPrefilter::None || n < 8) return std::vector<Point>(points.begin(), points.end());
+
+    // 1. 组装极值多边形（逆时针），去掉相邻的重复顶点
+    const ExtremeIndices e = findExtremes(points);
+    Point poly[8];
+    std::size_t count = 0;
+    for (int k = 0; k < 8; ++k) {
+        if (mode == HullPrefilter::Quadrilateral && (k % 2) == 1) continue;
+        const Point &p = points[e.idx[k]];
+        if (count == 0 || p != poly[count - 1]) poly[count++] = p;
+    }
+    while (count > 1 && poly[count - 1] == poly[0]) --count;
+    if (count < 3) return std::vector<Point>(points.begin(), points.end());
+
+    //每条边预先取出起点与方向向量
+    double ax[8], ay[8], ex[8], ey[8];
+    for (std::size_t k = 0; k < count; ++k) {
+        const Point &from = poly[k];
+        const Point &to = poly[(k + 1) % count];
+        ax[k] = from.x;
+        ay[k] = from.y;
+        ex[k] = to.x - from.x;
+        ey[k] = to.y - from.y;
+    }
+
+    // 2. 过滤：p 在所有边的严格左侧才算内部点
+    std::vector<Point> kept;
+    kept.reserve(n / 4 + 8);
+    std::size_t i = 0;
+#ifdef GEOMETRY_HAVE_SSE2
+    const __m128d zero = _mm_setzero_pd();
+    const double *raw = &points.data()->x;
+    for (; i + 2 <= n; i += 2) {
+        const __m128d p0 = _mm_loadu_pd(raw + 2 * i);
+        const __m128d p1 = _mm_loadu_pd(raw + 2 * i + 2);
+        const __m128d xs = _mm_unpacklo_pd(p0, p1);
+        const __m128d ys = _mm_unpackhi_pd(p0, p1);
+        __m128d inside = _mm_cmpeq_pd(zero, zero);
+        for (std::size_t k = 0; k < count; ++k) {
+            const __m128d cross = _mm_sub_pd(_mm_mul_pd(_mm_set1_pd(ex[k]), _mm_sub_pd(ys, _mm_set1_pd(ay[k]))),
+                                             _mm_mul_pd(_mm_set1_pd(ey[k]), _mm_sub_pd(xs, _mm_set1_pd(ax[k]))));
+            inside = _mm_and_pd(inside, _mm_cmpgt_pd(cross, zero));
+        }
+        const int mask = _mm_movemask_pd(inside);
+        if (!(mask & 1)) kept.push_back(points[i]);
+        if (!(mask & 2)) kept.push_back(points[i + 1]);
+    }
+#endif
+    for (; i < n; ++i) {
+        const Point &p = points[i];
+        bool inside = true;
+        for (std::size_t k = 0; k < count && inside; ++k) {
+            inside = ex[k] * (p.y - ay[k]) - ey[k] * (p.x - ax[k]) > 0;
+        }
+        if (!inside) kept.push_back(p);
+    }
+    return kept;
+}
+
+} // namespace Geometry
@@ -0,0 +1,19 @@
+#ifndef AKLTOUSSAINT_H
+#define AKLTOUSSAINT_H
+/*AklToussaint 实现凸包的内点预过滤：线性扫描找出极值点，剔除落在极值多边形内部的点*/
+#include "GeometryTypes.h"
+
+namespace Geometry {
+
+enum class HullPrefilter {
+    None,          // 不过滤
+    Quadrilateral, // x、y 方向的 4 个极值点
+    Octagon        // 再加上 x+y、x-y 方向，共 8 个极值点
+};
+
+// 返回可能位于凸包上的点（保持原有顺序），严格位于极值多边形内部的点被剔除
+std::vector<Point> aklToussaintFilter(PointSpan points, HullPrefilter mode);
+
+} // namespace Geometry
+
+#endif // AKLTOUSSAINT_H
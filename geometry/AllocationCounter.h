@@ -0,0 +1,69 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+/*AllocationCounter 统计一次运算内部容器的堆分配次数与内存峰值，用于对比不同数据布局*/
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace Geometry {
+
+//分配统计：由 CountingAllocator 在每次分配、释放时更新
+struct AllocationCounter {
+    std::size_t allocations = 0;  // 分配次数
+    std::size_t currentBytes = 0; // 当前仍在使用的字节数
+    std::size_t peakBytes = 0;    // 字节数峰值
+
+    void onAllocate(std::size_t bytes)
+    {
+        ++allocations;
+        currentBytes += bytes;
+        if (currentBytes > peakBytes) peakBytes = currentBytes;
+    }
+    void onDeallocate(std::size_t bytes) { currentBytes -= bytes; }
+};
+
+/**
+ * @brief 把分配情况记入 AllocationCounter 的标准分配器
+ * @details 计数器为空时与 std::allocator 行为相同。分配器之间按计数器判等，
+ * 因此同一次运算中的容器可以互相移动而不发生拷贝。
+ */
+template <typename T>
+class CountingAllocator
+{
+public:
+    using value_type = T;
+
+    CountingAllocator() = default;
+    explicit CountingAllocator(AllocationCounter *counter) : m_counter(counter) {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> &other) : m_counter(other.counter()) {}
+
+    T *allocate(std::size_t n)
+    {
+        if (m_counter) m_counter->onAllocate(n * sizeof(T));
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T *p, std::size_t n)
+    {
+        if (m_counter) m_counter->onDeallocate(n * sizeof(T));
+        ::operator delete(p);
+    }
+
+    AllocationCounter *counter() const { return m_counter; }
+
+private:
+    AllocationCounter *m_counter = nullptr;
+};
+
+template <typename T, typename U>
+bool operator==(const CountingAllocator<T> &a, const CountingAllocator<U> &b) { return a.counter() == b.counter(); }
+template <typename T, typename U>
+bool operator!=(const CountingAllocator<T> &a, const CountingAllocator<U> &b) { return !(a == b); }
+
+template <typename T>
+using CountedVector = std::vector<T, CountingAllocator<T>>;
+
+} // namespace Geometry
+
+#endif // ALLOCATIONCOUNTER_H
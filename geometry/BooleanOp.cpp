@@ -0,0 +1,196 @@
+#include "BooleanOp.h"
+#include "ConvexIntersection.h"
+#include "PolygonUtils.h"
+#include "Predicates.h"
+#include "SegmentIntersection.h"
+#include <algorithm>
+#include <chrono>
+
+namespace Geometry {
+
+/**
+ * @brief 使用 Weiler–Atherton 算法计算两个多边形的布尔运算（交集或并集）。
+ * @param polygonA 第一个多边形
+ * @param polygonB 第二个多边形
+ * @param opType 指定要执行的操作是 Intersection 还是 Union。
+ * @param stats [out] 可选，非空时写入交点数、交点发现与穿梭缝合两个阶段各自的耗时，以及内部容器的分配次数和内存峰值
+ * @return 结果多边形的所有轮廓
+ * @details 算法先用扫描线（findEdgeIntersections）找出两条边界的全部交点，
+ * 再按交点在各边上的参数位置 alpha 插入两个多边形的增强链表（连续数组 + 下标链接），并根据“进入/穿出”规则
+ * 在两个链表之间“穿梭”，最终缝合出结果多边形。可以正确处理多区域和带孔洞的情况。
+ * @complexity 交点发现 O((n+m+I) log(n+m))，建表与缝合 O(n+m+I log I)，其中 I 是交点数。
+ */
+std::vector<Polygon> booleanOpWeilerAtherton(PointSpan polygonA, PointSpan polygonB, BooleanOpType opType,
+                                             BooleanOpStats *stats)
+{
+    using Clock = std::chrono::steady_clock;
+    std::vector<Polygon> result;
+    if (polygonA.size() < 3 || polygonB.size() < 3) return result;
+    if (opType != BooleanOpType::Intersection && opType != BooleanOpType::Union) return result;
+
+    Polygon polyA(polygonA.begin(), polygonA.end());
+    Polygon polyB(polygonB.begin(), polygonB.end());
+
+    //确保两个多边形都是逆时针顺序（数学坐标系下有向面积为正），时间复杂度O(n+m)
+    if (computeAreaSign(polyA) < 0) std::reverse(polyA.begin(), polyA.end());
+    if (computeAreaSign(polyB) < 0) std::reverse(polyB.begin(), polyB.end());
+
+    //运算内部的所有容器都通过 memory 计数，用于报告分配次数与内存峰值
+    AllocationCounter memory;
+
+    //寻找所有交点，时间复杂度O((n+m+I)log(n+m))
+    const auto discoveryBegin = Clock::now();
+    const CountedVector<EdgeIntersection> intersections = findEdgeIntersections(polyA, polyB, memory);
+    const auto traversalBegin = Clock::now();
+
+    //构建增强链表：两个多边形的结点连续存放在同一个数组中（A 在前、B 在后），
+    //next 与 neighbor 都是数组下标，整个链表只需一次分配，时间复杂度O(n+m+I log I)
+    CountedVector<VertexNode> nodes{CountingAllocator<VertexNode>(&memory)};
+    nodes.reserve(polyA.size() + polyB.size() + 2 * intersections.size());
+    CountedVector<int> nodeOfA(intersections.size(), -1, CountingAllocator<int>(&memory));
+    CountedVector<int> nodeOfB(intersections.size(), -1, CountingAllocator<int>(&memory));
+
+    auto appendRing = [&](const Polygon &poly, bool isA, CountedVector<int> &nodeOf) {
+        //先按所在边做计数排序，得到每条边上的交点
+        CountedVector<std::size_t> edgeStart(poly.size() + 1, 0, CountingAllocator<std::size_t>(&memory));
+        for (const EdgeIntersection &hit : intersections) ++edgeStart[(isA ? hit.edgeA : hit.edgeB) + 1];
+        for (std::size_t i = 0; i < poly.size(); ++i) edgeStart[i + 1] += edgeStart[i];
+        CountedVector<std::size_t> byEdge(intersections.size(), 0, CountingAllocator<std::size_t>(&memory));
+        CountedVector<std::size_t> fill(edgeStart.begin(), edgeStart.end() - 1, CountingAllocator<std::size_t>(&memory));
+        for (std::size_t k = 0; k < intersections.size(); ++k) {
+            byEdge[fill[isA ? intersections[k].edgeA : intersections[k].edgeB]++] = k;
+        }
+
+        const int first = static_cast<int>(nodes.size());
+        for (std::size_t i = 0; i < poly.size(); ++i) {
+            nodes.push_back({poly[i]});
+            //该边上的交点按插值位置 alpha 排序后依次插入；neighbor 暂存交点编号
+            const int edgeFirst = static_cast<int>(nodes.size());
+            for (std::size_t j = edgeStart[i]; j < edgeStart[i + 1]; ++j) {
+                const EdgeIntersection &hit = intersections[byEdge[j]];
+                VertexNode node{hit.point, true};
+                node.neighbor = static_cast<int>(byEdge[j]);
+                node.alpha = isA ? hit.alphaA : hit.alphaB;
+                nodes.push_back(node);
+            }
+            std::sort(nodes.begin() + edgeFirst, nodes.end(),
+                      [](const VertexNode &u, const VertexNode &v) { return u.alpha < v.alpha; });
+            for (int j = edgeFirst; j < static_cast<int>(nodes.size()); ++j) nodeOf[nodes[j].neighbor] = j;
+        }
+        const int last = static_cast<int>(nodes.size());
+        for (int j = first; j < last; ++j) nodes[j].next = (j + 1 < last) ? j + 1 : first;//首尾相接
+        return last;
+    };
+    const int endA = appendRing(polyA, true, nodeOfA);
+    appendRing(polyB, false, nodeOfB);
+
+    for (std::size_t k = 0; k < intersections.size(); ++k) {
+        const EdgeIntersection &hit = intersections[k];
+        VertexNode &nodeA = nodes[nodeOfA[k]];
+        VertexNode &nodeB = nodes[nodeOfB[k]];
+        nodeA.neighbor = nodeOfB[k];
+        nodeB.neighbor = nodeOfA[k];
+
+        //事先规定A和B都是逆时针，这里看交叉点处B多边形的方向在A多边形方向的左边还是右边
+        const Point dirA = polyA[(hit.edgeA + 1) % polyA.size()] - polyA[hit.edgeA];
+        const Point dirB = polyB[(hit.edgeB + 1) % polyB.size()] - polyB[hit.edgeB];
+        double cross = crossProduct({0, 0}, dirA, dirB);
+        nodeA.is_entering = cross > 0;//大于零就是左侧，左侧就是内侧，进入
+        nodeB.is_entering = cross < 0;
+    }
+
+    //遍历与缝合，找出结果多边形，时间复杂度 (O(n + m + I))
+    const bool is_union = (opType == BooleanOpType::Union);
+    for (int start = 0; start < endA; ++start) {
+        if (!nodes[start].is_intersection || nodes[start].processed) continue;
+        //如果是 并集，则必须从 退出交点开始；如果是 交集，则必须从 进入交点开始
+        if (is_union == nodes[start].is_entering) continue;
+
+        Polygon current_result;//当前路径的点集合
+        int current = start;//当前访问的节点下标（A、B 共用同一数组，不再需要记录所在链表）
+        std::size_t loop_guard = 0;//防止死循环（因为链表是环形的）
+        const std::size_t max_loops = nodes.size() + 1;
+
+        do {
+            if (++loop_guard > max_loops) break;
+
+            VertexNode &node = nodes[current];
+            node.processed = true;//标记为 processed，避免重复使用
+            if (node.is_intersection) nodes[node.neighbor].processed = true;
+
+            current_result.push_back(node.point);
+
+            //走到交点时，根据并集/交集规则决定是否切换链表
+            if (node.is_intersection && is_union != node.is_entering) {
+                current = node.neighbor;
+            }
+
+            current = nodes[current].next;//看下一个点，环形链表自动衔接开头
+        } while (current != start && current != nodes[start].neighbor);
+        //结束条件是如果回到起点，结束；如果走回了起点（交点）的邻居，说明闭环完成，结束。
+        if (current_result.size() > 2) {
+            result.push_back(current_result);
+        }
+    }
+
+    //处理无交点的特殊情况（包含或相离），时间复杂度(O(n+m))
+    if (result.empty()) {
+        bool a_in_b = isPointInsidePolygon(polyA[0], polyB);//A 的一个点是否在 B 内部
+        bool b_in_a = isPointInsidePolygon(polyB[0], polyA);//B 的一个点是否在 A 内部
+
+        if (opType == BooleanOpType::Intersection) {
+            if (a_in_b)
+                result.push_back(polyA);//A在B中，交集为A
+            else if (b_in_a)
+                result.push_back(polyB);//B在A中，交集为B
+        } else {
+            if (a_in_b)
+                result.push_back(polyB);//A在B中，并集为B
+            else if (b_in_a)
+                result.push_back(polyA);//B在A中，并集为A
+            else {
+                //如果互不包含，并集是 A + B（两个分离区域）
+                result.push_back(polyA);
+                result.push_back(polyB);
+            }
+        }
+    }
+
+    if (stats) {
+        const auto end = Clock::now();
+        stats->intersectionCount = intersections.size();
+        stats->discoveryMs = std::chrono::duration<double, std::milli>(traversalBegin - discoveryBegin).count();
+        stats->traversalMs = std::chrono::duration<double, std::milli>(end - traversalBegin).count();
+        stats->allocationCount = memory.allocations;
+        stats->peakBytes = memory.peakBytes;
+    }
+    return result;
+}
+
+/**
+ * @brief 求两个多边形的交集，并在两者都是凸多边形时自动走线性时间路径
+ * @details 凸性检测本身是 O(n+m)，远小于通用算法建立扫描线的开销；
+ * 本工具生成的凸包直接作为输入时，Auto 模式总会命中快速路径。
+ * 是否走了快速路径记录在 stats->convexFastPath 中。
+ * @param engine Auto 自动选择；WeilerAtherton、Convex 强制使用指定算法，便于对比
+ * @complexity 凸输入 O(n+m)，否则同 booleanOpWeilerAtherton
+ */
+std::vector<Polygon> intersectPolygons(PointSpan polygonA, PointSpan polygonB, IntersectionEngine engine,
+                                       BooleanOpStats *stats)
+{
+    std::vector<Polygon> result;
+    const bool convex = engine != IntersectionEngine::WeilerAtherton && isConvexPolygon(polygonA) &&
+                        isConvexPolygon(polygonB);
+    if (!convex) {
+        if (engine != IntersectionEngine::Convex) {
+            return booleanOpWeilerAtherton(polygonA, polygonB, BooleanOpType::Intersection, stats);
+        }
+        if (stats) *stats = BooleanOpStats{};
+        return result;
+    }
+    Polygon region = intersectConvexPolygons(polygonA, polygonB, stats);
+    if (!region.empty()) result.push_back(std::move(region));
+    return result;
+}
+
+} // namespace Geometry
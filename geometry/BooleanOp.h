@@ -0,0 +1,50 @@
+#ifndef BOOLEANOP_H
+#define BOOLEANOP_H
+/*BooleanOp 提供多边形布尔运算（交集、并集）的纯函数实现*/
+#include "GeometryTypes.h"
+
+namespace Geometry {
+
+//布尔运算类型；Weiler–Atherton 只支持前两种，差集与异或由 booleanOpMartinez 提供
+enum class BooleanOpType { Intersection, Union, Difference, Xor };
+
+//为 Weiler-Atherton 算法定义的顶点节点结构体，两个多边形的结点连续存放在同一数组中，用下标互相链接
+struct VertexNode {
+    Point point;// 顶点坐标
+    bool is_intersection = false;// 是否为交点
+    int next = -1;// 同一多边形中下一个结点的下标（环形）
+    int neighbor = -1;//对应另一个链表中交点的下标（配对点）
+    bool is_entering = false;// 是否为进入交点（决定是否切换边界）
+    bool processed = false;// 是否已被处理（用于封闭轮廓循环标记）
+    double alpha = 0.0; // 插值位置（在原边段上的比例，用于排序）
+};
+
+//一次布尔运算的分阶段耗时，用于定位瓶颈
+struct BooleanOpStats {
+    std::size_t intersectionCount = 0; // 边界交点数 k
+    double discoveryMs = 0.0;          // 交点发现（扫描线）耗时
+    double traversalMs = 0.0;          // 建表、穿梭缝合与无交点情形的处理耗时
+    std::size_t allocationCount = 0;   // 运算内部容器的堆分配次数（不含返回结果）
+    std::size_t peakBytes = 0;         // 运算内部容器占用内存的峰值（字节）
+    bool convexFastPath = false;       // 是否走了凸多边形 O(n+m) 求交路径
+};
+
+//求交集时使用的引擎
+enum class IntersectionEngine {
+    Auto,           // 两个输入都是凸多边形时走 O(n+m) 路径，否则用 Weiler–Atherton
+    WeilerAtherton, // 总是使用通用的 Weiler–Atherton
+    Convex          // 总是使用凸多边形求交；输入不是凸多边形时返回空
+};
+
+// Weiler–Atherton 布尔运算，返回结果的所有轮廓（可能包含多个区域或孔洞）；opType 为差集或异或时返回空
+std::vector<Polygon> booleanOpWeilerAtherton(PointSpan polygonA, PointSpan polygonB, BooleanOpType opType,
+                                             BooleanOpStats *stats = nullptr);
+
+// 两个多边形求交集，按 engine 选择算法；返回结果的所有轮廓
+std::vector<Polygon> intersectPolygons(PointSpan polygonA, PointSpan polygonB,
+                                       IntersectionEngine engine = IntersectionEngine::Auto,
+                                       BooleanOpStats *stats = nullptr);
+
+} // namespace Geometry
+
+#endif // BOOLEANOP_H
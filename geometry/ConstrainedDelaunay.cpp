@@ -0,0 +1,1017 @@
+#include "ConstrainedDelaunay.h"
+#include "PolygonUtils.h"
+#include "Predicates.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <random>
+
+namespace Geometry {
+
+namespace {
+
+constexpr int kNone = -1;
+
+//把坐标量化到 16 位网格后求 Hilbert 曲线上的序号；按序号插入时相邻两点在空间上也相邻，点定位的行走路径很短
+std::uint32_t hilbertIndex(std::uint32_t x, std::uint32_t y)
+{
+    const std::uint32_t n = 1u << 16;
+    std::uint32_t d = 0;
+    for (std::uint32_t s = n / 2; s > 0; s /= 2) {
+        const std::uint32_t rx = (x & s) ? 1 : 0;
+        const std::uint32_t ry = (y & s) ? 1 : 0;
+        d += s * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+/**
+ * @brief 插入顺序：BRIO（偏置随机插入顺序）
+ * @details 先用固定种子随机打乱，再把序列从后往前按 1/8、1/64…切成若干轮（最后一轮占 7/8），每轮内部按 Hilbert 序号排序。
+ * 纯 Hilbert 序在成行、共线的输入上会先插入一长串共线点，之后每个点都落进超级三角形边上那些巨大的外接圆里，
+ * 退化为 O(n²) 次翻转；分轮后每一轮的点都大致均匀地铺满整个区域，而轮内的 Hilbert 序仍让行走路径很短。
+ */
+std::vector<int> insertionOrder(const std::vector<Point> &pts)
+{
+    Point lo = pts[0], hi = pts[0];
+    for (const Point &p : pts) {
+        lo = {std::min(lo.x, p.x), std::min(lo.y, p.y)};
+        hi = {std::max(hi.x, p.x), std::max(hi.y, p.y)};
+    }
+    const double extent = std::max(hi.x - lo.x, hi.y - lo.y);
+    const double scale = extent > 0 ? 65535.0 / extent : 0.0;
+    std::vector<std::pair<std::uint32_t, int>> keyed(pts.size());
+    for (std::size_t i = 0; i < pts.size(); ++i) {
+        const auto qx = static_cast<std::uint32_t>((pts[i].x - lo.x) * scale);
+        const auto qy = static_cast<std::uint32_t>((pts[i].y - lo.y) * scale);
+        keyed[i] = {hilbertIndex(qx, qy), static_cast<int>(i)};
+    }
+    std::mt19937 rng(0x9E3779B9u); //固定种子，结果可复现
+    std::shuffle(keyed.begin(), keyed.end(), rng);
+    for (std::size_t end = keyed.size(); end > 0;) {
+        const std::size_t begin = end > 64 ? end / 8 : 0;
+        std::sort(keyed.begin() + begin, keyed.begin() + end);
+        end = begin;
+    }
+    std::vector<int> order(pts.size());
+    for (std::size_t i = 0; i < keyed.size(); ++i) order[i] = keyed[i].second;
+    return order;
+}
+
+//三角形：顶点逆时针排列，n[i] 与 fixed[i] 描述顶点 v[i] 的对边
+struct CdtTriangle {
+    int v[3];
+    int n[3];
+    bool fixed[3];
+};
+
+inline int next3(int i) { return i == 2 ? 0 : i + 1; }
+inline int prev3(int i) { return i == 0 ? 2 : i - 1; }
+
+/**
+ * @brief 基于三角形邻接表的增量式约束 Delaunay 构造器
+ * @details 所有点落在一个足够大的“超级三角形”内，最后三个顶点即超级三角形的顶点。
+ * 插入点时沿三角形邻接关系“行走”定位，分裂后用 Lawson 翻转恢复 Delaunay 性质；
+ * 插入约束边时先收集被它穿过的边，再按 Sloan 的方法反复翻转直到约束边出现，最后只对新边做 Delaunay 检查。
+ */
+class CdtBuilder {
+public:
+    explicit CdtBuilder(std::vector<Point> points) : pts(std::move(points))
+    {
+        Point lo = pts[0], hi = pts[0];
+        for (const Point &p : pts) {
+            lo = {std::min(lo.x, p.x), std::min(lo.y, p.y)};
+            hi = {std::max(hi.x, p.x), std::max(hi.y, p.y)};
+        }
+        const double size = std::max({hi.x - lo.x, hi.y - lo.y, 1.0});
+        const Point c{(lo.x + hi.x) / 2, (lo.y + hi.y) / 2};
+        superFirst = static_cast<int>(pts.size());
+        pts.push_back({c.x - 100 * size, c.y - 100 * size});
+        pts.push_back({c.x + 100 * size, c.y - 100 * size});
+        pts.push_back({c.x, c.y + 100 * size});
+        tris.push_back({{superFirst, superFirst + 1, superFirst + 2}, {kNone, kNone, kNone}, {false, false, false}});
+        vertexTri.assign(pts.size(), kNone);
+        for (int k = 0; k < 3; ++k) vertexTri[superFirst + k] = 0;
+    }
+
+    bool isSuper(int v) const { return v >= superFirst; }
+
+    /**
+     * @brief 插入顶点 vi
+     * @return 实际使用的顶点下标：与已有顶点重合时返回那个顶点
+     */
+    int insertVertex(int vi)
+    {
+        const Point &p = pts[vi];
+        int t = locate(p);
+        const CdtTriangle &tri = tris[t];
+        int zeroEdge = kNone, zeros = 0;
+        for (int i = 0; i < 3; ++i) {
+            if (pts[tri.v[i]] == p) return tri.v[i];
+            if (orient2dAdaptive(pts[tri.v[next3(i)]], pts[tri.v[prev3(i)]], p) == 0) {
+                zeroEdge = i;
+                ++zeros;
+            }
+        }
+        if (zeros == 1) splitEdge(t, zeroEdge, vi);
+        else splitTriangle(t, vi);
+        return vi;
+    }
+
+    /**
+     * @brief 插入约束边 a-b
+     * @details 途经的顶点恰好落在线段上时把约束拆成两段；被穿过的边若已是约束边（两条约束相交）则失败。
+     */
+    bool insertConstraint(int a, int b)
+    {
+        while (a != b) {
+            int t = kNone, i = kNone;
+            if (findEdge(a, b, t, i)) {
+                markFixed(t, i);
+                return true;
+            }
+
+            //绕 a 旋转，找到 a→b 方向所在的三角形
+            std::deque<EdgeHandle> crossed; //被穿过的边（所在三角形，左端点，右端点）
+            int stop = kNone;
+            if (!firstCrossing(a, b, t, crossed, stop)) return false;
+
+            //沿线段行走，收集被穿过的边，直到到达 b 或遇到恰好在线段上的顶点
+            if (stop == kNone) {
+                while (true) {
+                    const int left = crossed.back().x, right = crossed.back().y;
+                    const int u = tris[t].n[edgeIndex(t, left, right)];
+                    if (u == kNone) return false;
+                    const int w = thirdVertex(u, left, right);
+                    t = u;
+                    if (w == b) {
+                        stop = b;
+                        break;
+                    }
+                    const double side = orient2dAdaptive(pts[a], pts[b], pts[w]);
+                    if (side == 0) {
+                        stop = w;
+                        break;
+                    }
+                    const EdgeHandle edge = side > 0 ? EdgeHandle{t, w, right} : EdgeHandle{t, left, w};
+                    if (tris[t].fixed[edgeIndex(t, edge.x, edge.y)]) return false;
+                    crossed.push_back(edge);
+                }
+            }
+            if (!removeCrossings(a, stop, crossed)) return false;
+            a = stop;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 对真实顶点之间的所有非约束边做一遍 Lawson 翻转
+     * @details 超级三角形的顶点坐标很大，涉及它们的内切圆测试舍入误差也大，插入过程中可能留下少数非 Delaunay 的边；
+     * 约束全部插入后再检查一遍两侧都不含超级顶点的边即可修正。正常情况下只有极少数边需要翻转，代价是每条边一次内切圆测试。
+     */
+    void legalizeAll()
+    {
+        auto real = [&](int t) {
+            return t != kNone && !isSuper(tris[t].v[0]) && !isSuper(tris[t].v[1]) && !isSuper(tris[t].v[2]);
+        };
+        std::vector<EdgeHandle> stack;
+        for (std::size_t t = 0; t < tris.size(); ++t) {
+            const int ti = static_cast<int>(t);
+            if (!real(ti)) continue;
+            for (int i = 0; i < 3; ++i) {
+                if (tris[t].n[i] > ti) stack.push_back({ti, tris[t].v[next3(i)], tris[t].v[prev3(i)]});
+            }
+        }
+        std::size_t budget = 4 * stack.size() + 64; //舍入误差可能导致来回翻转，设上限
+        while (!stack.empty() && budget > 0) {
+            const EdgeHandle edge = stack.back();
+            stack.pop_back();
+            int t = kNone, i = kNone;
+            if (!resolve(edge, t, i) || !real(t) || !real(tris[t].n[i]) || !needsFlip(t, i)) continue;
+            const int u = flip(t, i);
+            --budget;
+            //翻转后 t = (p, a, q)、u = (p, q, b)，四边形的四条外边需要重新检查
+            stack.push_back({t, tris[t].v[0], tris[t].v[1]});
+            stack.push_back({t, tris[t].v[1], tris[t].v[2]});
+            stack.push_back({u, tris[u].v[1], tris[u].v[2]});
+            stack.push_back({u, tris[u].v[2], tris[u].v[0]});
+        }
+    }
+
+    /**
+     * @brief 区分区域内外：从超级三角形出发泛洪，每穿过一条约束边深度加一，深度为奇数的三角形位于区域内
+     */
+    std::vector<std::array<int, 3>> interiorTriangles() const
+    {
+        std::vector<int> depth(tris.size(), -1);
+        std::vector<int> current{vertexTri[superFirst]}, next, stack;
+        depth[current[0]] = 0;
+        std::vector<std::array<int, 3>> result;
+        for (int d = 0; !current.empty(); ++d) {
+            next.clear();
+            stack = current;
+            while (!stack.empty()) {
+                const int t = stack.back();
+                stack.pop_back();
+                if (d % 2 == 1) result.push_back({tris[t].v[0], tris[t].v[1], tris[t].v[2]});
+                for (int i = 0; i < 3; ++i) {
+                    const int u = tris[t].n[i];
+                    if (u == kNone || depth[u] >= 0) continue;
+                    if (tris[t].fixed[i]) {
+                        next.push_back(u);
+                        continue;
+                    }
+                    depth[u] = d;
+                    stack.push_back(u);
+                }
+            }
+            current.clear();
+            for (int u : next) {
+                if (depth[u] >= 0) continue;
+                depth[u] = d + 1;
+                current.push_back(u);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief 从 seeds 出发泛洪，不穿过约束边，返回经过的三角形
+     * @param neighbors [out] 可选，每个结果三角形各顶点对边的邻居在结果中的下标，约束边另一侧记为 -1
+     */
+    std::vector<std::array<int, 3>> floodRegion(const std::vector<int> &seeds,
+                                                std::vector<std::array<int, 3>> *neighbors) const
+    {
+        std::vector<int> outIndex(tris.size(), kNone);
+        std::vector<int> order, stack;
+        for (int t : seeds) {
+            if (t == kNone || outIndex[t] != kNone) continue;
+            outIndex[t] = static_cast<int>(order.size());
+            order.push_back(t);
+            stack.push_back(t);
+        }
+        while (!stack.empty()) {
+            const int t = stack.back();
+            stack.pop_back();
+            for (int i = 0; i < 3; ++i) {
+                const int u = tris[t].n[i];
+                if (u == kNone || tris[t].fixed[i] || outIndex[u] != kNone) continue;
+                outIndex[u] = static_cast<int>(order.size());
+                order.push_back(u);
+                stack.push_back(u);
+            }
+        }
+        std::vector<std::array<int, 3>> result;
+        result.reserve(order.size());
+        if (neighbors) neighbors->reserve(order.size());
+        for (int t : order) {
+            const CdtTriangle &tri = tris[t];
+            result.push_back({tri.v[0], tri.v[1], tri.v[2]});
+            if (!neighbors) continue;
+            std::array<int, 3> nb;
+            for (int i = 0; i < 3; ++i) nb[i] = (tri.fixed[i] || tri.n[i] == kNone) ? kNone : outIndex[tri.n[i]];
+            neighbors->push_back(nb);
+        }
+        return result;
+    }
+
+    //有向边 a→b 左侧（按逆时针方向包含 a→b）的三角形，边不存在时返回 -1
+    int leftTriangle(int a, int b) const
+    {
+        int t = kNone, i = kNone;
+        if (!findEdge(a, b, t, i)) return kNone;
+        return tris[t].v[next3(i)] == a ? t : tris[t].n[i];
+    }
+
+    //任意一个不含超级顶点的三角形；约束边围成凸包时它必在凸包内
+    int firstRealTriangle() const
+    {
+        for (std::size_t t = 0; t < tris.size(); ++t) {
+            const CdtTriangle &tri = tris[t];
+            if (!isSuper(tri.v[0]) && !isSuper(tri.v[1]) && !isSuper(tri.v[2])) return static_cast<int>(t);
+        }
+        return kNone;
+    }
+
+    std::vector<Point> pts;
+    std::size_t flips = 0;
+
+private:
+    std::vector<CdtTriangle> tris;
+    std::vector<int> vertexTri; //每个顶点所在的某个三角形
+    int superFirst = 0;
+    int lastTri = 0;
+
+    double orient(int a, int b, int c) const { return orient2dAdaptive(pts[a], pts[b], pts[c]); }
+
+    int indexOf(int t, int v) const
+    {
+        const CdtTriangle &tri = tris[t];
+        return tri.v[0] == v ? 0 : tri.v[1] == v ? 1 : 2;
+    }
+
+    //边 {a, b} 所对顶点在三角形 t 中的下标
+    int edgeIndex(int t, int a, int b) const
+    {
+        for (int i = 0; i < 3; ++i) {
+            const int x = tris[t].v[next3(i)], y = tris[t].v[prev3(i)];
+            if ((x == a && y == b) || (x == b && y == a)) return i;
+        }
+        return kNone;
+    }
+
+    int thirdVertex(int t, int a, int b) const
+    {
+        for (int v : tris[t].v) {
+            if (v != a && v != b) return v;
+        }
+        return kNone;
+    }
+
+    void replaceNeighbor(int t, int from, int to)
+    {
+        if (t == kNone) return;
+        for (int &n : tris[t].n) {
+            if (n == from) {
+                n = to;
+                return;
+            }
+        }
+    }
+
+    void setTriangle(int t, int a, int b, int c, int na, int nb, int nc, bool fa, bool fb, bool fc)
+    {
+        tris[t] = {{a, b, c}, {na, nb, nc}, {fa, fb, fc}};
+        vertexTri[a] = vertexTri[b] = vertexTri[c] = t;
+    }
+
+    void markFixed(int t, int i)
+    {
+        tris[t].fixed[i] = true;
+        const int u = tris[t].n[i];
+        if (u != kNone) tris[u].fixed[edgeIndex(u, tris[t].v[next3(i)], tris[t].v[prev3(i)])] = true;
+    }
+
+    //从上一次插入的位置出发行走定位；每一步从轮换的起始边开始检查，避免在退化情形下来回打转
+    int locate(const Point &p)
+    {
+        int t = lastTri;
+        const std::size_t limit = tris.size() + 3;
+        for (std::size_t step = 0; step < limit; ++step) {
+            const CdtTriangle &tri = tris[t];
+            int next = kNone;
+            for (int k = 0; k < 3; ++k) {
+                const int i = static_cast<int>((step + k) % 3);
+                if (orient2dAdaptive(pts[tri.v[next3(i)]], pts[tri.v[prev3(i)]], p) < 0) {
+                    next = tri.n[i];
+                    break;
+                }
+            }
+            if (next == kNone) return t;
+            t = next;
+        }
+        //行走失败时退回线性扫描
+        for (std::size_t k = 0; k < tris.size(); ++k) {
+            const CdtTriangle &tri = tris[k];
+            if (orient(tri.v[0], tri.v[1], tri.v[2]) > 0 && orient2dAdaptive(pts[tri.v[0]], pts[tri.v[1]], p) >= 0 &&
+                orient2dAdaptive(pts[tri.v[1]], pts[tri.v[2]], p) >= 0 && orient2dAdaptive(pts[tri.v[2]], pts[tri.v[0]], p) >= 0) {
+                return static_cast<int>(k);
+            }
+        }
+        return t;
+    }
+
+    //点 p 严格位于三角形 t 内部：一分为三
+    void splitTriangle(int t, int p)
+    {
+        const CdtTriangle old = tris[t];
+        const int a = old.v[0], b = old.v[1], c = old.v[2];
+        const int t1 = static_cast<int>(tris.size()), t2 = t1 + 1;
+        tris.resize(tris.size() + 2);
+        setTriangle(t, p, a, b, old.n[2], t1, t2, old.fixed[2], false, false);
+        setTriangle(t1, p, b, c, old.n[0], t2, t, old.fixed[0], false, false);
+        setTriangle(t2, p, c, a, old.n[1], t, t1, old.fixed[1], false, false);
+        replaceNeighbor(old.n[0], t, t1);
+        replaceNeighbor(old.n[1], t, t2);
+        legalize({t, t1, t2});
+    }
+
+    //点 p 落在三角形 t 中顶点 v[e] 的对边上：边两侧的两个三角形各一分为二
+    void splitEdge(int t, int e, int p)
+    {
+        const CdtTriangle tt = tris[t];
+        const int c = tt.v[e], a = tt.v[next3(e)], b = tt.v[prev3(e)];
+        const int u = tt.n[e];
+        const bool f = tt.fixed[e];
+        const int t1 = static_cast<int>(tris.size());
+        if (u == kNone) {
+            tris.resize(tris.size() + 1);
+            setTriangle(t, p, b, c, tt.n[next3(e)], t1, kNone, tt.fixed[next3(e)], false, f);
+            setTriangle(t1, p, c, a, tt.n[prev3(e)], kNone, t, tt.fixed[prev3(e)], f, false);
+            replaceNeighbor(tt.n[prev3(e)], t, t1);
+            legalize({t, t1});
+            return;
+        }
+        const CdtTriangle uu = tris[u];
+        const int j = indexOf(u, thirdVertex(u, a, b));
+        const int d = uu.v[j];
+        //u = (d, b, a)：a 的对边 (d, b)，b 的对边 (a, d)
+        const int ia = indexOf(u, a), ib = indexOf(u, b);
+        const int t3 = t1 + 1;
+        tris.resize(tris.size() + 2);
+        setTriangle(t, p, b, c, tt.n[next3(e)], t1, t3, tt.fixed[next3(e)], false, f);
+        setTriangle(t1, p, c, a, tt.n[prev3(e)], u, t, tt.fixed[prev3(e)], f, false);
+        setTriangle(u, p, a, d, uu.n[ib], t3, t1, uu.fixed[ib], false, f);
+        setTriangle(t3, p, d, b, uu.n[ia], t, u, uu.fixed[ia], f, false);
+        replaceNeighbor(tt.n[prev3(e)], t, t1);
+        replaceNeighbor(uu.n[ia], u, t3);
+        legalize({t, t1, u, t3});
+    }
+
+    //翻转三角形 t 中 v[i] 的对边；翻转后 t 与返回的邻居都以原来的 v[i] 作为 0 号顶点
+    int flip(int t, int i)
+    {
+        const CdtTriangle tt = tris[t];
+        const int p = tt.v[i], a = tt.v[next3(i)], b = tt.v[prev3(i)];
+        const int u = tt.n[i];
+        const CdtTriangle uu = tris[u];
+        const int j = indexOf(u, thirdVertex(u, a, b));
+        const int q = uu.v[j];
+        const int ia = indexOf(u, a), ib = indexOf(u, b);
+        //t 中 a 的对边 (b, p)、b 的对边 (p, a)；u 中 a 的对边 (q, b)、b 的对边 (a, q)
+        setTriangle(t, p, a, q, uu.n[ib], u, tt.n[prev3(i)], uu.fixed[ib], false, tt.fixed[prev3(i)]);
+        setTriangle(u, p, q, b, uu.n[ia], tt.n[next3(i)], t, uu.fixed[ia], tt.fixed[next3(i)], false);
+        replaceNeighbor(uu.n[ib], u, t);
+        replaceNeighbor(tt.n[next3(i)], t, u);
+        ++flips;
+        return u;
+    }
+
+    //四边形 p-a-q-b 是否严格凸（只有凸四边形的对角线才能翻转）
+    bool flippable(int t, int i) const
+    {
+        const int u = tris[t].n[i];
+        if (u == kNone) return false;
+        const int p = tris[t].v[i], a = tris[t].v[next3(i)], b = tris[t].v[prev3(i)];
+        const int q = thirdVertex(u, a, b);
+        return orient(p, a, q) > 0 && orient(p, q, b) > 0;
+    }
+
+    bool needsFlip(int t, int i) const
+    {
+        const CdtTriangle &tri = tris[t];
+        if (tri.fixed[i] || tri.n[i] == kNone) return false;
+        const int q = thirdVertex(tri.n[i], tri.v[next3(i)], tri.v[prev3(i)]);
+        return inCircleAdaptive(pts[tri.v[0]], pts[tri.v[1]], pts[tri.v[2]], pts[q]) > 0 && flippable(t, i);
+    }
+
+    //新点总在各三角形的 0 号位置，只需检查它的对边
+    void legalize(std::vector<int> stack)
+    {
+        lastTri = stack.front();
+        while (!stack.empty()) {
+            const int t = stack.back();
+            stack.pop_back();
+            if (!needsFlip(t, 0)) continue;
+            const int u = flip(t, 0);
+            stack.push_back(t);
+            stack.push_back(u);
+        }
+    }
+
+    //边 x-y 及记录它时所在的三角形；之后的翻转可能把边移到相邻三角形中，或者把它翻掉
+    struct EdgeHandle {
+        int t, x, y;
+    };
+
+    //按句柄找回边：先查记录的三角形及其邻居（翻转只会把边移到翻转的另一半中），都不在时才绕顶点查找。
+    //约束的端点常常连着一大片扇形，所以绕两个端点轮流查找、每轮放宽步数，代价取决于度数较小的端点
+    bool resolve(const EdgeHandle &edge, int &t, int &i) const
+    {
+        if ((i = edgeIndex(edge.t, edge.x, edge.y)) != kNone) {
+            t = edge.t;
+            return true;
+        }
+        for (const int u : tris[edge.t].n) {
+            if (u != kNone && (i = edgeIndex(u, edge.x, edge.y)) != kNone) {
+                t = u;
+                return true;
+            }
+        }
+        for (std::size_t limit = 16;; limit *= 4) {
+            bool doneX = false, doneY = false;
+            if (findEdge(edge.x, edge.y, t, i, limit, doneX) || findEdge(edge.y, edge.x, t, i, limit, doneY)) return true;
+            if (doneX || doneY) return false;
+        }
+    }
+
+    //在 a 周围的三角形中查找边 a-b，找到时返回三角形及 b 之外那个顶点的下标；
+    //先顺时针旋转，碰到超级三角形的外边界（只有超级顶点会遇到）再从起点逆时针旋转
+    bool findEdge(int a, int b, int &t, int &i) const
+    {
+        bool exhausted = false;
+        return findEdge(a, b, t, i, std::numeric_limits<std::size_t>::max(), exhausted);
+    }
+
+    //同上，但最多检查 limit 个三角形；返回 false 时 exhausted 表示 a 周围已经查完，即边不存在
+    bool findEdge(int a, int b, int &t, int &i, std::size_t limit, bool &exhausted) const
+    {
+        exhausted = false;
+        const int start = vertexTri[a];
+        for (int pass = 0; pass < 2; ++pass) {
+            int cur = start;
+            do {
+                if (limit-- == 0) return false;
+                const int k = indexOf(cur, a);
+                if (tris[cur].v[next3(k)] == b) {
+                    t = cur;
+                    i = prev3(k);
+                    return true;
+                }
+                if (tris[cur].v[prev3(k)] == b) {
+                    t = cur;
+                    i = next3(k);
+                    return true;
+                }
+                cur = tris[cur].n[pass == 0 ? prev3(k) : next3(k)];
+            } while (cur != kNone && cur != start);
+            if (cur == start) break;
+        }
+        exhausted = true;
+        return false;
+    }
+
+    /**
+     * @brief 找到 a 周围包含 a→b 方向的三角形
+     * @param t [out] 该三角形
+     * @param crossed [out] 方向严格落在三角形内部时写入第一条被穿过的边
+     * @param stop [out] 方向恰好经过 a 的某个邻接顶点时写入该顶点（该段约束已是现有的边）
+     */
+    bool firstCrossing(int a, int b, int &t, std::deque<EdgeHandle> &crossed, int &stop)
+    {
+        const int start = vertexTri[a];
+        int cur = start;
+        do {
+            const int k = indexOf(cur, a);
+            const int l = tris[cur].v[next3(k)], r = tris[cur].v[prev3(k)];
+            const double ol = orient(a, b, l), orr = orient(a, b, r);
+            const Point dir = pts[b] - pts[a];
+            for (const int w : {l, r}) {
+                const Point dw = pts[w] - pts[a];
+                if ((w == l ? ol : orr) == 0 && dir.x * dw.x + dir.y * dw.y > 0) {
+                    //邻接顶点恰好落在线段上：先固定 a-w，再从 w 继续
+                    markFixed(cur, w == l ? prev3(k) : next3(k));
+                    stop = w;
+                    return true;
+                }
+            }
+            if (ol < 0 && orr > 0) {
+                if (tris[cur].fixed[k]) return false;
+                t = cur;
+                crossed.push_back({cur, r, l});
+                return true;
+            }
+            cur = tris[cur].n[prev3(k)];
+        } while (cur != kNone && cur != start);
+        return false;
+    }
+
+    /**
+     * @brief Sloan 的边翻转法：反复翻转与约束线段 a-b 相交的边，直到没有相交的边，再对新边恢复 Delaunay 性质
+     * @param crossed 被穿过的边；为空表示 a-b 已是现有的边（由 firstCrossing 处理）
+     */
+    bool removeCrossings(int a, int b, std::deque<EdgeHandle> &crossed)
+    {
+        if (crossed.empty()) return true;
+        std::vector<EdgeHandle> created;
+        std::size_t budget = 16 * (crossed.size() + 1) * (crossed.size() + 1) + 64;
+        while (!crossed.empty()) {
+            if (budget-- == 0) return false;
+            const EdgeHandle edge = crossed.front();
+            crossed.pop_front();
+            int t = kNone, i = kNone;
+            if (!resolve(edge, t, i)) return false;
+            if (!flippable(t, i)) {
+                crossed.push_back({t, edge.x, edge.y});
+                continue;
+            }
+            flip(t, i);
+            const int p = tris[t].v[0], q = tris[t].v[2];
+            const double sp = orient(a, b, p), sq = orient(a, b, q);
+            if ((sp > 0 && sq < 0) || (sp < 0 && sq > 0)) crossed.push_back({t, p, q});
+            else created.push_back({t, p, q});
+        }
+
+        int t = kNone, i = kNone;
+        if (!findEdge(a, b, t, i)) return false;
+        markFixed(t, i);
+
+        //只有新产生的边可能违反 Delaunay 性质：与 legalizeAll 一样用栈做 Lawson 翻转，每次翻转后检查四边形的四条外边
+        budget = 4 * created.size() + 64; //舍入误差可能导致来回翻转，设上限
+        while (!created.empty() && budget > 0) {
+            const EdgeHandle edge = created.back();
+            created.pop_back();
+            if (!resolve(edge, t, i) || !needsFlip(t, i)) continue;
+            const int u = flip(t, i);
+            --budget;
+            //翻转后 t = (p, a, q)、u = (p, q, b)
+            created.push_back({t, tris[t].v[0], tris[t].v[1]});
+            created.push_back({t, tris[t].v[1], tris[t].v[2]});
+            created.push_back({u, tris[u].v[1], tris[u].v[2]});
+            created.push_back({u, tris[u].v[2], tris[u].v[0]});
+        }
+        lastTri = vertexTri[a];
+        return true;
+    }
+};
+
+bool lexLess(const Point &a, const Point &b) { return a.x < b.x || (a.x == b.x && a.y < b.y); }
+
+//单调链求凸包（逆时针，不含共线点）；pts 已按 (x, y) 排序且互不重复，返回顶点下标
+std::vector<int> sortedHull(const std::vector<Point> &pts)
+{
+    const int n = static_cast<int>(pts.size());
+    if (n < 3) return {};
+    std::vector<int> hull(2 * n);
+    int k = 0;
+    for (int i = 0; i < n; ++i) {
+        while (k >= 2 && orient2dAdaptive(pts[hull[k - 2]], pts[hull[k - 1]], pts[i]) <= 0) --k;
+        hull[k++] = i;
+    }
+    for (int i = n - 2, lower = k + 1; i >= 0; --i) {
+        while (k >= lower && orient2dAdaptive(pts[hull[k - 2]], pts[hull[k - 1]], pts[i]) <= 0) --k;
+        hull[k++] = i;
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+//一块点集的 Delaunay 剖分结果（三角形使用全局下标）
+struct DelaunayPiece {
+    std::vector<std::array<int, 3>> triangles;
+    std::vector<std::array<int, 3>> neighbors; // 各顶点对边的邻居，凸包边或约束边另一侧为 -1
+    std::size_t flips = 0;
+    std::size_t constraints = 0;
+    bool ok = false;
+};
+
+/**
+ * @brief 对 ids 所指的点做 Delaunay 剖分
+ * @param ids 按 (x, y) 排序且互不重复的全局下标，排好序后可以线性时间求凸包
+ * @param frontier 已确定区域的边界（有向边，已确定的一侧在左边）；非空时它们作为约束插入，
+ * 只返回从这些边的右侧泛洪到的三角形；为空时返回整个凸包内的三角形
+ */
+DelaunayPiece triangulateSorted(PointSpan input, const std::vector<int> &ids,
+                                const std::vector<std::pair<int, int>> &frontier)
+{
+    DelaunayPiece piece;
+    std::vector<Point> pts(ids.size());
+    for (std::size_t k = 0; k < ids.size(); ++k) pts[k] = input[ids[k]];
+    const std::vector<int> hull = sortedHull(pts);
+    if (hull.size() < 3) return piece;
+
+    CdtBuilder builder(pts);
+    for (int i : insertionOrder(pts)) builder.insertVertex(i);
+    for (std::size_t k = 0; k < hull.size(); ++k) {
+        if (!builder.insertConstraint(hull[k], hull[(k + 1) % hull.size()])) return piece;
+    }
+    std::vector<int> seeds;
+    auto localIndex = [&](int id) {
+        return static_cast<int>(std::lower_bound(pts.begin(), pts.end(), input[id], lexLess) - pts.begin());
+    };
+    for (const auto &edge : frontier) {
+        if (!builder.insertConstraint(localIndex(edge.first), localIndex(edge.second))) return piece;
+    }
+    builder.legalizeAll();
+    //后续约束的翻转会改写三角形，种子必须在全部约束插入之后再取
+    for (const auto &edge : frontier) seeds.push_back(builder.leftTriangle(localIndex(edge.second), localIndex(edge.first)));
+    if (frontier.empty()) seeds.push_back(builder.firstRealTriangle());
+
+    piece.triangles = builder.floodRegion(seeds, &piece.neighbors);
+    for (auto &tri : piece.triangles) {
+        for (int &v : tri) v = ids[v];
+    }
+    piece.flips = builder.flips;
+    piece.constraints = hull.size() + frontier.size();
+    piece.ok = !piece.triangles.empty();
+    return piece;
+}
+
+/**
+ * @brief 三角形的外接圆是否严格落在竖直带 (xlo, xhi) 内
+ * @details 外接圆心按相对坐标计算；留出与舍入误差同量级的余量，拿不准时返回 false（只会让更多三角形进入合并区，不影响正确性）。
+ */
+bool circleInsideStrip(const Point &a, const Point &b, const Point &c, double xlo, double xhi)
+{
+    const double bx = b.x - a.x, by = b.y - a.y, cx = c.x - a.x, cy = c.y - a.y;
+    const double d = 2 * (bx * cy - by * cx);
+    if (d <= 0) return false;
+    const double b2 = bx * bx + by * by, c2 = cx * cx + cy * cy;
+    const double ux = (cy * b2 - by * c2) / d, uy = (bx * c2 - cx * b2) / d;
+    const double r = std::sqrt(ux * ux + uy * uy);
+    const double m = std::max(b2, c2);
+    const double margin = 1e-12 * (m * std::sqrt(m) / d + std::fabs(a.x) + r);
+    const double centre = a.x + ux;
+    return centre - r - margin > xlo && centre + r + margin < xhi;
+}
+
+/**
+ * @brief 对若干个环（第一个为外边界）做约束 Delaunay 三角剖分，是两个公开重载的共同实现
+ */
+std::optional<TriangleMesh> constrainedDelaunayRings(const std::vector<PointSpan> &rings, PointSpan interiorPoints,
+                                                     CdtStats *stats)
+{
+    const auto begin = std::chrono::steady_clock::now();
+
+    //各环顶点：去掉相邻重复点与首尾重复点，ringEnd 记录每个环的结束位置；第一个环（外边界）不足 3 个顶点时失败，其余的忽略
+    std::vector<Point> pts;
+    std::size_t total = interiorPoints.size();
+    for (const PointSpan &ring : rings) total += ring.size();
+    pts.reserve(total);
+    std::vector<std::size_t> ringEnd;
+    for (const PointSpan &ring : rings) {
+        const std::size_t first = pts.size();
+        for (const Point &p : ring) {
+            if (pts.size() == first || pts.back() != p) pts.push_back(p);
+        }
+        while (pts.size() > first + 1 && pts.back() == pts[first]) pts.pop_back();
+        if (pts.size() - first < 3) {
+            if (ringEnd.empty()) return std::nullopt;
+            pts.resize(first);
+            continue;
+        }
+        ringEnd.push_back(pts.size());
+    }
+    if (ringEnd.empty()) return std::nullopt;
+    pts.insert(pts.end(), interiorPoints.begin(), interiorPoints.end());
+    const std::size_t n = pts.size();
+
+    //按 BRIO 顺序插入
+    CdtBuilder builder(pts);
+    std::vector<int> alias(n); //重复点映射到先插入的那个顶点
+    for (int i : insertionOrder(pts)) alias[i] = builder.insertVertex(i);
+
+    //插入约束边
+    std::size_t constraints = 0;
+    std::size_t first = 0;
+    for (std::size_t last : ringEnd) {
+        for (std::size_t i = first; i < last; ++i) {
+            const int a = alias[i], b = alias[i + 1 < last ? i + 1 : first];
+            if (a == b) continue;
+            if (!builder.insertConstraint(a, b)) return std::nullopt;
+            ++constraints;
+        }
+        first = last;
+    }
+    builder.legalizeAll();
+
+    //只保留区域内的三角形，并把用到的顶点重新编号（各环顶点在前，内部点在后，保持输入顺序）
+    TriangleMesh mesh;
+    mesh.triangles = builder.interiorTriangles();
+    if (mesh.triangles.empty()) return std::nullopt;
+    std::vector<int> remap(n, kNone);
+    for (const auto &tri : mesh.triangles) {
+        for (int v : tri) remap[v] = 0;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (remap[i] == kNone) continue;
+        remap[i] = static_cast<int>(mesh.vertices.size());
+        mesh.vertices.push_back(pts[i]);
+    }
+    for (auto &tri : mesh.triangles) {
+        for (int &v : tri) v = remap[v];
+    }
+
+    if (stats) {
+        stats->vertexCount = mesh.vertices.size();
+        stats->triangleCount = mesh.triangles.size();
+        stats->constraintCount = constraints;
+        stats->ignoredPointCount = n - mesh.vertices.size();
+        stats->flipCount = builder.flips;
+        stats->elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+    return mesh;
+}
+
+} // namespace
+
+/**
+ * @brief 约束 Delaunay 三角剖分（增量插入 + 约束边翻转恢复）
+ * @details
+ * 1. 多边形顶点与内部点一起按 BRIO 顺序（分轮随机、轮内 Hilbert 排序）逐点插入超级三角形：
+ *    行走定位所在三角形（或所在边），分裂后用 Lawson 翻转恢复 Delaunay 性质，重复点直接合并；
+ * 2. 依次插入多边形的每条边作为约束：收集被穿过的边，按 Sloan 的方法翻转直到约束边出现，
+ *    再只对新产生的边恢复 Delaunay 性质；
+ * 3. 从超级三角形开始泛洪，按穿过约束边的次数的奇偶性区分区域内外，只保留区域内的三角形。
+ * 与耳切法相比，结果在约束下使最小角最大化，没有不必要的狭长三角形。
+ * @note 谓词使用普通浮点运算；翻转前都检查四边形是否严格凸，保证即使谓词有舍入误差网格也不会翻折。
+ */
+std::optional<TriangleMesh> constrainedDelaunay(PointSpan polygon, PointSpan interiorPoints, CdtStats *stats)
+{
+    return constrainedDelaunayRings({polygon}, interiorPoints, stats);
+}
+
+/**
+ * @brief 带孔洞多边形的约束 Delaunay 三角剖分
+ * @details 外边界与所有孔洞的边都作为约束插入，泛洪时按穿过约束边次数的奇偶性自然挖去孔洞，
+ * 不需要桥边；其余步骤与单个多边形的版本相同。
+ * 奇偶泛洪只在环两两不交、孔洞互不嵌套时才等于“外边界减去孔洞”，因此先用 isSimplePolygonWithHoles 检查输入。
+ */
+std::optional<TriangleMesh> constrainedDelaunay(const PolygonWithHoles &polygon, PointSpan interiorPoints,
+                                                CdtStats *stats)
+{
+    if (!isSimplePolygonWithHoles(polygon)) return std::nullopt;
+    std::vector<PointSpan> rings;
+    rings.reserve(polygon.holes.size() + 1);
+    rings.push_back(polygon.outer);
+    for (const Polygon &hole : polygon.holes) rings.push_back(hole);
+    return constrainedDelaunayRings(rings, interiorPoints, stats);
+}
+
+/**
+ * @brief 多线程 Delaunay 三角剖分：条带并行剖分 + 接缝区合并
+ * @details
+ * 1. **分条带**：抽样取 T-1 个分割点，把点按字典序分到 T 个竖条，各线程并行排序、去重；
+ * 2. **并行剖分**：每个条带独立做 Delaunay 剖分（BRIO 顺序增量插入，条带凸包作约束）。
+ *    外接圆严格落在本条带 x 范围内的三角形不可能包含其他条带的点，因此就是全局结果的一部分，称为“确定三角形”；
+ *    贴着条带凸包的三角形与外接圆越过条带边界的三角形则留待合并；
+ * 3. **合并接缝**：收集所有未确定三角形的顶点，以全局凸包与“确定区域的边界边”为约束再剖分一次，
+ *    从边界边的另一侧泛洪取出接缝区的三角形，与确定三角形拼成完整结果。
+ * 均匀分布时接缝区只含 O(√n·T) 个点，主要开销（排序与逐点插入）被均分到 T 个线程上。
+ * 点数较少或接缝区过大（如点集退化成几条直线）时退化为单线程剖分，结果相同。
+ * @param threadCount 线程数（也是条带数），0 表示硬件并发数
+ * @note 返回网格的 vertices 就是输入点本身（下标与输入一致）；重复点只有第一次出现的那个被三角形引用。
+ */
+std::optional<TriangleMesh> delaunayTriangulationParallel(PointSpan points, unsigned threadCount, CdtStats *stats)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    const std::size_t n = points.size();
+    const std::size_t minPerThread = 1 << 14; // 每个条带至少分到的点数，少于此值时并行不划算
+    const unsigned T = static_cast<unsigned>(std::max<std::size_t>(
+        1, std::min<std::size_t>(ThreadPool::resolveThreadCount(threadCount), n / minPerThread)));
+
+    ThreadPool *pool = &ThreadPool::global();
+    std::unique_ptr<ThreadPool> ownPool;
+    if (T > pool->size()) {
+        ownPool = std::make_unique<ThreadPool>(T);
+        pool = ownPool.get();
+    }
+
+    // 1. 分条带：抽样取分割点，各线程把自己那一段点按条带分组，再按条带并行排序、去重
+    auto idLess = [&](int a, int b) {
+        return lexLess(points[a], points[b]) || (points[a] == points[b] && a < b);
+    };
+    std::vector<std::vector<int>> strips(T);
+    if (T == 1) {
+        strips[0].resize(n);
+        for (std::size_t i = 0; i < n; ++i) strips[0][i] = static_cast<int>(i);
+    } else {
+        const std::size_t sampleCount = std::min<std::size_t>(n, std::size_t(T) * 64);
+        std::vector<Point> sample(sampleCount);
+        for (std::size_t k = 0; k < sampleCount; ++k) sample[k] = points[k * (n / sampleCount)];
+        std::sort(sample.begin(), sample.end(), lexLess);
+        std::vector<Point> splitters(T - 1);
+        for (unsigned k = 0; k + 1 < T; ++k) splitters[k] = sample[(k + 1) * sampleCount / T];
+        std::vector<std::vector<std::vector<int>>> grouped(T, std::vector<std::vector<int>>(T));
+        pool->parallelFor(T, [&](std::size_t c) {
+            for (std::size_t i = c * n / T, end = (c + 1) * n / T; i < end; ++i) {
+                const auto b = std::upper_bound(splitters.begin(), splitters.end(), points[i], lexLess) - splitters.begin();
+                grouped[c][b].push_back(static_cast<int>(i));
+            }
+        });
+        pool->parallelFor(T, [&](std::size_t b) {
+            for (unsigned c = 0; c < T; ++c) strips[b].insert(strips[b].end(), grouped[c][b].begin(), grouped[c][b].end());
+        });
+    }
+    pool->parallelFor(T, [&](std::size_t b) {
+        std::vector<int> &ids = strips[b];
+        std::sort(ids.begin(), ids.end(), idLess);
+        ids.erase(std::unique(ids.begin(), ids.end(), [&](int a, int c) { return points[a] == points[c]; }), ids.end());
+    });
+    std::size_t distinct = 0;
+    for (const auto &ids : strips) distinct += ids.size();
+
+    std::vector<std::array<int, 3>> triangles;
+    std::size_t flips = 0, constraints = 0;
+    auto runSequential = [&]() {
+        std::vector<int> all;
+        all.reserve(distinct);
+        for (const auto &ids : strips) all.insert(all.end(), ids.begin(), ids.end());
+        DelaunayPiece piece = triangulateSorted(points, all, {});
+        triangles = std::move(piece.triangles);
+        flips += piece.flips;
+        constraints += piece.constraints;
+        return piece.ok;
+    };
+
+    bool ok = false;
+    if (T == 1) {
+        ok = runSequential();
+    } else {
+        // 2. 各条带并行剖分并挑出确定三角形
+        const double inf = std::numeric_limits<double>::infinity();
+        std::vector<double> xlo(T, -inf), xhi(T, inf);
+        for (unsigned b = 1; b < T; ++b) xlo[b] = strips[b - 1].empty() ? xlo[b - 1] : points[strips[b - 1].back()].x;
+        for (unsigned b = T - 1; b-- > 0;) xhi[b] = strips[b + 1].empty() ? xhi[b + 1] : points[strips[b + 1].front()].x;
+
+        struct StripResult {
+            std::vector<std::array<int, 3>> settled;
+            std::vector<std::pair<int, int>> frontier; // 确定区域的边界边，确定的一侧在左边
+            std::vector<int> seam;                     // 未确定三角形的顶点（可能重复）
+            std::size_t flips = 0, constraints = 0;
+        };
+        std::vector<StripResult> results(T);
+        pool->parallelFor(T, [&](std::size_t b) {
+            StripResult &out = results[b];
+            DelaunayPiece piece = triangulateSorted(points, strips[b], {});
+            out.flips = piece.flips;
+            out.constraints = piece.constraints;
+            if (!piece.ok) {
+                out.seam = strips[b];
+                return;
+            }
+            std::vector<char> settled(piece.triangles.size(), 0);
+            for (std::size_t t = 0; t < piece.triangles.size(); ++t) {
+                const auto &tri = piece.triangles[t];
+                const auto &nb = piece.neighbors[t];
+                settled[t] = nb[0] != kNone && nb[1] != kNone && nb[2] != kNone &&
+                             circleInsideStrip(points[tri[0]], points[tri[1]], points[tri[2]], xlo[b], xhi[b]);
+            }
+            for (std::size_t t = 0; t < piece.triangles.size(); ++t) {
+                const auto &tri = piece.triangles[t];
+                if (!settled[t]) {
+                    out.seam.insert(out.seam.end(), tri.begin(), tri.end());
+                    continue;
+                }
+                out.settled.push_back(tri);
+                for (int i = 0; i < 3; ++i) {
+                    if (!settled[piece.neighbors[t][i]]) out.frontier.emplace_back(tri[next3(i)], tri[prev3(i)]);
+                }
+            }
+        });
+
+        // 3. 接缝区：未确定三角形的顶点（保持字典序）以确定区域的边界为约束再剖分一次
+        std::vector<char> inSeam(n, 0);
+        std::vector<std::pair<int, int>> frontier;
+        for (const StripResult &r : results) {
+            for (int v : r.seam) inSeam[v] = 1;
+            frontier.insert(frontier.end(), r.frontier.begin(), r.frontier.end());
+            flips += r.flips;
+            constraints += r.constraints;
+        }
+        std::vector<int> seam;
+        for (const auto &ids : strips) {
+            for (int v : ids) {
+                if (inSeam[v]) seam.push_back(v);
+            }
+        }
+        if (seam.size() * 2 <= distinct) {
+            DelaunayPiece piece = triangulateSorted(points, seam, frontier);
+            if (piece.ok) {
+                for (StripResult &r : results) triangles.insert(triangles.end(), r.settled.begin(), r.settled.end());
+                triangles.insert(triangles.end(), piece.triangles.begin(), piece.triangles.end());
+                flips += piece.flips;
+                constraints += piece.constraints;
+                ok = true;
+            }
+        }
+        if (!ok) ok = runSequential();
+    }
+    if (!ok) return std::nullopt;
+
+    TriangleMesh mesh;
+    mesh.vertices.assign(points.begin(), points.end());
+    mesh.triangles = std::move(triangles);
+    if (stats) {
+        stats->vertexCount = distinct;
+        stats->triangleCount = mesh.triangles.size();
+        stats->constraintCount = constraints;
+        stats->ignoredPointCount = n - distinct;
+        stats->flipCount = flips;
+        stats->elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+    return mesh;
+}
+
+/**
+ * @brief 点集的 Delaunay 三角剖分（单线程）
+ * @details 点按字典序排序去重后线性时间求凸包，以凸包为约束、按 BRIO 顺序逐点插入。
+ */
+std::optional<TriangleMesh> delaunayTriangulation(PointSpan points, CdtStats *stats)
+{
+    return delaunayTriangulationParallel(points, 1, stats);
+}
+
+} // namespace Geometry
@@ -0,0 +1,50 @@
+#ifndef CONSTRAINEDDELAUNAY_H
+#define CONSTRAINEDDELAUNAY_H
+/*ConstrainedDelaunay 提供约束 Delaunay 三角剖分（CDT）：多边形的边作为约束，可附加内部点，输出带下标的三角网格*/
+#include "GeometryTypes.h"
+#include <optional>
+
+namespace Geometry {
+
+//一次约束 Delaunay 三角剖分的统计信息
+struct CdtStats {
+    std::size_t vertexCount = 0;       // 输出网格的顶点数
+    std::size_t triangleCount = 0;     // 输出三角形数
+    std::size_t constraintCount = 0;   // 插入的约束边数
+    std::size_t ignoredPointCount = 0; // 重复或落在区域外而被忽略的输入点数
+    std::size_t flipCount = 0;         // 边翻转次数（插入点时的 Lawson 翻转 + 恢复约束边时的翻转）
+    double elapsedMs = 0.0;            // 墙钟耗时（毫秒）
+};
+
+/**
+ * @brief 约束 Delaunay 三角剖分
+ * @param polygon 简单多边形的顶点（任意环绕方向），每条边都作为约束边出现在结果中
+ * @param interiorPoints 附加的内部点（Steiner 点），区域外的点被忽略
+ * @param stats [out] 可选的统计信息
+ * @return 网格顶点依次为多边形顶点（去除相邻重复点后）与被采用的内部点；约束边相交等退化情况返回 std::nullopt
+ * @complexity 期望 O(n log n)（BRIO 顺序：分轮随机、轮内按 Hilbert 曲线排序后逐点插入），恢复约束边的代价与被穿过的边数成正比
+ */
+std::optional<TriangleMesh> constrainedDelaunay(PointSpan polygon, PointSpan interiorPoints = {},
+                                                CdtStats *stats = nullptr);
+
+// 带孔洞的版本：外边界与孔洞的边都是约束边，孔洞内的三角形被挖去；网格顶点依次为外边界、各孔洞与被采用的内部点；
+// 环相交或接触、孔洞不在外边界内部或相互嵌套时返回 std::nullopt
+std::optional<TriangleMesh> constrainedDelaunay(const PolygonWithHoles &polygon, PointSpan interiorPoints = {},
+                                                CdtStats *stats = nullptr);
+
+/**
+ * @brief 点集的 Delaunay 三角剖分，覆盖整个凸包
+ * @details 以凸包边作为约束插入；凸包边总是 Delaunay 边，所以结果就是普通的 Delaunay 三角剖分。
+ * @return 网格顶点就是输入点（下标与输入一致，重复点只引用第一次出现的那个）；点数不足 3 或全部共线时返回 std::nullopt
+ * @complexity 期望 O(n log n)
+ */
+std::optional<TriangleMesh> delaunayTriangulation(PointSpan points, CdtStats *stats = nullptr);
+
+// 多线程版本：按 x 分条带并行剖分，再只对条带之间的接缝区重新剖分；threadCount 为 0 时使用全部核心，
+// 点数较少时自动退化为单线程，输出格式与 delaunayTriangulation 相同
+std::optional<TriangleMesh> delaunayTriangulationParallel(PointSpan points, unsigned threadCount = 0,
+                                                          CdtStats *stats = nullptr);
+
+} // namespace Geometry
+
+#endif // CONSTRAINEDDELAUNAY_H
@@ -0,0 +1,520 @@
+#include "ConvexHull.h"
+#include "IncrementalHull.h"
+#include "Kernel.h"
+#include "Predicates.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+
+namespace Geometry {
+
+namespace {
+
+inline bool lexLess(const Point &a, const Point &b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+inline double distSq(const Point &a, const Point &b)
+{
+    return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y);
+}
+
+/**
+ * @brief 对一段已按字典序排好的点执行单调链扫描，把凸包（逆时针，不含共线点）追加到 out 末尾
+ * @details 与 convexHullAndrew 相同的规则，但直接在调用者提供的缓冲区中构建，
+ * 供 Chan 算法为每个分组重复调用而不产生额外的临时容器。
+ */
+void appendMonotoneChain(const Point *first, const Point *last, std::vector<Point> &out)
+{
+    const std::size_t base = out.size();
+    const std::size_t k = static_cast<std::size_t>(last - first);
+    if (k < 3) {
+        out.insert(out.end(), first, last);
+        if (k == 2 && first[0] == first[1]) out.pop_back();
+        return;
+    }
+    // 下凸包
+    for (const Point *p = first; p != last; ++p) {
+        while (out.size() >= base + 2 && crossProduct(out[out.size()-2], out.back(), *p) <= 0) out.pop_back();
+        out.push_back(*p);
+    }
+    // 上凸包（下凸包的最后一个点作为起点，不重复加入）
+    const std::size_t lowerSize = out.size();
+    for (const Point *p = last - 2; p >= first; --p) {
+        while (out.size() >= lowerSize + 1 && crossProduct(out[out.size()-2], out.back(), *p) <= 0) out.pop_back();
+        out.push_back(*p);
+        if (p == first) break;
+    }
+    out.pop_back(); // 移除重复的起点
+    if (out.size() == base) out.push_back(*first); // 所有点重合
+}
+
+/**
+ * @brief 求点 p 到凸多边形 H（逆时针、无共线顶点）的“右切点”
+ * @details 即满足 H 的所有顶点都在 p→H[k] 左侧或线上的顶点 H[k]。从 p 看去，
+ * 顶点的极角沿多边形先升后降（双调），边 i 对 p“可见”（p 在其右侧）的区间是连续的，
+ * 右切点恰好是可见区间的终点，因此可以二分查找。共线时取较远的一个。
+ * 若 p 恰好是 H 的顶点（重复点），二分的前提不成立，此时退化为线性扫描。
+ * @return 切点下标
+ * @complexity O(log m)，退化时 O(m)
+ */
+std::size_t rightTangent(const Point *H, std::size_t m, const Point &p)
+{
+    // 下标只会落在 [0, 2m) 内，用条件减法代替取模
+    auto at = [&](std::size_t i) -> const Point & { return H[i < m ? i : i - m]; };
+    auto down = [&](std::size_t i) { return crossProduct(p, at(i), at(i + 1)) < 0; };
+
+    std::size_t k = 0;
+    if (m > 2) {
+        // 不变式：切点下标在 (lo, hi] 之中（hi == m 代表下标 0）
+        std::size_t lo = 0, hi = m;
+        bool loDown = down(0);
+        while (hi - lo > 1) {
+            const std::size_t mid = (lo + hi) / 2;
+            const bool midDown = down(mid);
+            bool moveLo;
+            if (loDown) {
+                // lo 在下降段：mid 也在同一下降段（更低）时才右移
+                moveLo = midDown && crossProduct(p, H[lo], H[mid]) < 0;
+            } else {
+                // lo 在上升段：mid 已进入下降段，或仍在同一上升段（更高）时右移
+                moveLo = midDown || crossProduct(p, H[lo], H[mid]) > 0;
+            }
+            if (moveLo) {
+                lo = mid;
+                loDown = midDown;
+            } else {
+                hi = mid;
+            }
+        }
+        k = (hi == m) ? 0 : hi;
+    } else if (m == 2) {
+        k = crossProduct(p, H[0], H[1]) < 0 ? 1 : 0;
+    }
+
+    // 校验：切点处应由“可见”转为“不可见”；不成立说明 p 在 H 上，线性扫描兜底
+    if (m > 2 && !(down(k + m - 1) && !down(k))) {
+        k = 0;
+        for (std::size_t i = 1; i < m; ++i) {
+            const double o = crossProduct(p, H[k], H[i]);
+            if (H[k] == p || o < 0 || (o == 0 && distSq(p, H[i]) > distSq(p, H[k]))) k = i;
+        }
+        return k;
+    }
+    // 切线与某条边重合时取更远的端点
+    const std::size_t next = (k + 1 == m) ? 0 : k + 1;
+    if (m > 1 && crossProduct(p, H[k], H[next]) == 0 && distSq(p, H[next]) > distSq(p, H[k])) k = next;
+    return k;
+}
+
+/**
+ * @brief Chan 算法的一轮：以分组大小 m 尝试求凸包
+ * @param points 本轮的候选点（各组会被原地排序）
+ * @param groupHulls [out] 各组凸包顶点，按组连续存放；失败时作为下一轮的候选点
+ * @return 若在 m 步之内 Jarvis 步进回到起点则成功并写入 hull；否则返回 false
+ */
+bool chanRound(std::vector<Point> &points, std::size_t m,
+               std::vector<Point> &groupHulls, std::vector<std::size_t> &offsets, std::vector<Point> &hull)
+{
+    const std::size_t n = points.size();
+    groupHulls.clear();
+    offsets.assign(1, 0);
+
+    // 1. 分组（原地排序每组）并用单调链求每组的凸包，O(n log m)
+    for (std::size_t begin = 0; begin < n; begin += m) {
+        const std::size_t end = std::min(begin + m, n);
+        std::sort(points.begin() + begin, points.begin() + end, lexLess);
+        appendMonotoneChain(points.data() + begin, points.data() + end, groupHulls);
+        offsets.push_back(groupHulls.size());
+    }
+    const std::size_t groups = offsets.size() - 1;
+
+    // 2. 起点：字典序最小的点，必为某组凸包的第 0 个顶点
+    std::size_t curGroup = 0;
+    for (std::size_t g = 1; g < groups; ++g) {
+        if (lexLess(groupHulls[offsets[g]], groupHulls[offsets[curGroup]])) curGroup = g;
+    }
+    std::size_t curIndex = 0;
+    const Point start = groupHulls[offsets[curGroup]];
+
+    // 3. 在各组凸包上做 Jarvis 步进，每一步对每组做一次 O(log m) 的切线查询
+    hull.clear();
+    hull.push_back(start);
+    for (std::size_t step = 0; step < m; ++step) {
+        const Point p = groupHulls[offsets[curGroup] + curIndex];
+        std::size_t bestGroup = curGroup;
+        std::size_t bestIndex = curIndex;
+        for (std::size_t g = 0; g < groups; ++g) {
+            const Point *H = groupHulls.data() + offsets[g];
+            const std::size_t size = offsets[g + 1] - offsets[g];
+            const std::size_t idx = (g == curGroup) ? (curIndex + 1) % size : rightTangent(H, size, p);
+            const Point &cand = H[idx];
+            const Point &best = groupHulls[offsets[bestGroup] + bestIndex];
+            const double o = crossProduct(p, best, cand);
+            if (best == p || o < 0 || (o == 0 && distSq(p, cand) > distSq(p, best))) {
+                bestGroup = g;
+                bestIndex = idx;
+            }
+        }
+
+        const Point &next = groupHulls[offsets[bestGroup] + bestIndex];
+        if (next == start || next == p) return true; // 回到起点（或所有点重合），凸包闭合
+        hull.push_back(next);
+        curGroup = bestGroup;
+        curIndex = bestIndex;
+    }
+    return false;
+}
+
+/**
+ * @brief 对已按字典序排好的点求下链与上链，两者都按从左到右的顺序存放
+ * @details 下链相邻三点严格左转，上链相邻三点严格右转；共线点与重复点都会被弹出，
+ * 规则与 convexHullAndrew 一致。
+ */
+void buildChains(const Point *first, const Point *last, std::vector<Point> &lower, std::vector<Point> &upper)
+{
+    lower.clear();
+    upper.clear();
+    for (const Point *p = first; p != last; ++p) {
+        while (lower.size() >= 2 && crossProduct(lower[lower.size()-2], lower.back(), *p) <= 0) lower.pop_back();
+        lower.push_back(*p);
+        while (upper.size() >= 2 && crossProduct(upper[upper.size()-2], upper.back(), *p) >= 0) upper.pop_back();
+        upper.push_back(*p);
+    }
+}
+
+/**
+ * @brief 合并两条按字典序分离的链（left 的所有点都在 right 之前），结果写回 left
+ * @param sign 下链为 +1，上链为 -1
+ * @details 经典的“桥”查找：从 left 的最右点和 right 的最左点出发，交替地在左链上回退、
+ * 在右链上前进，直到连线对两条链都成为切线。桥左侧的左链与桥右侧的右链拼接即为合并结果。
+ * @complexity O(|left| + |right|)，实际只会走过切点附近的少数顶点
+ */
+void mergeChains(std::vector<Point> &left, const std::vector<Point> &right, int sign)
+{
+    if (right.empty()) return;
+    if (left.empty()) {
+        left = right;
+        return;
+    }
+    std::size_t i = left.size() - 1;
+    std::size_t j = 0;
+    auto turn = [sign](const Point &a, const Point &b, const Point &c) { return sign * crossProduct(a, b, c); };
+    for (bool moved = true; moved;) {
+        moved = false;
+        while (i > 0 && turn(left[i-1], left[i], right[j]) <= 0) {
+            --i;
+            moved = true;
+        }
+        while (j + 1 < right.size() && turn(left[i], right[j], right[j+1]) <= 0) {
+            ++j;
+            moved = true;
+        }
+    }
+    left.resize(i + 1);
+    if (left.back() == right[j]) ++j; // 两侧共享同一个点时不重复加入
+    left.insert(left.end(), right.begin() + j, right.end());
+}
+
+/**
+ * @brief Andrew 单调链的主体，按内核 K 实例化
+ * @details 坐标一次性转换为内核的点类型，排序与全部定向判断都在内核坐标上进行；
+ * 每个转换后的点带着它在输入中的下标，输出取回原始的 Point，因此 float 等有损内核也只返回输入中的点。
+ */
+template <typename K>
+std::vector<Point> monotoneChainHull(PointSpan points)
+{
+    struct Entry {
+        typename K::Point p;
+        std::size_t index; // 在 points 中的下标
+    };
+
+    // 1. 按 x 坐标排序，x 相同则按 y 坐标排序
+    std::vector<Entry> sortedPoints;
+    sortedPoints.reserve(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) sortedPoints.push_back({K::convert(points[i]), i});
+    std::sort(sortedPoints.begin(), sortedPoints.end(), [](const Entry &a, const Entry &b) {
+        return a.p.x < b.p.x || (a.p.x == b.p.x && a.p.y < b.p.y);
+    });
+
+    std::vector<const Entry *> upper, lower;
+
+    // 2. 构建下凸包
+    for (const Entry &e : sortedPoints) {
+        while (lower.size() >= 2 && K::orient2d(lower[lower.size()-2]->p, lower.back()->p, e.p) <= 0) {
+            lower.pop_back();
+        }
+        lower.push_back(&e);
+    }
+
+    // 3. 构建上凸包
+    for (auto it = sortedPoints.rbegin(); it != sortedPoints.rend(); ++it) {
+        const Entry &e = *it;
+        while (upper.size() >= 2 && K::orient2d(upper[upper.size()-2]->p, upper.back()->p, e.p) <= 0) {
+            upper.pop_back();
+        }
+        upper.push_back(&e);
+    }
+
+    // 4. 合并上下凸包（各自去掉与另一条链重复的端点）
+    std::vector<Point> hull;
+    hull.reserve(lower.size() + upper.size() - 2);
+    for (std::size_t i = 0; i + 1 < lower.size(); ++i) hull.push_back(points[lower[i]->index]);
+    for (std::size_t i = 0; i + 1 < upper.size(); ++i) hull.push_back(points[upper[i]->index]);
+    return hull;
+}
+
+} // namespace
+
+/**
+ * @brief 使用 Andrew's Monotone Chain 算法计算点集的凸包。
+ * @details 算法首先按X坐标对所有点进行排序，然后分别构建上凸包和下凸包，最后合并得到最终结果。
+ * 这是一个高效且稳健的凸包算法。主体 monotoneChainHull 按几何内核实例化，这里只在入口处选定一次内核。
+ * @param points 输入点集（不会被修改）
+ * @param kernel 几何内核；鼠标输入这类整数坐标默认走 int32 精确内核
+ * @return 凸包顶点；点数少于 3 时原样返回
+ * @complexity O(n log n)，主要瓶颈在于排序。
+ */
+std::vector<Point> convexHullAndrew(PointSpan points, KernelKind kernel)
+{
+    if (points.size() < 3) return std::vector<Point>(points.begin(), points.end());
+    return withKernel(resolveKernel(kernel, {points}),
+                      [&](auto k) { return monotoneChainHull<decltype(k)>(points); });
+}
+
+/**
+ * @brief 使用 Graham Scan (格雷厄姆扫描法) 计算点集的凸包。
+ * @details 算法首先找到Y坐标最小的点作为锚点，然后将其余点按与锚点的极角排序，最后通过栈操作构建出凸包。
+ * @param points 输入点集（在副本上操作，不会被修改）
+ * @return 凸包顶点；点数少于 3 时原样返回
+ * @complexity O(n log n)，主要瓶颈在于极角排序。
+ */
+std::vector<Point> convexHullGraham(PointSpan points)
+{
+    if (points.size() < 3) return std::vector<Point>(points.begin(), points.end());
+
+    // 创建 points 的副本，所有操作都在这个副本上进行
+    std::vector<Point> tempPoints(points.begin(), points.end());
+
+    // 1. 找到Y坐标最小的点（P0）
+    std::size_t minY_idx = 0;
+    for (std::size_t i = 1; i < tempPoints.size(); ++i) {
+        if (tempPoints[i].y < tempPoints[minY_idx].y ||
+            (tempPoints[i].y == tempPoints[minY_idx].y && tempPoints[i].x < tempPoints[minY_idx].x)) {
+            minY_idx = i;
+        }
+    }
+    std::swap(tempPoints[0], tempPoints[minY_idx]);
+    const Point p0 = tempPoints[0];
+
+    // 2. 将其他点根据与P0的极角进行排序
+    std::sort(tempPoints.begin() + 1, tempPoints.end(), [&](const Point &a, const Point &b) {
+        // 自适应精度的定向：共线判断是精确的，与坐标尺度无关，比较器因此满足严格弱序
+        const double order = orient2dAdaptive(p0, a, b);
+
+        // 处理共线情况：距离近的排在前面
+        if (order == 0) {
+            double distSqA = (p0.x - a.x) * (p0.x - a.x) + (p0.y - a.y) * (p0.y - a.y);
+            double distSqB = (p0.x - b.x) * (p0.x - b.x) + (p0.y - b.y) * (p0.y - b.y);
+            return distSqA < distSqB;
+        }
+
+        // 叉积 > 0 表示 p0->a 在 p0->b 的逆时针方向
+        return order > 0;
+    });
+
+    // 3. 构建凸包
+    std::vector<Point> hull;
+    hull.push_back(tempPoints[0]);
+    hull.push_back(tempPoints[1]);
+
+    for (std::size_t i = 2; i < tempPoints.size(); ++i) {
+        while (hull.size() > 1 &&
+               orient2dAdaptive(hull[hull.size()-2], hull.back(), tempPoints[i]) <= 0) {
+            hull.pop_back();
+        }
+        hull.push_back(tempPoints[i]);
+    }
+    return hull;
+}
+
+/**
+ * @brief 使用 Chan 算法（输出敏感）计算点集的凸包。
+ * @details 猜测凸包大小 m = 2^(2^t)：把点集分成 ⌈n/m⌉ 组，每组用单调链求凸包（O(n log m)），
+ * 再从最左点出发做至多 m 步 Jarvis 步进，每一步在每组凸包上二分查找切点（O((n/m) log m)）。
+ * 若 m 步内闭合则得到结果，否则平方 m 重试；重试时只保留各组凸包的顶点作为候选点，
+ * 因为组内凸包之外的点不可能是全局凸包顶点。各轮代价呈几何级数增长，总代价由最后一轮主导。
+ * 输出与 convexHullAndrew 一致：从字典序最小点开始逆时针排列，不含共线点。
+ * @param points 输入点集（不会被修改）
+ * @return 凸包顶点；点数少于 3 时原样返回
+ * @complexity O(n log h)，h 为凸包顶点数。点多而凸包小时明显快于 O(n log n) 的两种算法。
+ */
+std::vector<Point> convexHullChan(PointSpan points)
+{
+    const std::size_t n = points.size();
+    if (n < 3) return std::vector<Point>(points.begin(), points.end());
+
+    std::vector<Point> working(points.begin(), points.end());
+    std::vector<Point> groupHulls, hull;
+    std::vector<std::size_t> offsets;
+    // 从 m = 256 开始：更小的分组剔除不了多少点，Jarvis 步进却几乎必然失败；之后每轮 m 平方
+    for (unsigned t = 3; ; ++t) {
+        const std::size_t count = working.size();
+        const unsigned exponent = (t < 6) ? (1u << t) : 64u;
+        const std::size_t m = (exponent >= 63 || (std::size_t(1) << exponent) >= count) ? count : (std::size_t(1) << exponent);
+        if (chanRound(working, m, groupHulls, offsets, hull)) return hull;
+        if (m == count) break; // 理论上不会发生：只有一组时 Jarvis 步进必然闭合
+        // 不在任何组凸包上的点不可能在全局凸包上，下一轮只处理各组凸包顶点
+        working.swap(groupHulls);
+    }
+    return convexHullAndrew(points);
+}
+
+/**
+ * @brief 多线程分治凸包：并行分桶、并行求子凸包、沿切线合并
+ * @details
+ * 1. **取分割点**：等距抽样若干点并按字典序排序，取 T-1 个分割点，把平面按字典序切成 T 个竖条；
+ * 2. **并行分桶**：按下标把输入分成 T 段，各线程先统计每段落入各桶的点数，前缀和之后再并行写入，
+ *    使每个桶在输出数组中连续；
+ * 3. **并行求子凸包**：各线程对自己的桶排序并用单调链求下链、上链，桶之间按字典序严格分离；
+ * 4. **合并**：从左到右依次用桥（上、下公共切线）把相邻子凸包的链拼起来，代价只与子凸包大小有关。
+ * 排序这一主要开销被均分到 T 个线程上，合并部分几乎可以忽略，因此在大数据量下接近线性加速。
+ * 点数较少时线程开销不划算，自动退化为单线程 Andrew 算法。输出与 convexHullAndrew 一致。
+ * @param points 输入点集（不会被修改）
+ * @param threadCount 线程数（也是分桶数），0 表示硬件并发数
+ * @return 凸包顶点
+ * @complexity O((n log n) / T + n/T·log T + T·h)
+ */
+std::vector<Point> convexHullParallel(PointSpan points, unsigned threadCount)
+{
+    const std::size_t n = points.size();
+    const std::size_t minPerThread = 1 << 15; // 每个线程至少分到的点数，少于此值时并行不划算
+    const unsigned requested = ThreadPool::resolveThreadCount(threadCount);
+    const unsigned T = static_cast<unsigned>(std::min<std::size_t>(requested, n / minPerThread));
+    if (T <= 1) return convexHullAndrew(points);
+
+    // 线程数超出共享线程池时，为本次计算单独建一个池
+    ThreadPool *pool = &ThreadPool::global();
+    std::unique_ptr<ThreadPool> ownPool;
+    if (T > pool->size()) {
+        ownPool = std::make_unique<ThreadPool>(T);
+        pool = ownPool.get();
+    }
+
+    // 1. 抽样取分割点
+    const std::size_t sampleCount = std::min<std::size_t>(n, std::size_t(T) * 64);
+    std::vector<Point> sample(sampleCount);
+    for (std::size_t k = 0; k < sampleCount; ++k) sample[k] = points[k * (n / sampleCount)];
+    std::sort(sample.begin(), sample.end(), lexLess);
+    std::vector<Point> splitters(T - 1);
+    for (unsigned k = 0; k + 1 < T; ++k) splitters[k] = sample[(k + 1) * sampleCount / T];
+    auto bucketOf = [&](const Point &p) {
+        return static_cast<std::size_t>(std::upper_bound(splitters.begin(), splitters.end(), p, lexLess) - splitters.begin());
+    };
+    auto chunkBegin = [&](std::size_t c) { return c * n / T; };
+
+    // 2. 并行分桶：先计数，再按前缀和写入
+    std::vector<std::size_t> counts(std::size_t(T) * T, 0); // counts[chunk * T + bucket]
+    pool->parallelFor(T, [&](std::size_t c) {
+        std::size_t *row = counts.data() + c * T;
+        for (std::size_t i = chunkBegin(c), end = chunkBegin(c + 1); i < end; ++i) ++row[bucketOf(points[i])];
+    });
+    std::vector<std::size_t> bucketStart(T + 1, 0);
+    std::vector<std::size_t> cursor(std::size_t(T) * T);
+    {
+        std::size_t offset = 0;
+        for (unsigned b = 0; b < T; ++b) {
+            bucketStart[b] = offset;
+            for (unsigned c = 0; c < T; ++c) {
+                cursor[std::size_t(c) * T + b] = offset;
+                offset += counts[std::size_t(c) * T + b];
+            }
+        }
+        bucketStart[T] = offset;
+    }
+    std::vector<Point> bucketed(n);
+    pool->parallelFor(T, [&](std::size_t c) {
+        std::size_t *row = cursor.data() + c * T;
+        for (std::size_t i = chunkBegin(c), end = chunkBegin(c + 1); i < end; ++i) {
+            bucketed[row[bucketOf(points[i])]++] = points[i];
+        }
+    });
+
+    // 3. 并行：每个桶排序并求上下链
+    std::vector<std::vector<Point>> lowers(T), uppers(T);
+    pool->parallelFor(T, [&](std::size_t b) {
+        Point *first = bucketed.data() + bucketStart[b];
+        Point *last = bucketed.data() + bucketStart[b + 1];
+        std::sort(first, last, lexLess);
+        buildChains(first, last, lowers[b], uppers[b]);
+    });
+
+    // 4. 从左到右沿桥合并子凸包
+    std::vector<Point> lower = std::move(lowers[0]);
+    std::vector<Point> upper = std::move(uppers[0]);
+    for (unsigned b = 1; b < T; ++b) {
+        mergeChains(lower, lowers[b], +1);
+        mergeChains(upper, uppers[b], -1);
+    }
+
+    // 下链去掉终点 + 上链反向去掉终点，与 convexHullAndrew 的输出顺序一致
+    std::vector<Point> hull(lower.begin(), lower.end() - 1);
+    hull.insert(hull.end(), upper.rbegin(), upper.rend() - 1);
+    return hull;
+}
+
+/**
+ * @brief 逐点插入 IncrementalHull 得到凸包
+ * @details 主要用于与其他算法对照；界面与数据流场景应直接持有 IncrementalHull 对象，
+ * 每来一个点调用一次 insert()，避免整体重算。
+ * @complexity O(n log h)（均摊）
+ */
+std::vector<Point> convexHullIncremental(PointSpan points)
+{
+    IncrementalHull hull;
+    hull.insert(points);
+    return hull.hull();
+}
+
+/**
+ * @brief 按指定算法计算凸包，统一记录输入规模、预过滤剔除数、凸包规模和墙钟耗时
+ * @param points 输入点集
+ * @param algorithm 使用的算法
+ * @param options 计算选项；开启预过滤时先用 aklToussaintFilter 剔除内部点，再交给算法排序
+ * @param stats [out] 可选，非空时写入本次计算的统计信息
+ * @return 凸包顶点
+ */
+std::vector<Point> computeConvexHull(PointSpan points, HullAlgorithm algorithm,
+                                     const HullOptions &options, HullStats *stats)
+{
+    const auto begin = std::chrono::steady_clock::now();
+
+    std::vector<Point> filtered;
+    PointSpan input = points;
+    if (options.prefilter != HullPrefilter::None) {
+        filtered = aklToussaintFilter(points, options.prefilter);
+        input = filtered;
+    }
+
+    std::vector<Point> hull;
+    switch (algorithm) {
+    case HullAlgorithm::Andrew: hull = convexHullAndrew(input, options.kernel); break;
+    case HullAlgorithm::Graham: hull = convexHullGraham(input); break;
+    case HullAlgorithm::Chan:   hull = convexHullChan(input);   break;
+    case HullAlgorithm::Parallel: hull = convexHullParallel(input, options.threadCount); break;
+    case HullAlgorithm::Incremental: hull = convexHullIncremental(input); break;
+    }
+
+    if (stats) {
+        stats->inputCount = points.size();
+        stats->discardedCount = points.size() - input.size();
+        stats->hullCount = hull.size();
+        stats->elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+    return hull;
+}
+
+} // namespace Geometry
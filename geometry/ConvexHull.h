@@ -0,0 +1,48 @@
+#ifndef CONVEXHULL_H
+#define CONVEXHULL_H
+/*ConvexHull 提供与界面无关的凸包算法，输入为只读点集视图，输出为逆时针（数学坐标系）排列的凸包顶点*/
+#include "AklToussaint.h"
+#include "GeometryTypes.h"
+#include "Kernel.h"
+
+namespace Geometry {
+
+// Andrew's Monotone Chain，O(n log n)；按 kernel 实例化的几何内核做定向判断，Auto 时按坐标自动选择精确内核
+std::vector<Point> convexHullAndrew(PointSpan points, KernelKind kernel = KernelKind::Auto);
+
+// Graham Scan，O(n log n)
+std::vector<Point> convexHullGraham(PointSpan points);
+
+// Chan 算法（输出敏感），O(n log h)，h 为凸包顶点数
+std::vector<Point> convexHullChan(PointSpan points);
+
+// 多线程分治：按 x 分桶、各桶并行求凸包、再用切线（桥）逐个合并；threadCount 为 0 时使用全部核心
+std::vector<Point> convexHullParallel(PointSpan points, unsigned threadCount = 0);
+
+// 在线增量：逐点插入 IncrementalHull，均摊 O(log h) / 点；需要实时维护时直接使用 IncrementalHull
+std::vector<Point> convexHullIncremental(PointSpan points);
+
+enum class HullAlgorithm { Andrew, Graham, Chan, Parallel, Incremental };
+
+//凸包计算的可选项
+struct HullOptions {
+    HullPrefilter prefilter = HullPrefilter::None; // 排序前的 Akl–Toussaint 内点预过滤
+    unsigned threadCount = 0;                      // Parallel 模式的线程数，0 表示硬件并发数
+    KernelKind kernel = KernelKind::Auto;          // Andrew 模式使用的几何内核
+};
+
+//一次凸包计算的统计信息，用于比较不同算法
+struct HullStats {
+    std::size_t inputCount = 0;     // 输入点数 n
+    std::size_t discardedCount = 0; // 预过滤剔除的点数
+    std::size_t hullCount = 0;      // 凸包顶点数 h
+    double elapsedMs = 0.0;         // 墙钟耗时（毫秒，含预过滤）
+};
+
+// 按指定算法与选项计算凸包，并可选地输出统计信息
+std::vector<Point> computeConvexHull(PointSpan points, HullAlgorithm algorithm,
+                                     const HullOptions &options = {}, HullStats *stats = nullptr);
+
+} // namespace Geometry
+
+#endif // CONVEXHULL_H
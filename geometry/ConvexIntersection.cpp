@@ -0,0 +1,233 @@
+#include "ConvexIntersection.h"
+#include "PolygonUtils.h"
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+namespace Geometry {
+
+namespace {
+
+inline bool lexLess(const Point &a, const Point &b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+//凸多边形的上、下两条 x 单调链，顶点 x 严格递增；左右两端的竖直边被压缩成链上的端点取值
+struct MonotoneChains {
+    Polygon upper;
+    Polygon lower;
+};
+
+/**
+ * @brief 把凸多边形拆成上链与下链
+ * @details 先去重并统一为逆时针。从字典序最小点逆时针走到字典序最大点是下链，
+ * 其余部分反向后是上链。最左、最右若有竖直边，上链取其上端、下链取其下端。
+ */
+MonotoneChains splitChains(PointSpan poly)
+{
+    Polygon ring;
+    ring.reserve(poly.size());
+    for (const Point &p : poly) {
+        if (ring.empty() || ring.back() != p) ring.push_back(p);
+    }
+    while (ring.size() > 1 && ring.front() == ring.back()) ring.pop_back();
+    if (computeAreaSign(ring) < 0) std::reverse(ring.begin(), ring.end());
+
+    MonotoneChains chains;
+    const std::size_t n = ring.size();
+    if (n < 3) return chains;
+    std::size_t first = 0, last = 0;
+    for (std::size_t i = 1; i < n; ++i) {
+        if (lexLess(ring[i], ring[first])) first = i;
+        if (lexLess(ring[last], ring[i])) last = i;
+    }
+    for (std::size_t i = first;; i = (i + 1) % n) {
+        chains.lower.push_back(ring[i]);
+        if (i == last) break;
+    }
+    for (std::size_t i = last;; i = (i + 1) % n) {
+        chains.upper.push_back(ring[i]);
+        if (i == first) break;
+    }
+    std::reverse(chains.upper.begin(), chains.upper.end());
+
+    while (chains.lower.size() > 1 && chains.lower.back().x == chains.lower[chains.lower.size() - 2].x) {
+        chains.lower.pop_back();
+    }
+    while (chains.upper.size() > 1 && chains.upper[0].x == chains.upper[1].x) {
+        chains.upper.erase(chains.upper.begin());
+    }
+    return chains;
+}
+
+//沿 x 单调前进的链上求值；cursor 只增不减，整条链求值的总开销为线性
+class ChainCursor
+{
+public:
+    explicit ChainCursor(const Polygon &chain) : m_chain(chain) {}
+
+    double valueAt(double x)
+    {
+        while (m_index + 2 < m_chain.size() && m_chain[m_index + 1].x <= x) ++m_index;
+        if (m_chain.size() == 1) return m_chain[0].y;
+        const Point &a = m_chain[m_index];
+        const Point &b = m_chain[m_index + 1];
+        if (x <= a.x) return a.y;
+        if (x >= b.x) return b.y;
+        return a.y + (x - a.x) / (b.x - a.x) * (b.y - a.y);
+    }
+
+    //x 是否恰好是链上的顶点（上一次 valueAt 之后调用）
+    bool isVertex(double x) const
+    {
+        return m_chain[m_index].x == x || (m_index + 1 < m_chain.size() && m_chain[m_index + 1].x == x);
+    }
+
+private:
+    const Polygon &m_chain;
+    std::size_t m_index = 0;
+};
+
+//一条竖直扫描线上的采样：两条上链取较小者 top、两条下链取较大者 bottom
+struct Sample {
+    double x;
+    double top;
+    double bottom;
+    bool topCorner;    // top 在此处可能拐弯（某条上链的顶点或两条上链的交点）
+    bool bottomCorner; // bottom 同理
+};
+
+} // namespace
+
+/**
+ * @brief 凸多边形求交（x 单调链合并）
+ * @details 凸多边形可以看作上链 u(x) 与下链 l(x) 之间的区域，于是交集就是
+ * min(uA, uB) 与 max(lA, lB) 之间、且前者不低于后者的部分。
+ * 1. 把四条链在公共 x 区间内的顶点横坐标归并成一个有序序列（四路归并，线性时间）；
+ * 2. 相邻两个横坐标之间四条链都是线段，两条上链（或两条下链）若在其间交叉，就在交点处补一个采样；
+ * 3. top − bottom 是凹函数，非负的部分必然连续，在其两端求出 top 与 bottom 的交点即可，
+ *    下边界从左到右、上边界从右到左连成结果。
+ * 只输出真正的拐点，另一条链的顶点投影到当前边上时不会产生多余的共线点。
+ * 与 O'Rourke 的“追赶边”算法复杂度相同，但对共边、重合顶点、两多边形完全相同等退化情形没有特判。
+ */
+Polygon intersectConvexPolygons(PointSpan polygonA, PointSpan polygonB, BooleanOpStats *stats)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto begin = Clock::now();
+    std::size_t crossings = 0;
+    Polygon result;
+
+    auto finish = [&]() {
+        if (result.size() < 3 || computeAreaSign(result) <= 0) result.clear();
+        if (stats) {
+            *stats = BooleanOpStats{};
+            stats->intersectionCount = crossings;
+            stats->traversalMs = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+            stats->convexFastPath = true;
+        }
+        return result;
+    };
+
+    const MonotoneChains a = splitChains(polygonA);
+    const MonotoneChains b = splitChains(polygonB);
+    if (a.lower.empty() || b.lower.empty()) return finish();
+
+    const double left = std::max(a.lower.front().x, b.lower.front().x);
+    const double right = std::min(a.lower.back().x, b.lower.back().x);
+    if (left > right) return finish();
+
+    //1. 四路归并公共区间内的所有顶点横坐标
+    std::vector<double> xs{left, right};
+    for (const Polygon *chain : {&a.upper, &a.lower, &b.upper, &b.lower}) {
+        const std::size_t mid = xs.size();
+        for (const Point &p : *chain) {
+            if (p.x > left && p.x < right) xs.push_back(p.x);
+        }
+        std::inplace_merge(xs.begin(), xs.begin() + static_cast<std::ptrdiff_t>(mid), xs.end());
+    }
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+
+    //2. 逐个采样，并在两条上链或两条下链交叉处补采样
+    ChainCursor ua(a.upper), la(a.lower), ub(b.upper), lb(b.lower);
+    std::vector<Sample> samples;
+    samples.reserve(xs.size() + 8);
+    double prevX = 0, prevUa = 0, prevUb = 0, prevLa = 0, prevLb = 0;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        const double x = xs[i];
+        const double vua = ua.valueAt(x), vub = ub.valueAt(x), vla = la.valueAt(x), vlb = lb.valueAt(x);
+        if (i > 0) {
+            //区间内各链都是线段，交点参数可以直接线性求出
+            const double dTop0 = prevUa - prevUb, dTop1 = vua - vub;
+            const double dBot0 = prevLa - prevLb, dBot1 = vla - vlb;
+            double tTop = -1, tBot = -1;
+            if ((dTop0 < 0 && dTop1 > 0) || (dTop0 > 0 && dTop1 < 0)) tTop = dTop0 / (dTop0 - dTop1);
+            if ((dBot0 < 0 && dBot1 > 0) || (dBot0 > 0 && dBot1 < 0)) tBot = dBot0 / (dBot0 - dBot1);
+            auto addCrossing = [&](double t, bool top) {
+                const double cx = prevX + t * (x - prevX);
+                const double cua = prevUa + t * (vua - prevUa), cub = prevUb + t * (vub - prevUb);
+                const double cla = prevLa + t * (vla - prevLa), clb = prevLb + t * (vlb - prevLb);
+                samples.push_back({cx, std::min(cua, cub), std::max(cla, clb), top, !top});
+                ++crossings;
+            };
+            if (tTop >= 0 && tBot >= 0 && tBot < tTop) {
+                addCrossing(tBot, false);
+                addCrossing(tTop, true);
+            } else {
+                if (tTop >= 0) addCrossing(tTop, true);
+                if (tBot >= 0) addCrossing(tBot, false);
+            }
+        }
+        //两条链恰好在采样处相交时，交点就是这个采样本身
+        const bool topCorner = vua == vub || (vua < vub && ua.isVertex(x)) || (vub < vua && ub.isVertex(x));
+        const bool bottomCorner = vla == vlb || (vla > vlb && la.isVertex(x)) || (vlb > vla && lb.isVertex(x));
+        samples.push_back({x, std::min(vua, vub), std::max(vla, vlb), topCorner, bottomCorner});
+        prevX = x;
+        prevUa = vua, prevUb = vub, prevLa = vla, prevLb = vlb;
+    }
+
+    //3. 截取 top ≥ bottom 的连续部分（凹函数的非负区间）
+    std::size_t firstIn = samples.size(), lastIn = 0;
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        if (samples[i].top >= samples[i].bottom) {
+            firstIn = std::min(firstIn, i);
+            lastIn = i;
+        }
+    }
+    if (firstIn == samples.size()) return finish();
+
+    //top 与 bottom 在相邻两个采样之间的交点
+    auto pinch = [&](const Sample &s0, const Sample &s1) {
+        const double f0 = s0.top - s0.bottom, f1 = s1.top - s1.bottom;
+        const double t = f0 / (f0 - f1);
+        ++crossings;
+        return Point{s0.x + t * (s1.x - s0.x), s0.bottom + t * (s1.bottom - s0.bottom)};
+    };
+
+    Polygon lowerOut, upperOut;
+    if (firstIn > 0) {
+        const Point p = pinch(samples[firstIn - 1], samples[firstIn]);
+        lowerOut.push_back(p);
+        upperOut.push_back(p);
+    }
+    for (std::size_t i = firstIn; i <= lastIn; ++i) {
+        const Sample &s = samples[i];
+        const bool end = (i == firstIn || i == lastIn);
+        if (s.bottomCorner || end) lowerOut.push_back({s.x, s.bottom});
+        if (s.topCorner || end) upperOut.push_back({s.x, s.top});
+    }
+    if (lastIn + 1 < samples.size()) {
+        const Point p = pinch(samples[lastIn], samples[lastIn + 1]);
+        lowerOut.push_back(p);
+        upperOut.push_back(p);
+    }
+
+    result = std::move(lowerOut);
+    for (auto it = upperOut.rbegin(); it != upperOut.rend(); ++it) {
+        if (result.back() != *it) result.push_back(*it);
+    }
+    while (result.size() > 1 && result.front() == result.back()) result.pop_back();
+    return finish();
+}
+
+} // namespace Geometry
@@ -0,0 +1,22 @@
+#ifndef CONVEXINTERSECTION_H
+#define CONVEXINTERSECTION_H
+/*ConvexIntersection 通过合并两个凸多边形的上、下单调链，在线性时间内求它们的交集*/
+#include "BooleanOp.h"
+#include "GeometryTypes.h"
+
+namespace Geometry {
+
+/**
+ * @brief 两个凸多边形的交集
+ * @param polygonA 凸多边形（顶点方向任意，可含共线点）
+ * @param polygonB 凸多边形，要求同上
+ * @param stats [out] 可选：边界交点数与耗时（全部计入 traversalMs）
+ * @return 交集（逆时针凸多边形）；不相交或只在一点、一条线段上接触时为空
+ * @note 调用方需保证输入是凸的（见 isConvexPolygon），否则结果无意义
+ * @complexity O(n + m)
+ */
+Polygon intersectConvexPolygons(PointSpan polygonA, PointSpan polygonB, BooleanOpStats *stats = nullptr);
+
+} // namespace Geometry
+
+#endif // CONVEXINTERSECTION_H
@@ -0,0 +1,328 @@
+#include "DynamicHull.h"
+#include "Predicates.h"
+#include <algorithm>
+#include <utility>
+
+namespace Geometry {
+
+namespace {
+
+inline bool lexLess(const Point &a, const Point &b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+inline Point mirrored(const Point &p)
+{
+    return {p.x, -p.y};
+}
+
+} // namespace
+
+/**
+ * @brief 一条上凸链的动态表示：以叶子存储点的加权平衡二叉树，内部结点记录桥
+ * @details 结点保存在数组中，用下标互相引用，删除的结点进入空闲链表复用。
+ * 上凸链按字典序从左到右、相邻三点严格右转；x 相同的点由字典序区分，
+ * 所以链的两端可能带有竖直边，与 convexHullAndrew 的上下链定义一致。
+ */
+class DynamicHull::ChainTree
+{
+public:
+    void insert(const Point &p) { m_root = insertAt(m_root, p); }
+    bool erase(const Point &p)
+    {
+        bool found = false;
+        m_root = eraseAt(m_root, p, found);
+        return found;
+    }
+    void chain(std::vector<Point> &out) const
+    {
+        if (m_root >= 0) appendChain(m_root, -1, -1, out);
+    }
+    void clear()
+    {
+        m_nodes.clear();
+        m_free.clear();
+        m_root = -1;
+    }
+
+private:
+    struct Node {
+        Point p;              // 叶子：点；内部结点：不使用
+        Point lo, hi;         // 子树中字典序最小、最大的点
+        int left = -1, right = -1;
+        int bridgeL = -1;     // 桥的左端点（左子树中的叶子）
+        int bridgeR = -1;     // 桥的右端点（右子树中的叶子）
+        int size = 1;         // 子树中的叶子数
+        int multiplicity = 1; // 叶子：重复插入的次数
+        bool leaf() const { return left < 0; }
+    };
+
+    int newNode()
+    {
+        if (!m_free.empty()) {
+            const int id = m_free.back();
+            m_free.pop_back();
+            m_nodes[id] = Node();
+            return id;
+        }
+        m_nodes.emplace_back();
+        return static_cast<int>(m_nodes.size()) - 1;
+    }
+
+    int newLeaf(const Point &p)
+    {
+        const int id = newNode();
+        m_nodes[id].p = m_nodes[id].lo = m_nodes[id].hi = p;
+        return id;
+    }
+
+    int newInternal(int left, int right)
+    {
+        const int id = newNode();
+        m_nodes[id].left = left;
+        m_nodes[id].right = right;
+        pull(id);
+        return id;
+    }
+
+    const Point &pt(int leaf) const { return m_nodes[leaf].p; }
+
+    //由两个子结点重新计算结点的汇总信息与桥
+    void pull(int v)
+    {
+        Node &n = m_nodes[v];
+        const Node &l = m_nodes[n.left];
+        const Node &r = m_nodes[n.right];
+        n.size = l.size + r.size;
+        n.lo = l.lo;
+        n.hi = r.hi;
+        const std::pair<int, int> b = findBridge(n.left, n.right);
+        m_nodes[v].bridgeL = b.first;
+        m_nodes[v].bridgeR = b.second;
+    }
+
+    /**
+     * @brief 沿着有效范围下降：结点的桥不在 [lo, hi] 内时，直接进入包含该范围的子树
+     * @details lo、hi 都是当前所求凸链上的顶点，而子树凸链的顶点要么不超过桥的左端点，
+     * 要么不小于桥的右端点，因此只需与桥的两个端点比较。
+     */
+    void narrow(int &v, int lo, int hi) const
+    {
+        while (!m_nodes[v].leaf()) {
+            const Node &n = m_nodes[v];
+            if (hi >= 0 && !lexLess(pt(n.bridgeL), pt(hi))) v = n.left;
+            else if (lo >= 0 && !lexLess(pt(lo), pt(n.bridgeR))) v = n.right;
+            else break;
+        }
+    }
+
+    /**
+     * @brief 求左右两棵子树上凸链之间的桥（Overmars–van Leeuwen 的同时下降）
+     * @details 设 a1a2、b1b2 分别是左、右两条链上当前考察的边（叶子时退化为一个点），
+     * 所求桥为 pq。可以证明：右侧点集中有点位于直线 a1a2 上方或线上，当且仅当 q 如此，
+     * 此时 p 不在 a2 右侧（共线时取更远的 a1 一侧，使结果不含共线点）；否则 p 不在 a1 左侧。
+     * 右链一侧对称。当两条边都严格位于对方直线下方时，比较两条直线交点与左右两组点的分界：
+     * 交点在左侧则 p 在 a2 右侧，否则 q 在 b1 左侧。每一步至少有一侧下降一层。
+     * @return 桥的左、右端点（叶子下标）
+     * @complexity O(log n)
+     */
+    std::pair<int, int> findBridge(int a, int b) const
+    {
+        const Point split{(m_nodes[a].hi.x + m_nodes[b].lo.x) / 2, (m_nodes[a].hi.y + m_nodes[b].lo.y) / 2};
+        int aLo = -1, aHi = -1, bLo = -1, bHi = -1;
+        for (;;) {
+            narrow(a, aLo, aHi);
+            narrow(b, bLo, bHi);
+            const Node &na = m_nodes[a];
+            const Node &nb = m_nodes[b];
+            if (na.leaf() && nb.leaf()) return {a, b};
+
+            if (na.leaf()) {
+                if (crossProduct(pt(nb.bridgeL), pt(nb.bridgeR), na.p) >= 0) { bLo = nb.bridgeR; b = nb.right; }
+                else { bHi = nb.bridgeL; b = nb.left; }
+                continue;
+            }
+            if (nb.leaf()) {
+                if (crossProduct(pt(na.bridgeL), pt(na.bridgeR), nb.p) >= 0) { aHi = na.bridgeL; a = na.left; }
+                else { aLo = na.bridgeR; a = na.right; }
+                continue;
+            }
+
+            const Point &a1 = pt(na.bridgeL), &a2 = pt(na.bridgeR);
+            const Point &b1 = pt(nb.bridgeL), &b2 = pt(nb.bridgeR);
+            const bool qAbove = crossProduct(a1, a2, b1) >= 0 || crossProduct(a1, a2, b2) >= 0;
+            const bool pAbove = crossProduct(b1, b2, a1) >= 0 || crossProduct(b1, b2, a2) >= 0;
+            if (qAbove || pAbove) {
+                if (qAbove) { aHi = na.bridgeL; a = na.left; }
+                if (pAbove) { bLo = nb.bridgeR; b = nb.right; }
+                continue;
+            }
+
+            //两条边都严格位于对方直线下方：两直线必然相交
+            const Point da = a2 - a1, db = b2 - b1;
+            const double t = ((b1.x - a1.x) * db.y - (b1.y - a1.y) * db.x) / (da.x * db.y - da.y * db.x);
+            const Point cross{a1.x + t * da.x, a1.y + t * da.y};
+            if (!lexLess(split, cross)) { aLo = na.bridgeR; a = na.right; }
+            else { bHi = nb.bridgeL; b = nb.left; }
+        }
+    }
+
+    //子树失衡：较小一侧的叶子数不足四分之一
+    bool unbalanced(int v) const
+    {
+        const Node &n = m_nodes[v];
+        const int smaller = std::min(m_nodes[n.left].size, m_nodes[n.right].size);
+        return n.size >= 4 && 4 * smaller < n.size;
+    }
+
+    void collectLeaves(int v, std::vector<int> &leaves)
+    {
+        if (m_nodes[v].leaf()) {
+            leaves.push_back(v);
+            return;
+        }
+        collectLeaves(m_nodes[v].left, leaves);
+        collectLeaves(m_nodes[v].right, leaves);
+        m_free.push_back(v);
+    }
+
+    int build(const std::vector<int> &leaves, std::size_t first, std::size_t last)
+    {
+        if (last - first == 1) return leaves[first];
+        const std::size_t mid = first + (last - first) / 2;
+        const int left = build(leaves, first, mid);
+        const int right = build(leaves, mid, last);
+        return newInternal(left, right);
+    }
+
+    //把子树重建为完全平衡的形状，重建 k 个叶子耗时 O(k log k)
+    int rebuild(int v)
+    {
+        std::vector<int> leaves;
+        leaves.reserve(m_nodes[v].size);
+        collectLeaves(v, leaves);
+        return build(leaves, 0, leaves.size());
+    }
+
+    int insertAt(int v, const Point &p)
+    {
+        if (v < 0) return newLeaf(p);
+        if (m_nodes[v].leaf()) {
+            if (m_nodes[v].p == p) {
+                ++m_nodes[v].multiplicity;
+                return v;
+            }
+            const int u = newLeaf(p);
+            return lexLess(p, m_nodes[v].p) ? newInternal(u, v) : newInternal(v, u);
+        }
+        if (lexLess(m_nodes[m_nodes[v].left].hi, p)) {
+            const int child = insertAt(m_nodes[v].right, p);
+            m_nodes[v].right = child;
+        } else {
+            const int child = insertAt(m_nodes[v].left, p);
+            m_nodes[v].left = child;
+        }
+        pull(v);
+        return unbalanced(v) ? rebuild(v) : v;
+    }
+
+    int eraseAt(int v, const Point &p, bool &found)
+    {
+        if (v < 0) return v;
+        if (m_nodes[v].leaf()) {
+            if (m_nodes[v].p != p) return v;
+            found = true;
+            if (--m_nodes[v].multiplicity > 0) return v;
+            m_free.push_back(v);
+            return -1;
+        }
+        const bool goRight = lexLess(m_nodes[m_nodes[v].left].hi, p);
+        const int child = eraseAt(goRight ? m_nodes[v].right : m_nodes[v].left, p, found);
+        if (child < 0) {
+            //子结点整个被删除，用兄弟结点顶替当前结点
+            const int sibling = goRight ? m_nodes[v].left : m_nodes[v].right;
+            m_free.push_back(v);
+            return sibling;
+        }
+        if (goRight) m_nodes[v].right = child;
+        else m_nodes[v].left = child;
+        pull(v);
+        return unbalanced(v) ? rebuild(v) : v;
+    }
+
+    //输出子树 v 的凸链上位于 [lo, hi] 之间（-1 表示不限）的顶点
+    void appendChain(int v, int lo, int hi, std::vector<Point> &out) const
+    {
+        narrow(v, lo, hi);
+        const Node &n = m_nodes[v];
+        if (n.leaf()) {
+            out.push_back(n.p);
+            return;
+        }
+        appendChain(n.left, lo, n.bridgeL, out);
+        appendChain(n.right, n.bridgeR, hi, out);
+    }
+
+    std::vector<Node> m_nodes;
+    std::vector<int> m_free;
+    int m_root = -1;
+};
+
+DynamicHull::DynamicHull()
+    : m_upper(new ChainTree), m_lower(new ChainTree)
+{
+}
+
+DynamicHull::~DynamicHull() = default;
+DynamicHull::DynamicHull(DynamicHull &&) noexcept = default;
+DynamicHull &DynamicHull::operator=(DynamicHull &&) noexcept = default;
+
+void DynamicHull::insert(const Point &p)
+{
+    m_upper->insert(p);
+    m_lower->insert(mirrored(p));
+    ++m_count;
+}
+
+bool DynamicHull::erase(const Point &p)
+{
+    if (!m_upper->erase(p)) return false;
+    m_lower->erase(mirrored(p));
+    --m_count;
+    return true;
+}
+
+/**
+ * @brief 拼接上下两条链得到凸包
+ * @details 下链（由 y 取反的上链还原）从 (minX, maxY) 出发，若左端有竖直边则先去掉它的起点，
+ * 使凸包从字典序最小点开始；随后逆序接上上链，并去掉两条链共有的端点。
+ * @complexity O(h log n)
+ */
+std::vector<Point> DynamicHull::hull() const
+{
+    std::vector<Point> lower, upper;
+    m_lower->chain(lower);
+    m_upper->chain(upper);
+    if (lower.empty()) return {};
+    for (Point &p : lower) p = mirrored(p);
+
+    std::vector<Point> out;
+    out.reserve(lower.size() + upper.size());
+    const std::size_t start = (lower.size() > 1 && lower[0].x == lower[1].x) ? 1 : 0;
+    out.insert(out.end(), lower.begin() + start, lower.end());
+    for (auto it = upper.rbegin(); it != upper.rend(); ++it) {
+        if (*it != out.back()) out.push_back(*it);
+    }
+    while (out.size() > 1 && out.back() == out.front()) out.pop_back();
+    return out;
+}
+
+void DynamicHull::clear()
+{
+    m_upper->clear();
+    m_lower->clear();
+    m_count = 0;
+}
+
+} // namespace Geometry
@@ -0,0 +1,51 @@
+#ifndef DYNAMICHULL_H
+#define DYNAMICHULL_H
+/*DynamicHull 是同时支持插入与删除的全动态凸包（Overmars–van Leeuwen 结构的简化版本）*/
+#include "GeometryTypes.h"
+#include <memory>
+
+namespace Geometry {
+
+/**
+ * @brief 全动态凸包：点可以随时加入或移除
+ * @details 点按字典序存放在一棵以叶子存储数据的平衡二叉树中。每个内部结点只记录
+ * 左右子树的上凸链之间的“桥”（公共上切线的两个端点），子树的上凸链由此隐式给出：
+ * 左子树的链走到桥的左端点，再从桥的右端点接上右子树的链。
+ * 插入或删除一个点后，只需自底向上重新计算路径上各结点的桥，每座桥通过在两棵子树中
+ * 同时下降求得，耗时 O(log n)。下凸链对 y 取反后复用同一套结构。
+ * 树的平衡采用按权重的部分重建（替罪羊式），因此插入、删除的均摊复杂度为 O(log² n)。
+ * 重复的点只计数，不重复存储。
+ */
+class DynamicHull
+{
+public:
+    DynamicHull();
+    ~DynamicHull();
+    DynamicHull(DynamicHull &&) noexcept;
+    DynamicHull &operator=(DynamicHull &&) noexcept;
+    DynamicHull(const DynamicHull &) = delete;
+    DynamicHull &operator=(const DynamicHull &) = delete;
+
+    // 加入一个点，均摊 O(log² n)
+    void insert(const Point &p);
+
+    // 移除一个点（若有重复只移除一份），点不存在时返回 false；均摊 O(log² n)
+    bool erase(const Point &p);
+
+    // 与 convexHullAndrew 相同的顺序输出凸包顶点（逆时针，不含共线点），O(h log n)
+    std::vector<Point> hull() const;
+
+    std::size_t pointCount() const { return m_count; } // 当前点数（含重复）
+    bool empty() const { return m_count == 0; }
+    void clear();
+
+private:
+    class ChainTree;
+    std::unique_ptr<ChainTree> m_upper;
+    std::unique_ptr<ChainTree> m_lower; // 存放 (x, -y)
+    std::size_t m_count = 0;
+};
+
+} // namespace Geometry
+
+#endif // DYNAMICHULL_H
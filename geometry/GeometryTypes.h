@@ -0,0 +1,75 @@
+#ifndef GEOMETRYTYPES_H
+#define GEOMETRYTYPES_H
+/*GeometryTypes 定义几何库的基础数据类型，不依赖任何 Qt 模块*/
+/*批处理服务与 DrawingWidget 共用这一套类型，界面层只负责 QPointF <-> Point 的转换*/
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Geometry {
+
+//二维点，布局等价于两个连续的 double
+struct Point {
+    double x = 0.0;
+    double y = 0.0;
+};
+
+inline bool operator==(const Point &a, const Point &b) { return a.x == b.x && a.y == b.y; }
+inline bool operator!=(const Point &a, const Point &b) { return !(a == b); }
+inline Point operator-(const Point &a, const Point &b) { return {a.x - b.x, a.y - b.y}; }
+inline Point operator+(const Point &a, const Point &b) { return {a.x + b.x, a.y + b.y}; }
+
+/**
+ * @brief 只读的连续内存视图（C++17 下 std::span 的最小替代）
+ * @details 不拥有数据，只保存首地址和长度。任何提供 data()/size() 的连续容器
+ * （std::vector、std::array 等）都可以隐式转换为 Span，避免在库接口处拷贝点集。
+ */
+template <typename T>
+class Span {
+public:
+    Span() = default;
+    Span(const T *data, std::size_t size) : m_data(data), m_size(size) {}
+    template <typename Container,
+              typename = decltype(std::declval<const Container &>().data()),
+              typename = decltype(std::declval<const Container &>().size())>
+    Span(const Container &c) : m_data(c.data()), m_size(static_cast<std::size_t>(c.size())) {}
+
+    const T *data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    const T *begin() const { return m_data; }
+    const T *end() const { return m_data + m_size; }
+    const T &operator[](std::size_t i) const { return m_data[i]; }
+    const T &front() const { return m_data[0]; }
+    const T &back() const { return m_data[m_size - 1]; }
+
+private:
+    const T *m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+using PointSpan = Span<Point>;
+using Polygon = std::vector<Point>;
+
+//带孔洞的多边形：一个外边界（逆时针）和若干孔洞（顺时针）
+struct PolygonWithHoles {
+    Polygon outer;
+    std::vector<Polygon> holes;
+};
+
+//三角剖分结果中的一个三角形（按值保存三个顶点）
+struct Triangle {
+    Point p1, p2, p3;
+    bool contains(const Point &pt) const;
+};
+
+//以顶点下标表示的三角网格：相邻三角形共享顶点，便于有限元、渲染等下游程序直接使用
+struct TriangleMesh {
+    std::vector<Point> vertices;
+    std::vector<std::array<int, 3>> triangles; // 每个三角形的三个顶点下标（逆时针）
+};
+
+} // namespace Geometry
+
+#endif // GEOMETRYTYPES_H
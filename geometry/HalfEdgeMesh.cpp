@@ -0,0 +1,59 @@
+#include "HalfEdgeMesh.h"
+#include <algorithm>
+
+namespace Geometry {
+
+/**
+ * @brief 建立半边邻接
+ * @details 先按起点做计数排序得到每个顶点的出边桶（CSR），桶内按终点排序；
+ * 半边 a→b 的反向半边就在 b 的桶里，二分查找终点为 a 的那条。找不到的半边是区域边界。
+ * 耳切法桥接孔洞时桥边的两端在合并环中出现两次，但用的是同一个顶点下标，所以桥边两侧仍然互为反向半边。
+ * @param mesh [in,out] 读取 vertices、indices，写入 twins
+ * @complexity O(T log d)，T 为三角形数，d 为最大顶点度数
+ */
+void buildHalfEdges(HalfEdgeMesh &mesh)
+{
+    const std::size_t halfEdges = mesh.indices.size();
+    const std::size_t n = mesh.vertices.size();
+    mesh.twins.assign(halfEdges, HalfEdgeMesh::kBoundary);
+
+    std::vector<std::uint32_t> start(n + 1, 0);
+    for (std::uint32_t v : mesh.indices) ++start[v + 1];
+    for (std::size_t v = 0; v < n; ++v) start[v + 1] += start[v];
+    std::vector<std::uint32_t> bucket(halfEdges);
+    std::vector<std::uint32_t> fill(start.begin(), start.end() - 1);
+    for (std::uint32_t h = 0; h < halfEdges; ++h) bucket[fill[mesh.indices[h]]++] = h;
+    auto byTarget = [&](std::uint32_t g, std::uint32_t h) { return mesh.target(g) < mesh.target(h); };
+    for (std::size_t v = 0; v < n; ++v) {
+        if (start[v + 1] - start[v] > 1) std::sort(bucket.begin() + start[v], bucket.begin() + start[v + 1], byTarget);
+    }
+
+    for (std::uint32_t h = 0; h < halfEdges; ++h) {
+        if (mesh.twins[h] != HalfEdgeMesh::kBoundary) continue;
+        const std::uint32_t a = mesh.origin(h), b = mesh.target(h);
+        const auto first = bucket.begin() + start[b], last = bucket.begin() + start[b + 1];
+        const auto it = std::lower_bound(first, last, a, [&](std::uint32_t g, std::uint32_t v) { return mesh.target(g) < v; });
+        if (it == last || mesh.target(*it) != a || mesh.twins[*it] != HalfEdgeMesh::kBoundary) continue;
+        mesh.twins[h] = *it;
+        mesh.twins[*it] = h;
+    }
+}
+
+/**
+ * @brief 把 TriangleMesh 转换为半边网格
+ * @param mesh 带下标的三角网格（顶点共享）
+ * @return 顶点原样拷贝、下标转为 uint32 并建立好邻接的半边网格
+ */
+HalfEdgeMesh toHalfEdgeMesh(const TriangleMesh &mesh)
+{
+    HalfEdgeMesh out;
+    out.vertices = mesh.vertices;
+    out.indices.reserve(mesh.triangles.size() * 3);
+    for (const auto &t : mesh.triangles) {
+        for (int v : t) out.indices.push_back(static_cast<std::uint32_t>(v));
+    }
+    buildHalfEdges(out);
+    return out;
+}
+
+} // namespace Geometry
@@ -0,0 +1,44 @@
+#ifndef HALFEDGEMESH_H
+#define HALFEDGEMESH_H
+/*HalfEdgeMesh 是三角剖分的索引网格输出：共享的顶点缓冲、每个三角形三个 uint32 下标，以及半边邻接*/
+#include "GeometryTypes.h"
+#include <cstdint>
+
+namespace Geometry {
+
+/**
+ * @brief 以半边组织的三角网格
+ * @details 三角形 t 的三条半边编号为 3t、3t+1、3t+2，半边 h 从顶点 indices[h] 指向同一三角形的下一个顶点；
+ * twins[h] 是相邻三角形中方向相反的那条半边，没有相邻三角形时为 kBoundary，即区域的边界（外边界或孔洞）。
+ * 每个三角形占 12 字节下标与 12 字节邻接，顶点只存一份；按值保存三个 QPointF 则需要 48 字节。
+ */
+struct HalfEdgeMesh {
+    static constexpr std::uint32_t kBoundary = 0xFFFFFFFFu;
+
+    std::vector<Point> vertices;
+    std::vector<std::uint32_t> indices; // 每个三角形三个顶点下标（逆时针）
+    std::vector<std::uint32_t> twins;   // 每条半边的反向半边，边界为 kBoundary
+
+    std::size_t triangleCount() const { return indices.size() / 3; }
+    bool empty() const { return indices.empty(); }
+
+    static std::uint32_t next(std::uint32_t h) { return h % 3 == 2 ? h - 2 : h + 1; }
+    static std::uint32_t prev(std::uint32_t h) { return h % 3 == 0 ? h + 2 : h - 1; }
+    std::uint32_t origin(std::uint32_t h) const { return indices[h]; }
+    std::uint32_t target(std::uint32_t h) const { return indices[next(h)]; }
+
+    // 边界判定 O(1)
+    bool isBoundary(std::uint32_t h) const { return twins[h] == kBoundary; }
+    // 半边 h 另一侧的三角形，边界时返回 kBoundary
+    std::uint32_t neighbor(std::uint32_t h) const { return isBoundary(h) ? kBoundary : twins[h] / 3; }
+};
+
+// 由 vertices 与 indices 建立 twins：半边按起点分桶、桶内按终点排序后二分查找反向半边，O(T log d)，d 为最大度数
+void buildHalfEdges(HalfEdgeMesh &mesh);
+
+// 把 constrainedDelaunay 等输出的 TriangleMesh 转换为半边网格
+HalfEdgeMesh toHalfEdgeMesh(const TriangleMesh &mesh);
+
+} // namespace Geometry
+
+#endif // HALFEDGEMESH_H
@@ -0,0 +1,137 @@
+#include "IncrementalHull.h"
+#include "Predicates.h"
+#include <iterator>
+
+namespace Geometry {
+
+namespace {
+
+inline Point at(std::map<double, double>::const_iterator it)
+{
+    return {it->first, it->second};
+}
+
+inline Point mirrored(const Point &p)
+{
+    return {p.x, -p.y};
+}
+
+} // namespace
+
+/**
+ * @brief 把点插入一条上凸链（顶点按 x 递增，相邻三点严格右转）
+ * @details 1. 同一 x 已有更高（或相同）的点，新点不在链上；
+ * 2. 新点位于左右邻居连线的下方或线上，也不在链上；
+ * 3. 否则插入，并分别向左、向右删除不再严格右转的顶点。
+ * @return 链是否被修改
+ * @complexity 定位 O(log h)，删除均摊 O(1)
+ */
+bool IncrementalHull::insertUpper(Chain &chain, const Point &p)
+{
+    auto it = chain.lower_bound(p.x);
+    if (it != chain.end() && it->first == p.x) {
+        if (it->second >= p.y) return false;
+        it = chain.erase(it);
+    } else if (it != chain.end() && it != chain.begin()) {
+        if (crossProduct(at(std::prev(it)), at(it), p) <= 0) return false;
+    }
+
+    it = chain.emplace_hint(it, p.x, p.y);
+
+    //向左：p 的左邻居若不再是严格右转的拐点，就删除
+    while (it != chain.begin()) {
+        const auto left = std::prev(it);
+        if (left == chain.begin()) break;
+        if (crossProduct(at(std::prev(left)), at(left), p) < 0) break;
+        chain.erase(left);
+    }
+    //向右：同理
+    for (;;) {
+        const auto right = std::next(it);
+        if (right == chain.end()) break;
+        const auto rightRight = std::next(right);
+        if (rightRight == chain.end()) break;
+        if (crossProduct(p, at(right), at(rightRight)) < 0) break;
+        chain.erase(right);
+    }
+    return true;
+}
+
+/**
+ * @brief 判断点是否位于上凸链的下方或链上（仅考虑链的 x 范围之内）
+ */
+bool IncrementalHull::belowUpper(const Chain &chain, const Point &p)
+{
+    if (chain.empty() || p.x < chain.begin()->first || p.x > chain.rbegin()->first) return false;
+    const auto it = chain.lower_bound(p.x);
+    if (it->first == p.x) return p.y <= it->second;
+    return crossProduct(at(std::prev(it)), at(it), p) <= 0;
+}
+
+/**
+ * @brief 在线插入一个点
+ * @param p 新点
+ * @return 凸包是否改变
+ * @complexity 均摊 O(log h)
+ */
+bool IncrementalHull::insert(const Point &p)
+{
+    ++m_count;
+    const bool upperChanged = insertUpper(m_upper, p);
+    const bool lowerChanged = insertUpper(m_lower, mirrored(p));
+    return upperChanged || lowerChanged;
+}
+
+bool IncrementalHull::insert(PointSpan points)
+{
+    bool changed = false;
+    for (const Point &p : points) changed = insert(p) || changed;
+    return changed;
+}
+
+/**
+ * @brief 判断点是否在当前凸包内（含边界）
+ * @complexity O(log h)
+ */
+bool IncrementalHull::contains(const Point &p) const
+{
+    return belowUpper(m_upper, p) && belowUpper(m_lower, mirrored(p));
+}
+
+/**
+ * @brief 输出凸包顶点
+ * @details 先沿下链从左到右，再沿上链从右到左；两条链在最左、最右的 x 上
+ * 若是同一个点则只输出一次，否则两点之间就是一条竖直的凸包边。
+ * @complexity O(h)
+ */
+std::vector<Point> IncrementalHull::hull() const
+{
+    std::vector<Point> out;
+    if (m_upper.empty()) return out;
+    out.reserve(m_upper.size() + m_lower.size());
+    for (const auto &v : m_lower) out.push_back({v.first, -v.second});
+    for (auto it = m_upper.rbegin(); it != m_upper.rend(); ++it) {
+        const Point p{it->first, it->second};
+        if (p != out.back()) out.push_back(p);
+    }
+    if (out.size() > 1 && out.back() == out.front()) out.pop_back();
+    return out;
+}
+
+std::size_t IncrementalHull::hullSize() const
+{
+    if (m_upper.empty()) return 0;
+    const bool leftShared = m_upper.begin()->second == -m_lower.begin()->second;
+    const bool rightShared = m_upper.rbegin()->second == -m_lower.rbegin()->second;
+    if (m_upper.size() == 1) return leftShared ? 1 : 2; // 所有点的 x 相同
+    return m_upper.size() + m_lower.size() - leftShared - rightShared;
+}
+
+void IncrementalHull::clear()
+{
+    m_upper.clear();
+    m_lower.clear();
+    m_count = 0;
+}
+
+} // namespace Geometry
@@ -0,0 +1,50 @@
+#ifndef INCREMENTALHULL_H
+#define INCREMENTALHULL_H
+/*IncrementalHull 在线维护点集的凸包：点逐个到达，每次插入只做局部修改，无需整体重算*/
+#include "GeometryTypes.h"
+#include <map>
+
+namespace Geometry {
+
+/**
+ * @brief 只支持插入的在线凸包
+ * @details 把凸包拆成上、下两条关于 x 单调的链，分别存放在以 x 为键的有序表中
+ * （同一 x 只保留最外侧的点）。插入时二分定位 x，判断新点是否在链外，
+ * 若在链外则加入并向两侧删除变得不再凸的顶点。每个点至多被删除一次，
+ * 因此单次插入的均摊复杂度为 O(log h)。
+ * 结果与 convexHullAndrew 一致：从字典序最小点出发逆时针排列，不含共线点。
+ */
+class IncrementalHull
+{
+public:
+    // 插入一个点，返回凸包是否因此改变（点落在凸包内部或边上时返回 false）
+    bool insert(const Point &p);
+
+    // 依次插入一批点（例如来自数据流的一段），返回凸包是否改变
+    bool insert(PointSpan points);
+
+    // 判断点是否在当前凸包内部或边界上，O(log h)
+    bool contains(const Point &p) const;
+
+    // 按与 convexHullAndrew 相同的顺序输出凸包顶点，O(h)
+    std::vector<Point> hull() const;
+
+    std::size_t hullSize() const;                      // 凸包顶点数 h，O(1)
+    std::size_t pointCount() const { return m_count; } // 累计插入的点数
+    bool empty() const { return m_count == 0; }
+    void clear();
+
+private:
+    //上链：x -> y；下链存为 x -> -y，两条链共用同一套“上凸链”逻辑
+    using Chain = std::map<double, double>;
+    static bool insertUpper(Chain &chain, const Point &p);
+    static bool belowUpper(const Chain &chain, const Point &p);
+
+    Chain m_upper;
+    Chain m_lower;
+    std::size_t m_count = 0;
+};
+
+} // namespace Geometry
+
+#endif // INCREMENTALHULL_H
@@ -0,0 +1,150 @@
+#include "IncrementalPolygon.h"
+#include "Predicates.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Geometry {
+
+namespace {
+constexpr std::size_t kNoEdge = static_cast<std::size_t>(-1);
+} // namespace
+
+IncrementalPolygon::CellKey IncrementalPolygon::cellKey(std::int64_t cx, std::int64_t cy)
+{
+    return (static_cast<CellKey>(static_cast<std::uint32_t>(cx)) << 32) | static_cast<std::uint32_t>(cy);
+}
+
+/**
+ * @brief 枚举线段 ab 穿过的所有格子
+ * @details 按列扫描：在每一列的 x 范围内求线段的 y 范围，覆盖其间的格子。
+ * 范围向外放宽一点，使恰好落在格线上的端点或交点不会因舍入只登记到一侧。
+ */
+template <typename Visit>
+void IncrementalPolygon::forEachCell(const Point &a, const Point &b, Visit visit) const
+{
+    const double pad = m_cellSize * 1e-9;
+    const Point &lo = a.x <= b.x ? a : b;
+    const Point &hi = a.x <= b.x ? b : a;
+    const auto cell = [&](double v) { return static_cast<std::int64_t>(std::floor(v / m_cellSize)); };
+    const std::int64_t firstColumn = cell(lo.x - pad), lastColumn = cell(hi.x + pad);
+    for (std::int64_t cx = firstColumn; cx <= lastColumn; ++cx) {
+        double y0 = lo.y, y1 = hi.y;
+        if (hi.x > lo.x) {
+            const double x0 = std::max(lo.x, cx * m_cellSize), x1 = std::min(hi.x, (cx + 1) * m_cellSize);
+            const double slope = (hi.y - lo.y) / (hi.x - lo.x);
+            y0 = lo.y + (x0 - lo.x) * slope;
+            y1 = lo.y + (x1 - lo.x) * slope;
+        }
+        const std::int64_t firstRow = cell(std::min(y0, y1) - pad), lastRow = cell(std::max(y0, y1) + pad);
+        for (std::int64_t cy = firstRow; cy <= lastRow; ++cy) visit(cellKey(cx, cy));
+    }
+}
+
+/**
+ * @brief 检查线段 ab 与已登记的边是否冲突
+ * @param before 与 ab 在起点 a 处相邻的边（只检查折返），没有时为 kNoEdge
+ * @param after 与 ab 在终点 b 处相邻的边（只检查折返），没有时为 kNoEdge
+ * @return 第一条冲突的边的编号
+ */
+std::optional<std::size_t> IncrementalPolygon::findEdgeConflict(const Point &a, const Point &b, std::size_t before,
+                                                                std::size_t after) const
+{
+    if (++m_query == 0) { //序号回绕时清零，避免误判为已检查
+        std::fill(m_visited.begin(), m_visited.end(), 0u);
+        m_query = 1;
+    }
+    std::optional<std::size_t> conflict;
+    forEachCell(a, b, [&](CellKey key) {
+        if (conflict) return;
+        const auto it = m_cells.find(key);
+        if (it == m_cells.end()) return;
+        for (std::uint32_t e : it->second) {
+            if (m_visited[e] == m_query) continue;
+            m_visited[e] = m_query;
+            const Point &p = m_vertices[e], &q = m_vertices[m_edgeEnd[e]];
+            bool hit;
+            if (e == before) hit = edgesFoldBack(p, a, b);       // p→a 与 a→b
+            else if (e == after) hit = edgesFoldBack(a, b, q);   // a→b 与 b→q
+            else hit = edgesIntersect(a, b, p, q);
+            if (hit) {
+                conflict = e;
+                return;
+            }
+        }
+    });
+    return conflict;
+}
+
+/**
+ * @brief 检查追加顶点 p 是否会破坏简单性
+ * @details 新边与上一条边相邻，只检查是否折返；与其余的边检查是否相交或重合。
+ * @complexity 期望 O(1 + k)，k 为新边穿过的格子中登记的边数
+ */
+std::optional<std::size_t> IncrementalPolygon::findConflict(const Point &p) const
+{
+    const std::size_t n = m_vertices.size();
+    if (n == m_ringStart) return std::nullopt; //新环的第一个顶点还没有边
+    if (p == m_vertices.back()) return kZeroLength;
+    return findEdgeConflict(m_vertices.back(), p, n - m_ringStart >= 2 ? n - 2 : kNoEdge, kNoEdge);
+}
+
+/**
+ * @brief 检查闭合边是否破坏简单性
+ * @details 闭合边与最后一条边、第一条边相邻，其余的边须与它不相交。
+ */
+std::optional<std::size_t> IncrementalPolygon::findClosingConflict() const
+{
+    const std::size_t n = m_vertices.size();
+    if (n - m_ringStart < 3) return std::nullopt;
+    const Point &first = m_vertices[m_ringStart];
+    if (m_vertices.back() == first) return kZeroLength;
+    return findEdgeConflict(m_vertices.back(), first, n - 2, m_ringStart);
+}
+
+/**
+ * @brief 追加顶点，并把新边 (n-2 号边) 登记到它穿过的格子中；当前环的第一个顶点不产生边
+ */
+void IncrementalPolygon::append(const Point &p)
+{
+    m_vertices.push_back(p);
+    m_edgeEnd.push_back(0);
+    m_visited.push_back(0);
+    const std::size_t n = m_vertices.size();
+    if (n - m_ringStart < 2) return;
+    const std::uint32_t e = static_cast<std::uint32_t>(n - 2);
+    m_edgeEnd[e] = e + 1;
+    forEachCell(m_vertices[e], p, [&](CellKey key) { m_cells[key].push_back(e); });
+}
+
+/**
+ * @brief 登记当前环最后一个顶点指回第一个顶点的闭合边，并开始新环
+ */
+void IncrementalPolygon::closeRing()
+{
+    const std::size_t n = m_vertices.size();
+    if (n - m_ringStart >= 3) {
+        const std::uint32_t e = static_cast<std::uint32_t>(n - 1);
+        m_edgeEnd[e] = static_cast<std::uint32_t>(m_ringStart);
+        forEachCell(m_vertices[e], m_vertices[m_ringStart], [&](CellKey key) { m_cells[key].push_back(e); });
+    }
+    m_ringStart = n;
+}
+
+bool IncrementalPolygon::tryAppend(const Point &p)
+{
+    if (findConflict(p)) return false;
+    append(p);
+    return true;
+}
+
+void IncrementalPolygon::clear()
+{
+    m_vertices.clear();
+    m_edgeEnd.clear();
+    m_ringStart = 0;
+    m_cells.clear();
+    m_visited.clear();
+    m_query = 0;
+}
+
+} // namespace Geometry
@@ -0,0 +1,69 @@
+#ifndef INCREMENTALPOLYGON_H
+#define INCREMENTALPOLYGON_H
+/*IncrementalPolygon 逐个顶点地构建多边形，并在每次追加时检查新边是否与已有的边相交，使折线始终保持简单*/
+#include "GeometryTypes.h"
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+
+namespace Geometry {
+
+/**
+ * @brief 保持简单性的增量多边形
+ * @details 已有的边登记在均匀网格的哈希表中（每条边登记在它穿过的所有格子里）。
+ * 追加顶点时只取新边穿过的格子里的边做精确判定，因此单次检查的代价只与新边附近的边数有关，
+ * 与多边形的总边数无关；手绘多边形的边长有限，期望为 O(1)。
+ * 判定规则与 isSimplePolygon 相同：相邻边不得沿同一直线折返，不相邻边不得相交或重合，不得出现零长度边。
+ * 开放折线上的边对在追加时逐一检查过，闭合时只需检查首尾相连的那条边。
+ * 调用 closeRing 后再追加的顶点开始一个新环，新环的边同样与之前所有环的边做检查，可用于外边界加孔洞的输入；
+ * 不同环之间只检查边，共用顶点、环的包含关系需另行检查（见 isSimplePolygonWithHoles）。
+ */
+class IncrementalPolygon
+{
+public:
+    static constexpr std::size_t kZeroLength = static_cast<std::size_t>(-1); // 冲突原因是零长度边（与相邻顶点重合）
+
+    explicit IncrementalPolygon(double cellSize = 32.0) : m_cellSize(cellSize) {}
+
+    // 若追加顶点 p 会使新边 (最后一个顶点, p) 与已有的边冲突，返回该边的编号（边 i 从顶点 i 出发，终点见 edgeEnd）
+    std::optional<std::size_t> findConflict(const Point &p) const;
+
+    // 当前环的闭合边 (最后一个顶点, 环的第一个顶点) 与已有的边冲突时返回该边的编号；环不足 3 个顶点时不检查
+    std::optional<std::size_t> findClosingConflict() const;
+
+    // 不做检查地登记当前环的闭合边，之后追加的顶点开始一个新环；环不足 3 个顶点时只开始新环
+    void closeRing();
+
+    // 无条件追加顶点并登记新边（不做检查）
+    void append(const Point &p);
+
+    // 没有冲突时追加顶点并返回 true，否则不改动并返回 false
+    bool tryAppend(const Point &p);
+
+    const std::vector<Point> &vertices() const { return m_vertices; }
+    // 边 e 的终点下标：同一环内为 e+1，闭合边为所在环的第一个顶点
+    std::size_t edgeEnd(std::size_t e) const { return m_edgeEnd[e]; }
+    std::size_t size() const { return m_vertices.size(); }
+    bool empty() const { return m_vertices.empty(); }
+    void clear();
+
+private:
+    using CellKey = std::uint64_t;
+    static CellKey cellKey(std::int64_t cx, std::int64_t cy);
+    template <typename Visit>
+    void forEachCell(const Point &a, const Point &b, Visit visit) const;
+    std::optional<std::size_t> findEdgeConflict(const Point &a, const Point &b, std::size_t before,
+                                                std::size_t after) const;
+
+    double m_cellSize;
+    std::vector<Point> m_vertices;
+    std::vector<std::uint32_t> m_edgeEnd; // 以顶点 i 为起点的边的终点
+    std::size_t m_ringStart = 0;          // 当前（未闭合）环的第一个顶点
+    std::unordered_map<CellKey, std::vector<std::uint32_t>> m_cells; // 格子 -> 穿过它的边
+    mutable std::vector<std::uint32_t> m_visited; // 每条边（按起点编号）最近一次被检查时的查询序号，避免重复判定
+    mutable std::uint32_t m_query = 0;
+};
+
+} // namespace Geometry
+
+#endif // INCREMENTALPOLYGON_H
@@ -0,0 +1,397 @@
+#include "IntersectionArea.h"
+#include "PolygonUtils.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <cmath>
+#include <memory>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GEOMETRY_HAVE_SSE2 1
+#endif
+
+// AVX2 版本单独以 avx2 目标编译，是否调用由 bestSimdLevel() 的运行时检测决定
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define GEOMETRY_HAVE_AVX2 1
+#define GEOMETRY_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#include <immintrin.h>
+#define GEOMETRY_HAVE_AVX2 1
+#define GEOMETRY_TARGET_AVX2
+#endif
+
+namespace Geometry {
+
+namespace {
+
+/**
+ * @brief 一条非竖直边在 x 方向上的投影
+ * @details 端点按 x 从小到大存放，y 已减去基线（两个多边形的最低点），因此边下方到基线之间的梯形面积非负。
+ * sign 取边实际走向的反号：从右往左的边为 +1，从左往右的边为 -1。
+ */
+struct SpanEdge {
+    double x0, y0, x1, y1;
+    double sign;
+
+    double at(double x) const
+    {
+        if (x == x0) return y0;
+        if (x == x1) return y1;
+        return y0 + (x - x0) / (x1 - x0) * (y1 - y0);
+    }
+};
+
+/**
+ * @brief 两条边在公共 x 区间上，较低者与基线之间的面积 ∫ min(e(x), f(x)) dx
+ * @details 两条都是线段，差值是线性函数：不变号时较低者就是同一条边，是一个梯形；
+ * 变号时在交点处分成两个梯形。
+ */
+inline double areaUnderBoth(const SpanEdge &e, const SpanEdge &f)
+{
+    const double left = std::max(e.x0, f.x0);
+    const double right = std::min(e.x1, f.x1);
+    if (!(right > left)) return 0.0;
+    const double eL = e.at(left), eR = e.at(right), fL = f.at(left), fR = f.at(right);
+    const double d0 = eL - fL, d1 = eR - fR;
+    const double lowL = std::min(eL, fL), lowR = std::min(eR, fR);
+    if ((d0 < 0 && d1 > 0) || (d0 > 0 && d1 < 0)) {
+        const double t = d0 / (d0 - d1);
+        const double xm = left + t * (right - left);
+        const double ym = eL + t * (eR - eL);
+        return 0.5 * ((xm - left) * (lowL + ym) + (right - xm) * (ym + lowR));
+    }
+    return 0.5 * (right - left) * (lowL + lowR);
+}
+
+double lowestY(PointSpan a, PointSpan b)
+{
+    double y = a[0].y;
+    for (const Point &p : a) y = std::min(y, p.y);
+    for (const Point &p : b) y = std::min(y, p.y);
+    return y;
+}
+
+inline bool lexLess(const Point &a, const Point &b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+/**
+ * @brief 凸多边形的一条 x 单调链，直接在原顶点数组上按下标行走
+ * @details 从字典序最小点出发，沿数组正向或反向走到字典序最大点；途经顶点的 x 单调不减。
+ * 正向链上的边与多边形边同向（从左往右），符号为 -1；反向链相反，符号为 +1。
+ */
+class ChainWalker
+{
+public:
+    ChainWalker(PointSpan poly, std::size_t first, std::size_t last, bool forward, double baseY)
+        : m_poly(poly), m_index(first), m_last(last), m_forward(forward), m_baseY(baseY)
+    {
+    }
+
+    bool done() const { return m_index == m_last; }
+    void advance() { m_index = nextIndex(); }
+
+    SpanEdge edge() const
+    {
+        const Point &a = m_poly[m_index];
+        const Point &b = m_poly[nextIndex()];
+        return {a.x, a.y - m_baseY, b.x, b.y - m_baseY, m_forward ? -1.0 : 1.0};
+    }
+
+private:
+    std::size_t nextIndex() const
+    {
+        const std::size_t n = m_poly.size();
+        return m_forward ? (m_index + 1 == n ? 0 : m_index + 1) : (m_index == 0 ? n - 1 : m_index - 1);
+    }
+
+    PointSpan m_poly;
+    std::size_t m_index;
+    std::size_t m_last;
+    bool m_forward;
+    double m_baseY;
+};
+
+//两条 x 单调链之间所有 x 投影重叠的边对，双指针归并，O(链长之和)
+double mergeChains(ChainWalker c, ChainWalker d)
+{
+    double sum = 0.0;
+    while (!c.done() && !d.done()) {
+        const SpanEdge e = c.edge(), f = d.edge();
+        sum += e.sign * f.sign * areaUnderBoth(e, f);
+        if (e.x1 <= f.x1) c.advance();
+        if (f.x1 <= e.x1) d.advance();
+    }
+    return sum;
+}
+
+//多边形的所有非竖直边，按左端点 x 排序
+std::vector<SpanEdge> spanEdges(PointSpan poly, double baseY)
+{
+    std::vector<SpanEdge> edges;
+    edges.reserve(poly.size());
+    for (std::size_t i = 0, n = poly.size(); i < n; ++i) {
+        const Point &a = poly[i];
+        const Point &b = poly[i + 1 == n ? 0 : i + 1];
+        if (a.x < b.x) edges.push_back({a.x, a.y - baseY, b.x, b.y - baseY, -1.0});
+        else if (b.x < a.x) edges.push_back({b.x, b.y - baseY, a.x, a.y - baseY, 1.0});
+    }
+    std::sort(edges.begin(), edges.end(), [](const SpanEdge &e, const SpanEdge &f) { return e.x0 < f.x0; });
+    return edges;
+}
+
+/**
+ * @brief 任意两个多边形：按左端点依次插入两边的边，与另一侧仍活跃的边逐对累加
+ * @details 每个 x 投影重叠的边对恰好在较晚开始的那条边插入时被计算一次；另一侧已经结束的边在此时移出活跃表。
+ */
+double sweepIntersectionArea(PointSpan polygonA, PointSpan polygonB, double baseY)
+{
+    const std::vector<SpanEdge> edgesA = spanEdges(polygonA, baseY);
+    const std::vector<SpanEdge> edgesB = spanEdges(polygonB, baseY);
+    std::vector<const SpanEdge *> activeA, activeB;
+    std::size_t ia = 0, ib = 0;
+    double sum = 0.0;
+    while (ia < edgesA.size() || ib < edgesB.size()) {
+        const bool fromA = ib == edgesB.size() || (ia < edgesA.size() && edgesA[ia].x0 <= edgesB[ib].x0);
+        const SpanEdge &e = fromA ? edgesA[ia++] : edgesB[ib++];
+        std::vector<const SpanEdge *> &own = fromA ? activeA : activeB;
+        std::vector<const SpanEdge *> &other = fromA ? activeB : activeA;
+        for (std::size_t k = 0; k < other.size();) {
+            if (other[k]->x1 <= e.x0) {
+                other[k] = other.back();
+                other.pop_back();
+                continue;
+            }
+            sum += e.sign * other[k]->sign * areaUnderBoth(e, *other[k]);
+            ++k;
+        }
+        own.push_back(&e);
+    }
+    return sum;
+}
+
+//批量任务的划分：每块若干对，各线程从共享计数器领取下一块，耗时不均的多边形对也能分摊
+template <typename PairFunction>
+void forEachPair(std::size_t count, unsigned threadCount, std::size_t minPerThread, PairFunction evaluate)
+{
+    const unsigned T = static_cast<unsigned>(
+        std::min<std::size_t>(ThreadPool::resolveThreadCount(threadCount), count / minPerThread));
+    if (T <= 1) {
+        evaluate(0, count);
+        return;
+    }
+
+    // 线程数超出共享线程池时，为本次计算单独建一个池
+    ThreadPool *pool = &ThreadPool::global();
+    std::unique_ptr<ThreadPool> ownPool;
+    if (T > pool->size()) {
+        ownPool = std::make_unique<ThreadPool>(T);
+        pool = ownPool.get();
+    }
+    const std::size_t block = std::max<std::size_t>(minPerThread / 8, 1);
+    const std::size_t blocks = (count + block - 1) / block;
+    std::atomic<std::size_t> next{0};
+    pool->parallelFor(T, [&](std::size_t) {
+        for (std::size_t k; (k = next.fetch_add(1, std::memory_order_relaxed)) < blocks;) {
+            evaluate(k * block, std::min(count, (k + 1) * block));
+        }
+    });
+}
+
+//与 _mm_min_pd / _mm_max_pd 相同的取值规则（相等或含 NaN 时取第二个操作数），保证标量与 SIMD 结果逐位相同
+inline double laneMin(double a, double b) { return a < b ? a : b; }
+inline double laneMax(double a, double b) { return a > b ? a : b; }
+
+//一对矩形的结果，运算顺序与 SIMD 版本一致
+template <bool Iou>
+inline double boxPair(double ax0, double ay0, double ax1, double ay1, double bx0, double by0, double bx1, double by1)
+{
+    const double w = laneMax(laneMin(ax1, bx1) - laneMax(ax0, bx0), 0.0);
+    const double h = laneMax(laneMin(ay1, by1) - laneMax(ay0, by0), 0.0);
+    const double inter = w * h;
+    if (!Iou) return inter;
+    const double areaA = laneMax(ax1 - ax0, 0.0) * laneMax(ay1 - ay0, 0.0);
+    const double areaB = laneMax(bx1 - bx0, 0.0) * laneMax(by1 - by0, 0.0);
+    const double uni = areaA + areaB - inter;
+    return uni > 0.0 ? inter / uni : 0.0;
+}
+
+template <bool Iou>
+void boxScalar(const BoxBatch &a, const BoxBatch &b, std::size_t begin, std::size_t end, double *out)
+{
+    for (std::size_t i = begin; i < end; ++i) {
+        out[i] = boxPair<Iou>(a.minX[i], a.minY[i], a.maxX[i], a.maxY[i], b.minX[i], b.minY[i], b.maxX[i], b.maxY[i]);
+    }
+}
+
+#ifdef GEOMETRY_HAVE_SSE2
+//每次 2 对
+template <bool Iou>
+void boxSse2(const BoxBatch &a, const BoxBatch &b, std::size_t begin, std::size_t end, double *out)
+{
+    const __m128d zero = _mm_setzero_pd();
+    std::size_t i = begin;
+    for (; i + 2 <= end; i += 2) {
+        const __m128d ax0 = _mm_loadu_pd(a.minX.data() + i), ay0 = _mm_loadu_pd(a.minY.data() + i);
+        const __m128d ax1 = _mm_loadu_pd(a.maxX.data() + i), ay1 = _mm_loadu_pd(a.maxY.data() + i);
+        const __m128d bx0 = _mm_loadu_pd(b.minX.data() + i), by0 = _mm_loadu_pd(b.minY.data() + i);
+        const __m128d bx1 = _mm_loadu_pd(b.maxX.data() + i), by1 = _mm_loadu_pd(b.maxY.data() + i);
+        const __m128d w = _mm_max_pd(_mm_sub_pd(_mm_min_pd(ax1, bx1), _mm_max_pd(ax0, bx0)), zero);
+        const __m128d h = _mm_max_pd(_mm_sub_pd(_mm_min_pd(ay1, by1), _mm_max_pd(ay0, by0)), zero);
+        __m128d result = _mm_mul_pd(w, h);
+        if (Iou) {
+            const __m128d areaA = _mm_mul_pd(_mm_max_pd(_mm_sub_pd(ax1, ax0), zero), _mm_max_pd(_mm_sub_pd(ay1, ay0), zero));
+            const __m128d areaB = _mm_mul_pd(_mm_max_pd(_mm_sub_pd(bx1, bx0), zero), _mm_max_pd(_mm_sub_pd(by1, by0), zero));
+            const __m128d uni = _mm_sub_pd(_mm_add_pd(areaA, areaB), result);
+            result = _mm_and_pd(_mm_cmpgt_pd(uni, zero), _mm_div_pd(result, uni));
+        }
+        _mm_storeu_pd(out + i, result);
+    }
+    boxScalar<Iou>(a, b, i, end, out);
+}
+#endif
+
+#ifdef GEOMETRY_HAVE_AVX2
+//每次 4 对
+template <bool Iou>
+GEOMETRY_TARGET_AVX2 void boxAvx2(const BoxBatch &a, const BoxBatch &b, std::size_t begin, std::size_t end, double *out)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        const __m256d ax0 = _mm256_loadu_pd(a.minX.data() + i), ay0 = _mm256_loadu_pd(a.minY.data() + i);
+        const __m256d ax1 = _mm256_loadu_pd(a.maxX.data() + i), ay1 = _mm256_loadu_pd(a.maxY.data() + i);
+        const __m256d bx0 = _mm256_loadu_pd(b.minX.data() + i), by0 = _mm256_loadu_pd(b.minY.data() + i);
+        const __m256d bx1 = _mm256_loadu_pd(b.maxX.data() + i), by1 = _mm256_loadu_pd(b.maxY.data() + i);
+        const __m256d w = _mm256_max_pd(_mm256_sub_pd(_mm256_min_pd(ax1, bx1), _mm256_max_pd(ax0, bx0)), zero);
+        const __m256d h = _mm256_max_pd(_mm256_sub_pd(_mm256_min_pd(ay1, by1), _mm256_max_pd(ay0, by0)), zero);
+        __m256d result = _mm256_mul_pd(w, h);
+        if (Iou) {
+            const __m256d areaA =
+                _mm256_mul_pd(_mm256_max_pd(_mm256_sub_pd(ax1, ax0), zero), _mm256_max_pd(_mm256_sub_pd(ay1, ay0), zero));
+            const __m256d areaB =
+                _mm256_mul_pd(_mm256_max_pd(_mm256_sub_pd(bx1, bx0), zero), _mm256_max_pd(_mm256_sub_pd(by1, by0), zero));
+            const __m256d uni = _mm256_sub_pd(_mm256_add_pd(areaA, areaB), result);
+            result = _mm256_and_pd(_mm256_cmp_pd(uni, zero, _CMP_GT_OQ), _mm256_div_pd(result, uni));
+        }
+        _mm256_storeu_pd(out + i, result);
+    }
+    boxScalar<Iou>(a, b, i, end, out);
+}
+#endif
+
+template <bool Iou>
+std::vector<double> boxBatch(const BoxBatch &a, const BoxBatch &b, SimdLevel level, unsigned threadCount)
+{
+    const std::size_t count = std::min(a.size(), b.size());
+    std::vector<double> out(count);
+    const SimdLevel best = bestSimdLevel();
+    if (level == SimdLevel::Auto || level > best) level = best;
+    forEachPair(count, threadCount, std::size_t(1) << 16, [&](std::size_t begin, std::size_t end) {
+        switch (level) {
+#ifdef GEOMETRY_HAVE_AVX2
+        case SimdLevel::AVX2:
+            boxAvx2<Iou>(a, b, begin, end, out.data());
+            break;
+#endif
+#ifdef GEOMETRY_HAVE_SSE2
+        case SimdLevel::SSE2:
+            boxSse2<Iou>(a, b, begin, end, out.data());
+            break;
+#endif
+        default:
+            boxScalar<Iou>(a, b, begin, end, out.data());
+            break;
+        }
+    });
+    return out;
+}
+
+} // namespace
+
+/**
+ * @brief 凸多边形交集的面积（上下链归并）
+ * @details 把每条非竖直边与基线之间的梯形按边的走向记正负，多边形的环绕数就是覆盖该点的梯形符号之和；
+ * 于是 ∫ w_A · w_B = Σ s_e · s_f · ∫ min(e, f)，求和只涉及 x 投影重叠的边对。
+ * 凸多边形的边分成两条 x 单调链，四对链各做一次双指针归并，总共 O(n + m) 个边对，全部在原数组上完成。
+ */
+double convexIntersectionArea(PointSpan polygonA, PointSpan polygonB)
+{
+    if (polygonA.size() < 3 || polygonB.size() < 3) return 0.0;
+    const double baseY = lowestY(polygonA, polygonB);
+
+    auto extremes = [](PointSpan poly, std::size_t &first, std::size_t &last) {
+        first = last = 0;
+        for (std::size_t i = 1; i < poly.size(); ++i) {
+            if (lexLess(poly[i], poly[first])) first = i;
+            if (lexLess(poly[last], poly[i])) last = i;
+        }
+    };
+    std::size_t firstA, lastA, firstB, lastB;
+    extremes(polygonA, firstA, lastA);
+    extremes(polygonB, firstB, lastB);
+    if (polygonA[lastA].x <= polygonB[firstB].x || polygonB[lastB].x <= polygonA[firstA].x) return 0.0;
+
+    double sum = 0.0;
+    for (bool forwardA : {true, false}) {
+        for (bool forwardB : {true, false}) {
+            sum += mergeChains(ChainWalker(polygonA, firstA, lastA, forwardA, baseY),
+                               ChainWalker(polygonB, firstB, lastB, forwardB, baseY));
+        }
+    }
+    return std::abs(sum);
+}
+
+/**
+ * @brief 一般多边形交集的面积
+ * @details 与凸情形同一个恒等式，只是边对由 x 方向扫描枚举。交点、共线重叠、顶点落在边上等退化情形
+ * 都只是被积函数的分界，不需要特判，也不需要求出交点后再缝合轮廓。
+ */
+double intersectionArea(PointSpan polygonA, PointSpan polygonB)
+{
+    if (polygonA.size() < 3 || polygonB.size() < 3) return 0.0;
+    if (isConvexPolygon(polygonA) && isConvexPolygon(polygonB)) return convexIntersectionArea(polygonA, polygonB);
+    return std::abs(sweepIntersectionArea(polygonA, polygonB, lowestY(polygonA, polygonB)));
+}
+
+double intersectionOverUnion(PointSpan polygonA, PointSpan polygonB)
+{
+    const double inter = intersectionArea(polygonA, polygonB);
+    const double uni = polygonArea(polygonA) + polygonArea(polygonB) - inter;
+    return uni > 0.0 ? inter / uni : 0.0;
+}
+
+std::vector<double> intersectionAreas(const PolygonBatch &a, const PolygonBatch &b, unsigned threadCount)
+{
+    const std::size_t count = std::min(a.size(), b.size());
+    std::vector<double> out(count);
+    forEachPair(count, threadCount, 256, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) out[i] = intersectionArea(a[i], b[i]);
+    });
+    return out;
+}
+
+std::vector<double> intersectionOverUnions(const PolygonBatch &a, const PolygonBatch &b, unsigned threadCount)
+{
+    const std::size_t count = std::min(a.size(), b.size());
+    std::vector<double> out(count);
+    forEachPair(count, threadCount, 256, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) out[i] = intersectionOverUnion(a[i], b[i]);
+    });
+    return out;
+}
+
+std::vector<double> boxIntersectionAreas(const BoxBatch &a, const BoxBatch &b, SimdLevel level, unsigned threadCount)
+{
+    return boxBatch<false>(a, b, level, threadCount);
+}
+
+std::vector<double> boxIntersectionOverUnions(const BoxBatch &a, const BoxBatch &b, SimdLevel level,
+                                              unsigned threadCount)
+{
+    return boxBatch<true>(a, b, level, threadCount);
+}
+
+} // namespace Geometry
@@ -0,0 +1,70 @@
+#ifndef INTERSECTIONAREA_H
+#define INTERSECTIONAREA_H
+/*IntersectionArea 只求两个多边形交集的面积与交并比（IoU），不构造交集多边形；提供逐对与批量两种接口*/
+#include "GeometryTypes.h"
+#include "PointInPolygonSimd.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace Geometry {
+
+/**
+ * @brief 两个凸多边形交集的面积
+ * @param polygonA 凸多边形（顶点方向任意，可含共线点与重复点）
+ * @param polygonB 凸多边形，要求同上
+ * @note 调用方需保证输入是凸的（见 isConvexPolygon），否则结果无意义
+ * @complexity O(n + m)，不分配内存
+ */
+double convexIntersectionArea(PointSpan polygonA, PointSpan polygonB);
+
+/**
+ * @brief 两个简单多边形交集的面积
+ * @details 两者都是凸多边形时走 convexIntersectionArea，否则对两多边形的边做一次 x 方向扫描。
+ * 自相交的输入按环绕数解释：结果为 |∫ w_A · w_B|。
+ * @complexity 凸：O(n + m)；一般：O((n + m) log(n + m) + P)，P 为 x 投影重叠的边对数
+ */
+double intersectionArea(PointSpan polygonA, PointSpan polygonB);
+
+// 交并比 |A∩B| / |A∪B|；并集面积为 0 时返回 0
+double intersectionOverUnion(PointSpan polygonA, PointSpan polygonB);
+
+/**
+ * @brief 连续存放的一批多边形
+ * @details 第 i 个多边形是 points[offsets[i]] ... points[offsets[i+1] - 1]，offsets 的长度为多边形个数 + 1。
+ */
+struct PolygonBatch {
+    PointSpan points;
+    Span<std::uint32_t> offsets;
+
+    std::size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    PointSpan operator[](std::size_t i) const { return PointSpan(points.data() + offsets[i], offsets[i + 1] - offsets[i]); }
+};
+
+// 批量求 a[i] 与 b[i] 交集的面积（对数取两批中较少的一个）；对数较多时分块并行，threadCount 为 0 时使用全部核心
+std::vector<double> intersectionAreas(const PolygonBatch &a, const PolygonBatch &b, unsigned threadCount = 0);
+
+// 批量求 a[i] 与 b[i] 的交并比，并行方式同上
+std::vector<double> intersectionOverUnions(const PolygonBatch &a, const PolygonBatch &b, unsigned threadCount = 0);
+
+//按结构数组（SoA）存放的一批轴对齐矩形；maxX < minX 或 maxY < minY 的矩形视为空
+struct BoxBatch {
+    Span<double> minX, minY, maxX, maxY;
+
+    std::size_t size() const { return std::min({minX.size(), minY.size(), maxX.size(), maxY.size()}); }
+};
+
+/**
+ * @brief 批量求轴对齐矩形 a[i] 与 b[i] 交集的面积
+ * @details 每条 SIMD 指令同时处理多对矩形，数量很大时再分块并行；各指令集版本之间的结果完全一致
+ * @param level 指令集；请求的级别不可用时退回到可用的最高级别
+ */
+std::vector<double> boxIntersectionAreas(const BoxBatch &a, const BoxBatch &b, SimdLevel level = SimdLevel::Auto,
+                                         unsigned threadCount = 0);
+
+// 批量求轴对齐矩形 a[i] 与 b[i] 的交并比，方式同上
+std::vector<double> boxIntersectionOverUnions(const BoxBatch &a, const BoxBatch &b, SimdLevel level = SimdLevel::Auto,
+                                              unsigned threadCount = 0);
+
+} // namespace Geometry
+
+#endif // INTERSECTIONAREA_H
@@ -0,0 +1,43 @@
+#include "Kernel.h"
+
+namespace Geometry {
+
+/**
+ * @brief 为一组数据集选择内核
+ * @details 一次线性扫描：出现非整数（或 NaN）时立即返回 FilteredExact，否则按最大坐标绝对值选 Int32 / Int64。
+ * 多个数据集（如布尔运算的两个输入）合在一起判断，保证参与同一次运算的点使用同一个内核。
+ * @complexity O(n)
+ */
+KernelKind chooseKernel(std::initializer_list<PointSpan> datasets)
+{
+    double largest = 0.0;
+    for (PointSpan points : datasets) {
+        for (const Point &p : points) {
+            if (!detail::isIntegral(p.x) || !detail::isIntegral(p.y)) return KernelKind::FilteredExact;
+            largest = std::max({largest, std::abs(p.x), std::abs(p.y)});
+        }
+    }
+    if (largest < Kernel<std::int32_t>::limit) return KernelKind::Int32;
+    if (largest <= Kernel<std::int64_t>::limit) return KernelKind::Int64;
+    return KernelKind::FilteredExact;
+}
+
+KernelKind resolveKernel(KernelKind requested, std::initializer_list<PointSpan> datasets)
+{
+    switch (requested) {
+    case KernelKind::Auto:
+    case KernelKind::Int32:
+        return chooseKernel(datasets);
+    case KernelKind::Int64: {
+        const KernelKind fitting = chooseKernel(datasets);
+        return fitting == KernelKind::Int32 ? KernelKind::Int64 : fitting;
+    }
+    case KernelKind::Float:
+    case KernelKind::Double:
+    case KernelKind::FilteredExact:
+        break;
+    }
+    return requested;
+}
+
+} // namespace Geometry
@@ -0,0 +1,279 @@
+#ifndef KERNEL_H
+#define KERNEL_H
+/*Kernel 把坐标类型与基础谓词（orient2d、incircle）打包成编译期的几何内核；算法按内核实例化，数据集在入口处选定内核*/
+#include "GeometryTypes.h"
+#include "Predicates.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+
+#if defined(__SIZEOF_INT128__)
+#define GEOMETRY_HAVE_INT128 1
+#endif
+
+namespace Geometry {
+
+//以 T 为坐标类型的点（double 内核直接使用 Point）
+template <typename T>
+struct BasicPoint {
+    T x{};
+    T y{};
+};
+
+template <typename T>
+inline bool operator==(const BasicPoint<T> &a, const BasicPoint<T> &b) { return a.x == b.x && a.y == b.y; }
+template <typename T>
+inline bool operator!=(const BasicPoint<T> &a, const BasicPoint<T> &b) { return !(a == b); }
+
+//内核标签：double 坐标，先做浮点误差滤波，结果落在误差界以内时逐级提高精度
+struct FilteredExact {};
+
+/**
+ * @brief 几何内核：坐标类型加两个基础谓词
+ * @details 特化只有以下五种：
+ * - std::int32_t：整数坐标，|c| < 2^28，orient2d 用 64 位、incircle 用 128 位整数精确求值；
+ * - std::int64_t：整数坐标，|c| ≤ 2^53，orient2d 用 128 位整数，incircle 交给 FilteredExact（这样的坐标在 double 中无损）；
+ * - float、double：直接用浮点运算，最快但在近退化输入上可能给出错误的符号；
+ * - FilteredExact：double 坐标，使用自适应精度谓词 orient2dAdaptive / inCircleAdaptive：
+ *   浮点结果超出误差界时直接采用，否则逐级提高精度，直至用无误差展开式精确求值。
+ * 没有 128 位整数的编译器上，整数内核改用 orient2dExact / inCircleExact，结果同样精确。
+ *
+ * 每个特化提供 Coord、Point、exact（谓词是否总是精确）、fits(p)（double 点能否无损放入且保持谓词精确）、
+ * convert(p)，以及返回 -1 / 0 / +1 的谓词：
+ * - orient2d(a, b, c)：a→b→c 左转（逆时针）为 +1，右转为 -1，共线为 0，与 crossProduct 同号；
+ * - incircle(a, b, c, d)：a、b、c 逆时针时 d 在外接圆内为 +1，圆上为 0，圆外为 -1，与 inCircle 同号。
+ */
+template <typename T>
+struct Kernel;
+
+namespace detail {
+
+template <typename T>
+inline int signOf(T v) { return (v > 0) - (v < 0); }
+
+inline bool isIntegral(double v) { return std::floor(v) == v; }
+
+} // namespace detail
+
+template <>
+struct Kernel<FilteredExact> {
+    using Coord = double;
+    using Point = Geometry::Point;
+    static constexpr bool exact = true;
+
+    static bool fits(const Geometry::Point &) { return true; }
+    static Point convert(const Geometry::Point &p) { return p; }
+
+    static int orient2d(const Point &a, const Point &b, const Point &c) { return detail::signOf(orient2dAdaptive(a, b, c)); }
+    static int incircle(const Point &a, const Point &b, const Point &c, const Point &d)
+    {
+        return detail::signOf(inCircleAdaptive(a, b, c, d));
+    }
+};
+
+template <>
+struct Kernel<double> {
+    using Coord = double;
+    using Point = Geometry::Point;
+    static constexpr bool exact = false;
+
+    static bool fits(const Geometry::Point &) { return true; }
+    static Point convert(const Geometry::Point &p) { return p; }
+    static int orient2d(const Point &a, const Point &b, const Point &c) { return detail::signOf(crossProduct(a, b, c)); }
+    static int incircle(const Point &a, const Point &b, const Point &c, const Point &d)
+    {
+        return detail::signOf(inCircle(a, b, c, d));
+    }
+};
+
+template <>
+struct Kernel<float> {
+    using Coord = float;
+    using Point = BasicPoint<float>;
+    static constexpr bool exact = false;
+
+    static bool fits(const Geometry::Point &p)
+    {
+        return std::abs(p.x) <= std::numeric_limits<float>::max() && std::abs(p.y) <= std::numeric_limits<float>::max();
+    }
+    static Point convert(const Geometry::Point &p) { return {static_cast<float>(p.x), static_cast<float>(p.y)}; }
+
+    static int orient2d(const Point &a, const Point &b, const Point &c)
+    {
+        return detail::signOf((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x));
+    }
+
+    static int incircle(const Point &a, const Point &b, const Point &c, const Point &d)
+    {
+        const float adx = a.x - d.x, ady = a.y - d.y;
+        const float bdx = b.x - d.x, bdy = b.y - d.y;
+        const float cdx = c.x - d.x, cdy = c.y - d.y;
+        const float alift = adx * adx + ady * ady;
+        const float blift = bdx * bdx + bdy * bdy;
+        const float clift = cdx * cdx + cdy * cdy;
+        return detail::signOf(alift * (bdx * cdy - cdx * bdy) + blift * (cdx * ady - adx * cdy) + clift * (adx * bdy - bdx * ady));
+    }
+};
+
+template <>
+struct Kernel<std::int32_t> {
+    using Coord = std::int32_t;
+    using Point = BasicPoint<std::int32_t>;
+    static constexpr bool exact = true;
+    static constexpr double limit = 268435456.0; // 2^28：坐标差 < 2^29，incircle 的提升项与余子式 < 2^59，三项之和 < 2^121
+
+    static bool fits(const Geometry::Point &p)
+    {
+        return detail::isIntegral(p.x) && detail::isIntegral(p.y) && std::abs(p.x) < limit && std::abs(p.y) < limit;
+    }
+    static Point convert(const Geometry::Point &p) { return {static_cast<Coord>(p.x), static_cast<Coord>(p.y)}; }
+
+    static int orient2d(const Point &a, const Point &b, const Point &c)
+    {
+        const std::int64_t det = (std::int64_t(b.x) - a.x) * (std::int64_t(c.y) - a.y) -
+                                 (std::int64_t(b.y) - a.y) * (std::int64_t(c.x) - a.x);
+        return detail::signOf(det);
+    }
+
+    static int incircle(const Point &a, const Point &b, const Point &c, const Point &d)
+    {
+#ifdef GEOMETRY_HAVE_INT128
+        const std::int64_t adx = std::int64_t(a.x) - d.x, ady = std::int64_t(a.y) - d.y;
+        const std::int64_t bdx = std::int64_t(b.x) - d.x, bdy = std::int64_t(b.y) - d.y;
+        const std::int64_t cdx = std::int64_t(c.x) - d.x, cdy = std::int64_t(c.y) - d.y;
+        const std::int64_t alift = adx * adx + ady * ady;
+        const std::int64_t blift = bdx * bdx + bdy * bdy;
+        const std::int64_t clift = cdx * cdx + cdy * cdy;
+        const __int128 det = __int128(alift) * (bdx * cdy - cdx * bdy) + __int128(blift) * (cdx * ady - adx * cdy) +
+                             __int128(clift) * (adx * bdy - bdx * ady);
+        return detail::signOf(det);
+#else
+        return Kernel<FilteredExact>::incircle({double(a.x), double(a.y)}, {double(b.x), double(b.y)},
+                                               {double(c.x), double(c.y)}, {double(d.x), double(d.y)});
+#endif
+    }
+};
+
+template <>
+struct Kernel<std::int64_t> {
+    using Coord = std::int64_t;
+    using Point = BasicPoint<std::int64_t>;
+    static constexpr bool exact = true;
+    static constexpr double limit = 9007199254740992.0; // 2^53：在 double 中无损，坐标差 < 2^54，叉积 < 2^109
+
+    static bool fits(const Geometry::Point &p)
+    {
+        return detail::isIntegral(p.x) && detail::isIntegral(p.y) && std::abs(p.x) <= limit && std::abs(p.y) <= limit;
+    }
+    static Point convert(const Geometry::Point &p) { return {static_cast<Coord>(p.x), static_cast<Coord>(p.y)}; }
+
+    static int orient2d(const Point &a, const Point &b, const Point &c)
+    {
+#ifdef GEOMETRY_HAVE_INT128
+        const __int128 det = __int128(b.x - a.x) * (c.y - a.y) - __int128(b.y - a.y) * (c.x - a.x);
+        return detail::signOf(det);
+#else
+        return Kernel<FilteredExact>::orient2d(toDouble(a), toDouble(b), toDouble(c));
+#endif
+    }
+
+    static int incircle(const Point &a, const Point &b, const Point &c, const Point &d)
+    {
+        return Kernel<FilteredExact>::incircle(toDouble(a), toDouble(b), toDouble(c), toDouble(d));
+    }
+
+private:
+    static Geometry::Point toDouble(const Point &p) { return {static_cast<double>(p.x), static_cast<double>(p.y)}; }
+};
+
+template <typename T>
+using KernelPoint = typename Kernel<T>::Point;
+
+template <typename T>
+inline int orient2d(const KernelPoint<T> &a, const KernelPoint<T> &b, const KernelPoint<T> &c)
+{
+    return Kernel<T>::orient2d(a, b, c);
+}
+
+template <typename T>
+inline int incircle(const KernelPoint<T> &a, const KernelPoint<T> &b, const KernelPoint<T> &c, const KernelPoint<T> &d)
+{
+    return Kernel<T>::incircle(a, b, c, d);
+}
+
+//内核点转回 double 点（整数内核无损）
+template <typename P>
+inline Point toPoint(const P &p)
+{
+    return {static_cast<double>(p.x), static_cast<double>(p.y)};
+}
+
+/**
+ * @brief 线段 p1p2 与 q1q2 是否在两条线段内部严格交叉（端点接触、共线重叠都不算）
+ * @details 与 getLineSegmentIntersection 的判定相同，但四次定向都由内核求出，精确内核下没有容差。
+ */
+template <typename K>
+inline bool segmentsCrossProperly(const typename K::Point &p1, const typename K::Point &p2,
+                                  const typename K::Point &q1, const typename K::Point &q2)
+{
+    const int o1 = K::orient2d(p1, p2, q1), o2 = K::orient2d(p1, p2, q2);
+    if (o1 == 0 || o2 == 0 || o1 == o2) return false;
+    const int o3 = K::orient2d(q1, q2, p1), o4 = K::orient2d(q1, q2, p2);
+    return o3 != 0 && o4 != 0 && o3 != o4;
+}
+
+/**
+ * @brief 与 segmentsIntersect 相同的规则：内部交叉，或一条线段的端点落在另一条线段内部
+ * @details 共线由 orient2d 的精确结果判断，再用包围盒确认端点在线段范围内，不需要 onSegment 的容差。
+ */
+template <typename K>
+inline bool segmentsTouchInterior(const typename K::Point &p1, const typename K::Point &p2,
+                                  const typename K::Point &q1, const typename K::Point &q2)
+{
+    const int o1 = K::orient2d(p1, p2, q1), o2 = K::orient2d(p1, p2, q2);
+    const int o3 = K::orient2d(q1, q2, p1), o4 = K::orient2d(q1, q2, p2);
+    if (o1 * o2 < 0 && o3 * o4 < 0) return true;
+
+    auto inside = [](const typename K::Point &a, const typename K::Point &b, const typename K::Point &c) {
+        const bool inBox = !(c.x < std::min(a.x, b.x) || c.x > std::max(a.x, b.x) ||
+                             c.y < std::min(a.y, b.y) || c.y > std::max(a.y, b.y));
+        return inBox && c != a && c != b;
+    };
+    return (o1 == 0 && inside(p1, p2, q1)) || (o2 == 0 && inside(p1, p2, q2)) ||
+           (o3 == 0 && inside(q1, q2, p1)) || (o4 == 0 && inside(q1, q2, p2));
+}
+
+//运行时可选的内核；Auto 表示按数据自动选择
+enum class KernelKind { Auto, Int32, Int64, Float, Double, FilteredExact };
+
+// 为数据集选择最快的精确内核：全部为 |c| < 2^28 的整数时用 Int32，整数但更大时用 Int64，否则用 FilteredExact
+KernelKind chooseKernel(std::initializer_list<PointSpan> datasets);
+inline KernelKind chooseKernel(PointSpan points) { return chooseKernel({points}); }
+
+// 调用方指定的内核放不下数据（整数内核遇到小数或超出范围的坐标）时改用 chooseKernel 的结果；Auto 同样交给 chooseKernel
+KernelKind resolveKernel(KernelKind requested, std::initializer_list<PointSpan> datasets);
+
+/**
+ * @brief 按 kind 实例化并调用 f(Kernel<T>{})
+ * @details 分派只在入口处发生一次，f 内部的循环按具体内核编译，不再有运行时分支。
+ * 各内核下 f 的返回类型必须相同。Auto 视为 FilteredExact（调用前应先经过 resolveKernel）。
+ */
+template <typename F>
+decltype(auto) withKernel(KernelKind kind, F &&f)
+{
+    switch (kind) {
+    case KernelKind::Int32: return f(Kernel<std::int32_t>{});
+    case KernelKind::Int64: return f(Kernel<std::int64_t>{});
+    case KernelKind::Float: return f(Kernel<float>{});
+    case KernelKind::Double: return f(Kernel<double>{});
+    case KernelKind::Auto:
+    case KernelKind::FilteredExact: break;
+    }
+    return f(Kernel<FilteredExact>{});
+}
+
+} // namespace Geometry
+
+#endif // KERNEL_H
@@ -0,0 +1,910 @@
+#include "MartinezClipper.h"
+#include "AllocationCounter.h"
+#include "PolygonUtils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <map>
+#include <optional>
+#include <queue>
+#include <set>
+#include <tuple>
+
+namespace Geometry {
+
+namespace {
+
+//边在结果中的角色：重叠边中只保留一条，另一条标记为不参与
+enum class EdgeType { Normal, NonContributing, SameTransition, DifferentTransition };
+
+struct SweepEvent;
+
+//扫描线状态中线段的上下顺序
+struct SegmentLess {
+    bool operator()(const SweepEvent *a, const SweepEvent *b) const;
+};
+using Status = std::set<SweepEvent *, SegmentLess, CountingAllocator<SweepEvent *>>;
+
+/**
+ * @brief 扫描事件：线段的一个端点
+ * @details 每条线段对应一左一右两个事件，互相用 other 指向。左事件额外记录该线段
+ * 相对两个多边形的内外状态，以及它是否属于结果。
+ */
+struct SweepEvent {
+    Point point;
+    bool left = false;
+    SweepEvent *other = nullptr;
+    bool isSubject = true;
+    EdgeType type = EdgeType::Normal;
+    std::size_t id = 0;            // 创建序号，用于打破完全重合时的平局
+    int contourId = 0;             // 所属输入环
+    std::size_t edge = 0;          // 在所属输入环中的边号（细分后的各段保持不变）
+    int windingContribution = 0;   // 单多边形修复：向上穿过此线段时环绕数的变化（原边从左到右为 +1）
+    int windingAbove = 0;          // 单多边形修复：此线段上方紧邻处的环绕数
+
+    bool inOut = false;            // 沿向上的竖线穿过此线段时，是否由本多边形内部走到外部
+    bool otherInOut = false;       // 此线段下方紧邻处是否位于另一多边形外部
+    SweepEvent *prevInResult = nullptr; // 状态中下方最近的、属于结果的线段
+    int resultTransition = 0;      // 0：不属于结果；+1/-1：向上穿过时进入/离开结果
+
+    Status::iterator position;     // 在扫描线状态中的位置
+    bool inStatus = false;
+    std::size_t otherPos = 0;      // 连接轮廓阶段：配对事件在结果事件数组中的下标
+    int outputContourId = -1;
+
+    bool inResult() const { return resultTransition != 0; }
+    bool isVertical() const { return point.x == other->point.x; }
+};
+
+inline bool lexLess(const Point &a, const Point &b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+/**
+ * @brief 三点有向面积（与 crossProduct 同号）
+ * @details 浮点下按不同顺序传入同样三个点，舍入结果可能一正一零，扫描线状态的比较器因此失去反对称性，
+ * std::set 会把两条不同的线段当成同一条。这里先把三点按字典序排好再计算，
+ * 按置换的奇偶性修正符号，使结果只取决于三个点本身。
+ */
+inline double signedArea(const Point &p0, const Point &p1, const Point &p2)
+{
+    const Point *a = &p0, *b = &p1, *c = &p2;
+    double sign = 1;
+    if (lexLess(*b, *a)) { std::swap(a, b); sign = -sign; }
+    if (lexLess(*c, *b)) { std::swap(b, c); sign = -sign; }
+    if (lexLess(*b, *a)) { std::swap(a, b); sign = -sign; }
+    return sign * ((a->x - c->x) * (b->y - c->y) - (b->x - c->x) * (a->y - c->y));
+}
+
+/**
+ * @brief 两点是否在舍入误差范围内重合
+ * @details 交点离线段端点只差几个 ulp 时不再细分：否则两条几乎重合的线段会在新端点旁
+ * 再次“相交”，每次向右挪动一个 ulp，扫描永远不会结束。
+ */
+inline bool nearlyEqual(const Point &a, const Point &b)
+{
+    const double scale = std::max({1.0, std::abs(a.x), std::abs(a.y)});
+    const double tolerance = 1e-12 * scale;
+    return std::abs(a.x - b.x) <= tolerance && std::abs(a.y - b.y) <= tolerance;
+}
+
+//点 p 到直线 ab 的距离是否在舍入误差范围内（容差与 nearlyEqual 相同）
+inline bool nearlyOnLine(const Point &a, const Point &b, const Point &p)
+{
+    const double scale = std::max({1.0, std::abs(p.x), std::abs(p.y)});
+    return std::abs(signedArea(a, b, p)) <= 1e-12 * scale * std::hypot(b.x - a.x, b.y - a.y);
+}
+
+//点 p 是否位于事件所在线段的严格上方（左侧）
+inline bool isBelow(const SweepEvent *e, const Point &p)
+{
+    return e->left ? signedArea(e->point, e->other->point, p) > 0
+                   : signedArea(e->other->point, e->point, p) > 0;
+}
+
+inline bool isAbove(const SweepEvent *e, const Point &p)
+{
+    return !isBelow(e, p);
+}
+
+/**
+ * @brief 事件的处理顺序：x 小者先，x 相同 y 小者先；同一点上右端点先于左端点，
+ * 两个左端点则线段在下方者先，共线时主多边形先
+ * @return 1 表示 e1 应排在 e2 之后，-1 表示之前
+ */
+int compareEvents(const SweepEvent *e1, const SweepEvent *e2)
+{
+    const Point &p1 = e1->point;
+    const Point &p2 = e2->point;
+    if (p1.x != p2.x) return p1.x > p2.x ? 1 : -1;
+    if (p1.y != p2.y) return p1.y > p2.y ? 1 : -1;
+    if (e1->left != e2->left) return e1->left ? 1 : -1;
+    if (signedArea(p1, e1->other->point, e2->other->point) != 0) return isBelow(e1, e2->other->point) ? -1 : 1;
+    return (!e1->isSubject && e2->isSubject) ? 1 : -1;
+}
+
+/**
+ * @brief 比较两条都在扫描线状态中的线段（以左事件代表）的上下关系
+ * @return -1 表示 le1 在下，1 表示在上，0 表示同一条线段
+ */
+int compareSegments(const SweepEvent *le1, const SweepEvent *le2)
+{
+    if (le1 == le2) return 0;
+
+    //共线判定对 le1、le2 对称，浮点下近乎共线的四个点才不会在交换参数后落入不同分支
+    const bool collinear = signedArea(le1->point, le1->other->point, le2->point) == 0 &&
+                           signedArea(le1->point, le1->other->point, le2->other->point) == 0 &&
+                           signedArea(le2->point, le2->other->point, le1->point) == 0 &&
+                           signedArea(le2->point, le2->other->point, le1->other->point) == 0;
+    if (!collinear) {
+        if (le1->point == le2->point) {
+            // 共享左端点：用右端点排序
+            if (signedArea(le1->point, le1->other->point, le2->other->point) != 0) {
+                return isBelow(le1, le2->other->point) ? -1 : 1;
+            }
+            return isBelow(le2, le1->other->point) ? 1 : -1;
+        }
+        if (le1->point.x == le2->point.x) return le1->point.y < le2->point.y ? -1 : 1;
+        // 后进入状态的线段看它的左端点在先进入者的哪一侧；左端点（在舍入误差内）落在先进入者上时改用右端点
+        if (compareEvents(le1, le2) == 1) {
+            const Point &p = nearlyOnLine(le2->point, le2->other->point, le1->point) ? le1->other->point : le1->point;
+            return isAbove(le2, p) ? -1 : 1;
+        }
+        const Point &p = nearlyOnLine(le1->point, le1->other->point, le2->point) ? le2->other->point : le2->point;
+        return isBelow(le1, p) ? -1 : 1;
+    }
+
+    // 共线
+    if (le1->isSubject == le2->isSubject) {
+        if (le1->point == le2->point) {
+            if (le1->contourId != le2->contourId) return le1->contourId > le2->contourId ? 1 : -1;
+            return le1->id < le2->id ? -1 : 1;
+        }
+    } else {
+        return le1->isSubject ? -1 : 1;
+    }
+    return compareEvents(le1, le2) == 1 ? 1 : -1;
+}
+
+bool SegmentLess::operator()(const SweepEvent *a, const SweepEvent *b) const
+{
+    return compareSegments(a, b) < 0;
+}
+
+struct EventLater {
+    bool operator()(const SweepEvent *a, const SweepEvent *b) const { return compareEvents(a, b) > 0; }
+};
+
+//线段与运算类型决定此线段是否属于结果
+bool inResult(const SweepEvent *e, BooleanOpType op)
+{
+    switch (e->type) {
+    case EdgeType::Normal:
+        switch (op) {
+        case BooleanOpType::Intersection: return !e->otherInOut;
+        case BooleanOpType::Union: return e->otherInOut;
+        case BooleanOpType::Difference: return (e->isSubject && e->otherInOut) || (!e->isSubject && !e->otherInOut);
+        case BooleanOpType::Xor: return true;
+        }
+        break;
+    case EdgeType::SameTransition: return op == BooleanOpType::Intersection || op == BooleanOpType::Union;
+    case EdgeType::DifferentTransition: return op == BooleanOpType::Difference;
+    case EdgeType::NonContributing: return false;
+    }
+    return false;
+}
+
+//向上穿过此线段时是进入结果（+1）还是离开结果（-1）
+int resultTransition(const SweepEvent *e, BooleanOpType op)
+{
+    const bool thisIn = !e->inOut;
+    const bool thatIn = !e->otherInOut;
+    bool isIn = false;
+    switch (op) {
+    case BooleanOpType::Intersection: isIn = thisIn && thatIn; break;
+    case BooleanOpType::Union: isIn = thisIn || thatIn; break;
+    case BooleanOpType::Xor: isIn = thisIn != thatIn; break;
+    case BooleanOpType::Difference: isIn = e->isSubject ? (thisIn && !thatIn) : (thatIn && !thisIn); break;
+    }
+    return isIn ? 1 : -1;
+}
+
+/**
+ * @brief 线段求交：返回 0、1 或 2 个交点（2 个表示共线重叠部分的两端）
+ */
+int segmentIntersection(const Point &a1, const Point &a2, const Point &b1, const Point &b2, Point out[2])
+{
+    const Point va = a2 - a1;
+    const Point vb = b2 - b1;
+    const Point e = b1 - a1;
+    auto cross = [](const Point &u, const Point &v) { return u.x * v.y - u.y * v.x; };
+    auto dot = [](const Point &u, const Point &v) { return u.x * v.x + u.y * v.y; };
+    auto at = [](const Point &p, double s, const Point &d) { return Point{p.x + s * d.x, p.y + s * d.y}; };
+
+    const double kross = cross(va, vb);
+    if (kross != 0) {
+        const double s = cross(e, vb) / kross;
+        const double t = cross(e, va) / kross;
+        // 端点恰好（或在舍入误差内）落在另一条线段上时直接取该端点：
+        // 否则先前细分产生的舍入交点会让后来的 T 形接触被漏判或在端点旁切出极短的碎边
+        Point p = at(a1, s, va);
+        if (signedArea(b1, b2, a1) == 0) p = a1;
+        else if (signedArea(b1, b2, a2) == 0) p = a2;
+        else if (signedArea(a1, a2, b1) == 0) p = b1;
+        else if (signedArea(a1, a2, b2) == 0) p = b2;
+        else {
+            for (const Point *q : {&a1, &a2, &b1, &b2}) {
+                if (nearlyEqual(p, *q)) {
+                    p = *q;
+                    break;
+                }
+            }
+        }
+        const bool onA = (s >= 0 && s <= 1) || p == a1 || p == a2;
+        const bool onB = (t >= 0 && t <= 1) || p == b1 || p == b2;
+        if (!onA || !onB) return 0;
+        out[0] = p;
+        return 1;
+    }
+
+    // 平行：不共线则无交点
+    if (cross(e, va) != 0) return 0;
+    const double sqrLenA = dot(va, va);
+    const double sa = dot(va, e) / sqrLenA;
+    const double sb = sa + dot(va, vb) / sqrLenA;
+    const double smin = std::min(sa, sb);
+    const double smax = std::max(sa, sb);
+    if (smin > 1 || smax < 0) return 0;
+    if (smin == 1) {
+        out[0] = at(a1, 1, va);
+        return 1;
+    }
+    if (smax == 0) {
+        out[0] = at(a1, 0, va);
+        return 1;
+    }
+    out[0] = at(a1, smin > 0 ? smin : 0, va);
+    out[1] = at(a1, smax < 1 ? smax : 1, va);
+    return 2;
+}
+
+//连接阶段得到的一条输出轮廓
+struct Contour {
+    Polygon points;
+    int holeOf = -1; // 若为孔洞，所属外轮廓的编号
+    int depth = 0;   // 嵌套深度
+    std::vector<int> holeIds;
+    std::vector<char> filledLeft; // 每条边 points[i] → points[i+1]：沿前进方向的左侧是否属于结果
+};
+
+class MartinezSweep
+{
+public:
+    MartinezSweep(BooleanOpType op, AllocationCounter &memory)
+        : m_op(op),
+          m_events(CountingAllocator<SweepEvent>(&memory)),
+          m_queue(EventLater(), CountedVector<SweepEvent *>(CountingAllocator<SweepEvent *>(&memory))),
+          m_status(SegmentLess(), CountingAllocator<SweepEvent *>(&memory)),
+          m_sorted(CountingAllocator<SweepEvent *>(&memory)),
+          m_memory(memory)
+    {
+    }
+
+    //单多边形修复模式：按填充规则而不是布尔运算决定线段是否属于结果，同一多边形的重叠边也细分合并
+    void setFillRule(FillRule rule) { m_fillRule = rule; }
+
+    //记录扫描中发现的所有交点（按输入边编号），用于报告自交
+    void recordCrossings(std::vector<EdgeIntersection> *crossings) { m_crossings = crossings; }
+
+    //把一组环的所有边加入事件队列，同时累计包围盒
+    void addRings(Span<Polygon> rings, bool isSubject, double box[4])
+    {
+        for (const Polygon &ring : rings) {
+            const int contourId = m_nextContour++;
+            for (std::size_t i = 0; i < ring.size(); ++i) {
+                const Point &p = ring[i];
+                const Point &q = ring[(i + 1) % ring.size()];
+                box[0] = std::min(box[0], p.x);
+                box[1] = std::min(box[1], p.y);
+                box[2] = std::max(box[2], p.x);
+                box[3] = std::max(box[3], p.y);
+                if (p == q) continue; // 跳过零长度边
+                SweepEvent *e1 = newEvent(p, false, nullptr, isSubject);
+                SweepEvent *e2 = newEvent(q, false, e1, isSubject);
+                e1->other = e2;
+                e1->contourId = e2->contourId = contourId;
+                e1->edge = e2->edge = i;
+                if (compareEvents(e1, e2) > 0) e2->left = true;
+                else e1->left = true;
+                (e1->left ? e1 : e2)->windingContribution = e1->left ? 1 : -1;
+                m_queue.push(e1);
+                m_queue.push(e2);
+            }
+        }
+    }
+
+    /**
+     * @brief 扫描：按顺序处理事件，细分相交线段并计算每条线段的内外标记
+     * @param stopX 超过此 x 后结果不可能再有边（交集、差集的包围盒剪枝）
+     */
+    void subdivide(double stopX)
+    {
+        while (!m_queue.empty()) {
+            SweepEvent *event = m_queue.top();
+            m_queue.pop();
+            m_sorted.push_back(event);
+            if (event->point.x > stopX) break;
+
+            if (event->left) {
+                const auto it = m_status.insert(event).first;
+                event->position = it;
+                event->inStatus = true;
+                SweepEvent *prev = (it != m_status.begin()) ? *std::prev(it) : nullptr;
+                SweepEvent *next = (std::next(it) != m_status.end()) ? *std::next(it) : nullptr;
+
+                computeFields(event, prev);
+                if (next && possibleIntersection(event, next) == 2) {
+                    computeFields(event, prev);
+                    computeFields(next, event);
+                }
+                if (prev && possibleIntersection(prev, event) == 2) {
+                    const auto prevIt = prev->position;
+                    SweepEvent *prevprev = (prevIt != m_status.begin()) ? *std::prev(prevIt) : nullptr;
+                    computeFields(prev, prevprev);
+                    computeFields(event, prev);
+                }
+            } else {
+                SweepEvent *le = event->other;
+                if (!le->inStatus) continue;
+                const auto it = le->position;
+                SweepEvent *prev = (it != m_status.begin()) ? *std::prev(it) : nullptr;
+                SweepEvent *next = (std::next(it) != m_status.end()) ? *std::next(it) : nullptr;
+                m_status.erase(it);
+                le->inStatus = false;
+                if (prev && next) possibleIntersection(prev, next);
+            }
+        }
+    }
+
+    /**
+     * @brief 把属于结果的边连接成轮廓，并根据下方最近的结果边确定孔洞归属
+     */
+    std::vector<Contour> connectEdges()
+    {
+        CountedVector<SweepEvent *> result{CountingAllocator<SweepEvent *>(&m_memory)};
+        for (SweepEvent *e : m_sorted) {
+            if ((e->left && e->inResult()) || (!e->left && e->other->inResult())) result.push_back(e);
+        }
+        //重叠边的细分可能使序列局部无序，插入排序在近乎有序时是线性的
+        for (std::size_t i = 1; i < result.size(); ++i) {
+            for (std::size_t j = i; j > 0 && compareEvents(result[j - 1], result[j]) == 1; --j) {
+                std::swap(result[j - 1], result[j]);
+            }
+        }
+        for (std::size_t i = 0; i < result.size(); ++i) result[i]->otherPos = i;
+        for (SweepEvent *e : result) {
+            if (!e->left) std::swap(e->otherPos, e->other->otherPos);
+        }
+
+        CountedVector<char> processed(result.size(), 0, CountingAllocator<char>(&m_memory));
+        std::vector<Contour> contours;
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            if (processed[i]) continue;
+            const int contourId = static_cast<int>(contours.size());
+            Contour contour = contourFromContext(result[i], contours, contourId);
+            auto mark = [&](std::size_t pos) {
+                processed[pos] = 1;
+                result[pos]->outputContourId = contourId;
+            };
+
+            std::size_t pos = i;
+            contour.points.push_back(result[i]->point);
+            for (;;) {
+                mark(pos);
+                const SweepEvent *from = result[pos];
+                const SweepEvent *le = from->left ? from : from->other;
+                // 从左事件走向右事件时，结果所在的“上方”（竖直线段为左侧）正是前进方向的左侧
+                contour.filledLeft.push_back(from->left == (le->resultTransition > 0));
+                pos = result[pos]->otherPos;
+                mark(pos);
+                contour.points.push_back(result[pos]->point);
+                const long nextPos = connectsByAngle() ? nextPositionByAngle(pos, result, processed, i, contour.filledLeft.back())
+                                                       : nextPosition(pos, result, processed, i);
+                if (nextPos < 0 || static_cast<std::size_t>(nextPos) == i || static_cast<std::size_t>(nextPos) >= result.size()) break;
+                pos = static_cast<std::size_t>(nextPos);
+            }
+            if (contour.points.size() > 1 && contour.points.back() == contour.points.front()) contour.points.pop_back();
+            contours.push_back(std::move(contour));
+        }
+        return contours;
+    }
+
+    std::size_t intersectionCount() const { return m_intersections; }
+
+    //异或的 A−B 与 B−A 两部分在交点处相接，与修复模式一样需要按角度连接，否则会被串成方向相反的“8”字形环
+    bool connectsByAngle() const { return m_fillRule || m_op == BooleanOpType::Xor; }
+
+private:
+    SweepEvent *newEvent(const Point &p, bool left, SweepEvent *other, bool isSubject)
+    {
+        m_events.emplace_back();
+        SweepEvent *e = &m_events.back();
+        e->point = p;
+        e->left = left;
+        e->other = other;
+        e->isSubject = isSubject;
+        e->id = m_events.size();
+        return e;
+    }
+
+    /**
+     * @brief 由状态中下方紧邻的线段 prev 推出 event 的内外标记与是否属于结果
+     */
+    void computeFields(SweepEvent *event, const SweepEvent *prev)
+    {
+        if (m_fillRule) {
+            //修复模式：下方的环绕数来自 prev，按填充规则判断线段两侧是否在区域内。
+            //竖直线段的两侧是左右而不是上下：右侧与 prev 上方相同，左侧再加上自身的贡献，上方的线段直接沿用 below
+            const int below = prev ? prev->windingAbove : 0;
+            const int across = below + event->windingContribution;
+            event->windingAbove = event->isVertical() ? below : across;
+            const bool insideBelow = filled(below), insideAbove = filled(across);
+            event->inOut = insideBelow && !insideAbove;
+            event->prevInResult = !prev ? nullptr
+                                        : (!prev->inResult() || prev->isVertical()) ? prev->prevInResult
+                                                                                    : const_cast<SweepEvent *>(prev);
+            event->resultTransition = insideBelow == insideAbove ? 0 : (insideAbove ? 1 : -1);
+            return;
+        }
+        if (!prev) {
+            event->inOut = false;
+            event->otherInOut = true;
+        } else {
+            if (event->isSubject == prev->isSubject) {
+                event->inOut = !prev->inOut;
+                event->otherInOut = prev->otherInOut;
+            } else {
+                event->inOut = !prev->otherInOut;
+                event->otherInOut = prev->isVertical() ? !prev->inOut : prev->inOut;
+            }
+            event->prevInResult = (!inResult(prev, m_op) || prev->isVertical()) ? prev->prevInResult
+                                                                                : const_cast<SweepEvent *>(prev);
+        }
+        event->resultTransition = inResult(event, m_op) ? resultTransition(event, m_op) : 0;
+    }
+
+    //在点 p 处把线段 se 一分为二，新产生的两个事件进入队列
+    void divideSegment(SweepEvent *se, const Point &p)
+    {
+        // 分点必须严格位于线段内部；退化输入（同一多边形的重边等）可能给出线段外的点，
+        // 若照样细分，新旧线段会互相“相交”，扫描不会结束
+        const Point &a = se->left ? se->point : se->other->point;
+        const Point &b = se->left ? se->other->point : se->point;
+        if (!(lexLess(a, p) && lexLess(p, b))) return;
+        SweepEvent *r = newEvent(p, false, se, se->isSubject);
+        SweepEvent *l = newEvent(p, true, se->other, se->isSubject);
+        r->contourId = l->contourId = se->contourId;
+        r->edge = l->edge = se->edge;
+        l->windingContribution = se->windingContribution;
+        // 舍入误差可能让新的左事件排在原右事件之后，此时交换二者的左右角色
+        if (compareEvents(l, se->other) > 0) {
+            se->other->left = true;
+            l->left = false;
+        }
+        se->other->other = l;
+        se->other = r;
+        m_queue.push(l);
+        m_queue.push(r);
+    }
+
+    /**
+     * @brief 检查相邻两条线段是否相交，相交则细分；共线重叠时标记边的类型
+     * @return 0 不相交（或仅共享端点），1 交于一点，2 重叠且共享左端点，3 其他重叠
+     */
+    int possibleIntersection(SweepEvent *se1, SweepEvent *se2)
+    {
+        Point inter[2];
+        const int n = segmentIntersection(se1->point, se1->other->point, se2->point, se2->other->point, inter);
+        if (n == 0) return 0;
+        if (m_crossings) record(se1, se2, inter, n);
+        if (n == 1 && (se1->point == se2->point || se1->other->point == se2->other->point)) return 0;
+        if (n == 2 && se1->isSubject == se2->isSubject && !m_fillRule) return 0; // 布尔运算不处理同一多边形的重叠边
+
+        ++m_intersections;
+        if (n == 1) {
+            if (!nearlyEqual(se1->point, inter[0]) && !nearlyEqual(se1->other->point, inter[0])) divideSegment(se1, inter[0]);
+            if (!nearlyEqual(se2->point, inter[0]) && !nearlyEqual(se2->other->point, inter[0])) divideSegment(se2, inter[0]);
+            return 1;
+        }
+
+        // 两线段共线重叠：按事件顺序排出四个端点
+        SweepEvent *events[4];
+        int count = 0;
+        bool leftCoincide = false, rightCoincide = false;
+        if (se1->point == se2->point) {
+            leftCoincide = true;
+        } else if (compareEvents(se1, se2) == 1) {
+            events[count++] = se2;
+            events[count++] = se1;
+        } else {
+            events[count++] = se1;
+            events[count++] = se2;
+        }
+        if (se1->other->point == se2->other->point) {
+            rightCoincide = true;
+        } else if (compareEvents(se1->other, se2->other) == 1) {
+            events[count++] = se2->other;
+            events[count++] = se1->other;
+        } else {
+            events[count++] = se1->other;
+            events[count++] = se2->other;
+        }
+
+        if (leftCoincide && m_fillRule) {
+            // 修复模式：先把较长的一条切到与较短的一条等长，再把两条的环绕数变化合并到 se1，se2 不再参与结果
+            if (!rightCoincide) divideSegment(events[1]->other, events[0]->point);
+            se1->windingContribution += se2->windingContribution;
+            se2->windingContribution = 0;
+            se1->type = EdgeType::Normal;
+            se2->type = EdgeType::NonContributing;
+            return 2;
+        }
+        if (leftCoincide) {
+            // 两线段相同或共享左端点：只保留一条，并记录两侧是否同向过渡
+            se2->type = EdgeType::NonContributing;
+            se1->type = (se2->inOut == se1->inOut) ? EdgeType::SameTransition : EdgeType::DifferentTransition;
+            if (!rightCoincide) divideSegment(events[1]->other, events[0]->point);
+            return 2;
+        }
+        if (rightCoincide) {
+            // 共享右端点
+            divideSegment(events[0], events[1]->point);
+            return 3;
+        }
+        if (events[0] != events[3]->other) {
+            // 部分重叠
+            divideSegment(events[0], events[1]->point);
+            divideSegment(events[1], events[2]->point);
+            return 3;
+        }
+        // 一条完全包含另一条
+        divideSegment(events[0], events[1]->point);
+        divideSegment(events[3]->other, events[2]->point);
+        return 3;
+    }
+
+    bool filled(int winding) const
+    {
+        return *m_fillRule == FillRule::EvenOdd ? winding % 2 != 0 : winding != 0;
+    }
+
+    //按输入边编号记录 se1、se2 的接触点（重叠时记录重叠段的两端）；同一条输入边细分出的各段之间不算
+    void record(const SweepEvent *se1, const SweepEvent *se2, const Point inter[2], int n)
+    {
+        if (se1->contourId == se2->contourId && se1->edge == se2->edge) return;
+        for (int i = 0; i < n; ++i) {
+            EdgeIntersection hit;
+            hit.edgeA = std::min(se1->edge, se2->edge);
+            hit.edgeB = std::max(se1->edge, se2->edge);
+            hit.point = inter[i];
+            m_crossings->push_back(hit);
+        }
+    }
+
+    long nextPosition(std::size_t pos, const CountedVector<SweepEvent *> &result,
+                      const CountedVector<char> &processed, std::size_t origPos) const
+    {
+        const Point &p = result[pos]->point;
+        std::size_t newPos = pos + 1;
+        while (newPos < result.size() && result[newPos]->point == p) {
+            if (!processed[newPos]) return static_cast<long>(newPos);
+            ++newPos;
+        }
+        long back = static_cast<long>(pos) - 1;
+        while (back > static_cast<long>(origPos) && processed[back]) --back;
+        return back;
+    }
+
+    /**
+     * @brief 修复模式下的 nextPosition：在当前点的所有候选边中按角度选出下一条
+     * @details 任取一条未处理的边时，两块只共享一个顶点的区域的边界可能被串成一个环，且各段的内外侧不一致。
+     * 这里让结果一直保持在前进方向的同一侧：结果在左侧时，从来路方向顺时针转过的第一条边与来路围住同一个角，
+     * 在右侧时则取逆时针的第一条。起点的边也是候选，选中它表示环已闭合。
+     */
+    long nextPositionByAngle(std::size_t pos, const CountedVector<SweepEvent *> &result,
+                             const CountedVector<char> &processed, std::size_t origPos, bool filledLeft) const
+    {
+        const Point &p = result[pos]->point;
+        const Point &from = result[pos]->other->point;
+        const double back = std::atan2(from.y - p.y, from.x - p.x);
+        const double twoPi = 2 * std::acos(-1.0);
+
+        std::size_t lo = pos, hi = pos + 1;
+        while (lo > 0 && result[lo - 1]->point == p) --lo;
+        while (hi < result.size() && result[hi]->point == p) ++hi;
+        long best = -1;
+        double bestTurn = 0;
+        for (std::size_t k = lo; k < hi; ++k) {
+            if (processed[k] && k != origPos) continue;
+            const Point &to = result[k]->other->point;
+            double turn = back - std::atan2(to.y - p.y, to.x - p.x);
+            if (!filledLeft) turn = -turn;
+            while (turn <= 0) turn += twoPi;
+            while (turn > twoPi) turn -= twoPi;
+            if (best < 0 || turn < bestTurn) {
+                best = static_cast<long>(k);
+                bestTurn = turn;
+            }
+        }
+        return best;
+    }
+
+    //根据下方最近的结果边判断新轮廓是外边界还是孔洞
+    static Contour contourFromContext(const SweepEvent *event, std::vector<Contour> &contours, int contourId)
+    {
+        Contour contour;
+        const SweepEvent *lower = event->prevInResult;
+        if (!lower || lower->outputContourId < 0) return contour;
+
+        const int lowerId = lower->outputContourId;
+        if (lower->resultTransition > 0) {
+            // 下方是结果内部：新轮廓是孔洞，挂到下方轮廓（或下方孔洞的父轮廓）之下
+            const int parent = contours[lowerId].holeOf >= 0 ? contours[lowerId].holeOf : lowerId;
+            contours[parent].holeIds.push_back(contourId);
+            contour.holeOf = parent;
+            contour.depth = contours[lowerId].holeOf >= 0 ? contours[lowerId].depth : contours[lowerId].depth + 1;
+        } else {
+            contour.depth = contours[lowerId].depth;
+        }
+        return contour;
+    }
+
+    BooleanOpType m_op;
+    std::deque<SweepEvent, CountingAllocator<SweepEvent>> m_events; // 事件存储区，地址稳定
+    std::priority_queue<SweepEvent *, CountedVector<SweepEvent *>, EventLater> m_queue;
+    Status m_status;
+    CountedVector<SweepEvent *> m_sorted; // 按处理顺序记录的事件
+    AllocationCounter &m_memory;
+    int m_nextContour = 0;
+    std::size_t m_intersections = 0;
+    std::optional<FillRule> m_fillRule;
+    std::vector<EdgeIntersection> *m_crossings = nullptr;
+};
+
+//把连接得到的轮廓统一方向（外边界逆时针、孔洞顺时针）并按孔洞归属组装成区域
+std::vector<PolygonWithHoles> assembleRegions(std::vector<Contour> contours)
+{
+    std::vector<PolygonWithHoles> output;
+    for (Contour &contour : contours) {
+        if (contour.points.size() < 3) continue;
+        const bool ccw = computeAreaSign(contour.points) > 0;
+        if (ccw == (contour.holeOf >= 0)) std::reverse(contour.points.begin(), contour.points.end());
+    }
+    for (Contour &contour : contours) {
+        if (contour.holeOf >= 0 || contour.points.size() < 3) continue;
+        PolygonWithHoles region;
+        region.outer = std::move(contour.points);
+        for (int holeId : contour.holeIds) {
+            if (contours[holeId].points.size() >= 3) region.holes.push_back(std::move(contours[holeId].points));
+        }
+        output.push_back(std::move(region));
+    }
+    return output;
+}
+
+//在重复顶点处把轮廓拆开：沿轮廓压栈，遇到已在栈中的点就把两次出现之间的部分弹出，成为一个独立的小环。
+//按角度连接的轮廓上各边的 filledLeft 一致，小环的内部属于结果则定为逆时针（外边界），否则定为顺时针（孔洞）
+void splitAtRepeatedVertices(const Contour &contour, std::vector<Polygon> &outers, std::vector<Polygon> &holes)
+{
+    const Polygon &ring = contour.points;
+    auto emit = [&](Polygon loop, std::size_t firstEdge) {
+        if (loop.size() < 3 || firstEdge >= contour.filledLeft.size()) return;
+        const bool ccw = computeAreaSign(loop) > 0;
+        const bool filled = ccw == static_cast<bool>(contour.filledLeft[firstEdge]);
+        if (ccw != filled) std::reverse(loop.begin(), loop.end());
+        (filled ? outers : holes).push_back(std::move(loop));
+    };
+
+    std::map<Point, std::size_t, bool (*)(const Point &, const Point &)> onStack(lexLess);
+    Polygon stack;
+    std::vector<std::size_t> outEdge; // 栈中每个点在当前环上的出边
+    for (std::size_t i = 0; i < ring.size(); ++i) {
+        const auto it = onStack.find(ring[i]);
+        if (it == onStack.end()) {
+            onStack.emplace(ring[i], stack.size());
+            stack.push_back(ring[i]);
+            outEdge.push_back(i);
+            continue;
+        }
+        const std::size_t k = it->second;
+        for (std::size_t j = k + 1; j < stack.size(); ++j) onStack.erase(stack[j]);
+        emit(Polygon(stack.begin() + static_cast<std::ptrdiff_t>(k), stack.end()), outEdge[k]);
+        stack.resize(k + 1);
+        outEdge.resize(k + 1);
+        outEdge[k] = i;
+    }
+    if (!outEdge.empty()) emit(std::move(stack), outEdge[0]);
+}
+
+/**
+ * @brief makeValid 的区域组装：与 assembleRegions 相同，但先拆开在顶点处自我接触的轮廓
+ * @details 按角度连接后每个轮廓都沿同一块区域的边界走，但区域在某个顶点处与自身接触时（如孔洞的顶点落在外边界上），
+ * 轮廓会两次经过该顶点，不是简单多边形；拆开后由边的 filledLeft 决定各部分是外边界还是孔洞。
+ * 一组轮廓（外轮廓及挂在它下面的孔洞）拆出多个外边界时，每个孔洞归入包含它的面积最小的外边界。
+ */
+std::vector<PolygonWithHoles> assembleValidRegions(const std::vector<Contour> &contours)
+{
+    std::vector<std::vector<int>> families(contours.size());
+    for (std::size_t id = 0; id < contours.size(); ++id) {
+        families[contours[id].holeOf >= 0 ? contours[id].holeOf : static_cast<int>(id)].push_back(static_cast<int>(id));
+    }
+
+    std::vector<PolygonWithHoles> output;
+    for (const std::vector<int> &family : families) {
+        std::vector<Polygon> outers, holes;
+        for (int id : family) splitAtRepeatedVertices(contours[id], outers, holes);
+
+        const std::size_t first = output.size();
+        for (Polygon &outer : outers) {
+            PolygonWithHoles region;
+            region.outer = std::move(outer);
+            output.push_back(std::move(region));
+        }
+        if (output.size() == first) continue;
+        for (Polygon &hole : holes) {
+            std::size_t owner = first;
+            if (output.size() - first > 1) {
+                // 结果中孔洞的边不会与外边界重合，取第一条边的中点判断包含关系
+                const Point probe{(hole[0].x + hole[1].x) / 2, (hole[0].y + hole[1].y) / 2};
+                double best = std::numeric_limits<double>::infinity();
+                for (std::size_t i = first; i < output.size(); ++i) {
+                    const double area = polygonArea(output[i].outer);
+                    if (area < best && isPointInsidePolygon(probe, output[i].outer)) {
+                        best = area;
+                        owner = i;
+                    }
+                }
+            }
+            output[owner].holes.push_back(std::move(hole));
+        }
+    }
+    return output;
+}
+
+} // namespace
+
+/**
+ * @brief Martinez–Rueda–Feito 多边形布尔运算
+ * @details 1. 两个多边形的所有边放入同一个按字典序排列的事件队列；
+ * 2. 扫描线从左到右推进，相邻线段相交时在交点处细分（共线重叠时只保留一条并标记类型），
+ *    每条线段插入状态时由其下方紧邻的线段推出“本多边形内外”“另一多边形内外”两个标记，
+ *    进而按运算类型判断它是否属于结果；
+ * 3. 把属于结果的线段按端点连接成轮廓，并由每个轮廓下方最近的结果边判断它是外边界还是孔洞；
+ *    异或的两部分在交点处相接，按角度连接并在重复顶点处拆开，与 makeValid 相同。
+ * 输入的环按奇偶规则解释，因此孔洞、多个区域、环的方向都不需要预处理；
+ * 交集只需扫描到两者包围盒右边界的较小值，差集只需扫描到主多边形的右边界。
+ */
+std::vector<PolygonWithHoles> booleanOpMartinez(Span<Polygon> subject, Span<Polygon> clipping, BooleanOpType opType,
+                                                BooleanOpStats *stats)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto begin = Clock::now();
+    AllocationCounter memory;
+
+    const double inf = std::numeric_limits<double>::infinity();
+    double subjectBox[4] = {inf, inf, -inf, -inf};
+    double clippingBox[4] = {inf, inf, -inf, -inf};
+
+    MartinezSweep sweep(opType, memory);
+    sweep.addRings(subject, true, subjectBox);
+    sweep.addRings(clipping, false, clippingBox);
+
+    double stopX = inf;
+    if (opType == BooleanOpType::Intersection) stopX = std::min(subjectBox[2], clippingBox[2]);
+    else if (opType == BooleanOpType::Difference) stopX = subjectBox[2];
+    sweep.subdivide(stopX);
+    const auto connectBegin = Clock::now();
+
+    //按角度连接的异或轮廓可能在交点处自我接触，需先拆开
+    std::vector<PolygonWithHoles> output = sweep.connectsByAngle() ? assembleValidRegions(sweep.connectEdges())
+                                                                   : assembleRegions(sweep.connectEdges());
+
+    if (stats) {
+        const auto end = Clock::now();
+        stats->intersectionCount = sweep.intersectionCount();
+        stats->discoveryMs = std::chrono::duration<double, std::milli>(connectBegin - begin).count();
+        stats->traversalMs = std::chrono::duration<double, std::milli>(end - connectBegin).count();
+        stats->allocationCount = memory.allocations;
+        stats->peakBytes = memory.peakBytes;
+    }
+    return output;
+}
+
+/**
+ * @brief 报告单个多边形的所有自交点
+ * @details 与布尔运算共用扫描线：只放入这一个环，相邻线段相交时在交点处细分，同一多边形的共线重叠边也细分，
+ * 每次发现接触都按原始边号记录下来，细分后的同一处接触可能被再次发现，最后排序去重。
+ * 相邻两条边在公共顶点处的正常连接不算相交；不相邻的边经过同一个顶点、共线重叠（报告重叠段两端）都算。
+ * @param polygon 多边形顶点（可自相交、可有重叠边）
+ * @return 所有交点，按 (edgeA, edgeB) 排序，edgeA < edgeB；alphaA、alphaB 为交点在两条边上的参数位置
+ * @complexity O((n + k) log n)，k 为交点数
+ */
+std::vector<EdgeIntersection> findSelfIntersections(PointSpan polygon)
+{
+    AllocationCounter memory;
+    std::vector<EdgeIntersection> crossings;
+    const Polygon ring(polygon.begin(), polygon.end());
+    const double inf = std::numeric_limits<double>::infinity();
+    double box[4] = {inf, inf, -inf, -inf};
+
+    MartinezSweep sweep(BooleanOpType::Union, memory);
+    sweep.setFillRule(FillRule::EvenOdd);
+    sweep.recordCrossings(&crossings);
+    sweep.addRings(Span<Polygon>(&ring, 1), true, box);
+    sweep.subdivide(inf);
+
+    const std::size_t n = polygon.size();
+    //相邻两条边在公共顶点处的连接不是自交
+    auto atCommonVertex = [&](const EdgeIntersection &h) {
+        return (h.edgeB == h.edgeA + 1 && h.point == polygon[h.edgeB]) || (h.edgeA == 0 && h.edgeB + 1 == n && h.point == polygon[0]);
+    };
+    crossings.erase(std::remove_if(crossings.begin(), crossings.end(), atCommonVertex), crossings.end());
+    auto alphaOn = [&](std::size_t edge, const Point &p) {
+        const Point &a = polygon[edge];
+        const Point d = polygon[(edge + 1) % n] - a;
+        return ((p.x - a.x) * d.x + (p.y - a.y) * d.y) / (d.x * d.x + d.y * d.y);
+    };
+    for (EdgeIntersection &hit : crossings) {
+        hit.alphaA = alphaOn(hit.edgeA, hit.point);
+        hit.alphaB = alphaOn(hit.edgeB, hit.point);
+    }
+    auto key = [](const EdgeIntersection &h) { return std::make_tuple(h.edgeA, h.edgeB, h.point.x, h.point.y); };
+    std::sort(crossings.begin(), crossings.end(), [&](const EdgeIntersection &a, const EdgeIntersection &b) { return key(a) < key(b); });
+    crossings.erase(std::unique(crossings.begin(), crossings.end(),
+                                [&](const EdgeIntersection &a, const EdgeIntersection &b) { return key(a) == key(b); }),
+                    crossings.end());
+    return crossings;
+}
+
+/**
+ * @brief 把可能自相交的多边形修复为互不重叠的合法区域（make-valid）
+ * @details 扫描线在所有交点处细分边，共线重叠的边合并为一条并累加环绕数变化；
+ * 每条线段插入状态时，由下方紧邻的线段得到它下方的环绕数，加上自身的贡献即为上方的环绕数，
+ * 按填充规则判断两侧是否在区域内，只有两侧不同的线段才是结果的边界。
+ * 边界连接与孔洞归属沿用布尔运算的轮廓连接，最后在重复顶点处拆开自我接触的环，使每个环都是简单多边形。
+ * @param rings 输入的所有环（可自相交、互相交叠；NonZero 规则下环的方向有意义）
+ * @param rule 填充规则：EvenOdd 按穿过边界的次数的奇偶，NonZero 按环绕数是否为零
+ * @param stats [out] 可选：交点数与两阶段耗时、分配统计
+ * @return 互不重叠的区域，每个区域的外边界为逆时针、孔洞为顺时针（数学坐标系）
+ * @complexity O((n + k) log n)
+ */
+std::vector<PolygonWithHoles> makeValid(Span<Polygon> rings, FillRule rule, BooleanOpStats *stats)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto begin = Clock::now();
+    AllocationCounter memory;
+    const double inf = std::numeric_limits<double>::infinity();
+    double box[4] = {inf, inf, -inf, -inf};
+
+    MartinezSweep sweep(BooleanOpType::Union, memory);
+    sweep.setFillRule(rule);
+    sweep.addRings(rings, true, box);
+    sweep.subdivide(inf);
+    const auto connectBegin = Clock::now();
+    std::vector<PolygonWithHoles> output = assembleValidRegions(sweep.connectEdges());
+
+    if (stats) {
+        const auto end = Clock::now();
+        stats->intersectionCount = sweep.intersectionCount();
+        stats->discoveryMs = std::chrono::duration<double, std::milli>(connectBegin - begin).count();
+        stats->traversalMs = std::chrono::duration<double, std::milli>(end - connectBegin).count();
+        stats->allocationCount = memory.allocations;
+        stats->peakBytes = memory.peakBytes;
+    }
+    return output;
+}
+
+} // namespace Geometry
@@ -0,0 +1,37 @@
+#ifndef MARTINEZCLIPPER_H
+#define MARTINEZCLIPPER_H
+/*MartinezClipper 是基于扫描线的通用多边形裁剪（Martinez–Rueda–Feito 算法），支持四种布尔运算、孔洞与多区域；
+  同一条扫描线也用于报告单个多边形的自交点，并按填充规则把自相交的多边形修复为合法区域*/
+#include "BooleanOp.h"
+#include "GeometryTypes.h"
+#include "SegmentIntersection.h"
+
+namespace Geometry {
+
+/**
+ * @brief 通用多边形布尔运算（交集、并集、差集 subject − clipping、异或）
+ * @param subject 主多边形的所有环（外边界、孔洞、多个分离区域均可），按奇偶规则解释，环的方向无关
+ * @param clipping 裁剪多边形的所有环，规则同上
+ * @param opType 运算类型
+ * @param stats [out] 可选：交点数、扫描与细分耗时（discoveryMs）、轮廓连接耗时（traversalMs）、分配统计
+ * @return 结果区域，每个区域的外边界为逆时针、孔洞为顺时针（数学坐标系）
+ * @complexity O((n + k) log n)，n 为总边数，k 为交点数
+ */
+std::vector<PolygonWithHoles> booleanOpMartinez(Span<Polygon> subject, Span<Polygon> clipping, BooleanOpType opType,
+                                                BooleanOpStats *stats = nullptr);
+
+//填充规则：决定自相交或互相交叠的环围住的哪些部分属于区域
+enum class FillRule {
+    EvenOdd, // 从该处出发的射线穿过边界奇数次
+    NonZero  // 环绕数不为零（环的方向有意义）
+};
+
+// 报告单个多边形的全部自交点（不相邻边的交叉、顶点落在其他边内部、共线重叠），O((n + k) log n)
+std::vector<EdgeIntersection> findSelfIntersections(PointSpan polygon);
+
+// 按填充规则把可能自相交的环修复为互不重叠的简单区域（外边界逆时针、孔洞顺时针），O((n + k) log n)
+std::vector<PolygonWithHoles> makeValid(Span<Polygon> rings, FillRule rule, BooleanOpStats *stats = nullptr);
+
+} // namespace Geometry
+
+#endif // MARTINEZCLIPPER_H
@@ -0,0 +1,227 @@
+#include "PointInPolygonIndex.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+namespace Geometry {
+
+PointInPolygonIndex::PointInPolygonIndex(PointSpan polygon)
+{
+    build({polygon});
+}
+
+PointInPolygonIndex::PointInPolygonIndex(const PolygonWithHoles &polygon)
+{
+    std::vector<PointSpan> rings{polygon.outer};
+    for (const Polygon &hole : polygon.holes) rings.push_back(hole);
+    build(rings);
+}
+
+std::size_t PointInPolygonIndex::columnOf(double x) const
+{
+    const double c = std::floor((x - m_minX) / m_cellWidth);
+    if (!(c > 0)) return 0;
+    return c >= static_cast<double>(m_columns) ? m_columns - 1 : static_cast<std::size_t>(c);
+}
+
+std::size_t PointInPolygonIndex::rowOf(double y) const
+{
+    const double r = std::floor((y - m_minY) / m_cellHeight);
+    if (!(r > 0)) return 0;
+    return r >= static_cast<double>(m_rows) ? m_rows - 1 : static_cast<std::size_t>(r);
+}
+
+/**
+ * @brief 边在某一行（上下各放宽 m_pad）内的部分覆盖的列范围 [first, last]
+ * @details 列范围左右再各放宽 m_pad，所以编号小于 first 的格子里任意一点都严格位于这段边的左侧。
+ * @return 边与这一行不相交时返回 false
+ */
+bool PointInPolygonIndex::columnRange(std::size_t edge, std::size_t row, std::size_t &first, std::size_t &last) const
+{
+    const Point &a = m_vertices[edge];
+    const Point &b = m_vertices[m_next[edge]];
+    const double bottom = rowBottom(row), top = rowTop(row);
+    const double low = std::min(a.y, b.y), high = std::max(a.y, b.y);
+    if (low > top || high < bottom) return false;
+
+    double x0 = a.x, x1 = b.x;
+    if (a.y != b.y) {
+        auto xAt = [&](double y) {
+            if (y == a.y) return a.x;
+            if (y == b.y) return b.x;
+            return a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y);
+        };
+        x0 = xAt(std::max(low, bottom));
+        x1 = xAt(std::min(high, top));
+    }
+    first = columnOf(std::min(x0, x1) - m_pad);
+    last = columnOf(std::max(x0, x1) + m_pad);
+    return true;
+}
+
+//枚举边经过的每一行，以及它在该行内覆盖的列范围
+template <typename Visit>
+void PointInPolygonIndex::forEachCell(std::size_t edge, Visit visit) const
+{
+    const Point &a = m_vertices[edge];
+    const Point &b = m_vertices[m_next[edge]];
+    const std::size_t firstRow = rowOf(std::min(a.y, b.y) - m_pad);
+    const std::size_t lastRow = rowOf(std::max(a.y, b.y) + m_pad);
+    for (std::size_t row = firstRow; row <= lastRow; ++row) {
+        std::size_t first, last;
+        if (columnRange(edge, row, first, last)) visit(row, first, last);
+    }
+}
+
+/**
+ * @brief 建立网格索引
+ * @details 1. 网格取约 n 个格子，长宽比与包围盒一致；
+ * 2. 每条边登记到它经过的格子（先计数再填充，CSR 存储）；同时对跨过行底线的边，
+ *    把它左侧的所有格子的底线奇偶翻转一次（差分后按行求前缀异或）；
+ * 3. 行内的顶点 v 若一条邻边穿过格子、另一条邻边整段在格子右侧，右侧边数的奇偶在 v.y 处翻转，记入该格。
+ *    两条邻边都在右侧时两次翻转抵消，不必记录；这样的顶点只会从穿过格子的那条边被找到一次。
+ * @complexity O(n + 格子数 + 边经过的格子总数)
+ */
+void PointInPolygonIndex::build(const std::vector<PointSpan> &rings)
+{
+    for (PointSpan ring : rings) {
+        if (ring.size() < 3) continue; // 与 isPointInsidePolygon 一致：不足 3 个顶点的环不围成区域
+        const std::size_t offset = m_vertices.size();
+        const std::size_t m = ring.size();
+        for (std::size_t i = 0; i < m; ++i) {
+            m_vertices.push_back(ring[i]);
+            m_next.push_back(static_cast<std::uint32_t>(offset + (i + 1) % m));
+            m_prev.push_back(static_cast<std::uint32_t>(offset + (i + m - 1) % m));
+        }
+    }
+    const std::size_t n = m_vertices.size();
+    if (n == 0) return;
+
+    m_minX = m_maxX = m_vertices[0].x;
+    m_minY = m_maxY = m_vertices[0].y;
+    for (const Point &p : m_vertices) {
+        m_minX = std::min(m_minX, p.x);
+        m_maxX = std::max(m_maxX, p.x);
+        m_minY = std::min(m_minY, p.y);
+        m_maxY = std::max(m_maxY, p.y);
+    }
+    const double width = m_maxX - m_minX, height = m_maxY - m_minY;
+    if (!(width > 0 && height > 0)) return; // 面积为零：所有点都在外部
+
+    auto dimension = [&](double ratio) {
+        const double d = std::round(std::sqrt(static_cast<double>(n) * ratio));
+        return static_cast<std::size_t>(std::min(std::max(d, 1.0), static_cast<double>(n)));
+    };
+    m_columns = dimension(width / height);
+    m_rows = dimension(height / width);
+    m_cellWidth = width / static_cast<double>(m_columns);
+    m_cellHeight = height / static_cast<double>(m_rows);
+    const double magnitude = std::max({std::abs(m_minX), std::abs(m_maxX), std::abs(m_minY), std::abs(m_maxY)});
+    m_pad = 1e-9 * std::max(m_cellWidth, m_cellHeight) + 8 * std::numeric_limits<double>::epsilon() * magnitude;
+
+    // 2. 登记边，并累计每行底线处右侧边的奇偶
+    const std::size_t cells = m_columns * m_rows;
+    m_cellStart.assign(cells + 1, 0);
+    m_baseParity.assign(cells, 0);
+    for (std::size_t e = 0; e < n; ++e) {
+        const Point &a = m_vertices[e];
+        const Point &b = m_vertices[m_next[e]];
+        forEachCell(e, [&](std::size_t row, std::size_t first, std::size_t last) {
+            for (std::size_t c = first; c <= last; ++c) ++m_cellStart[row * m_columns + c + 1];
+            const double bottom = rowBottom(row);
+            if ((a.y > bottom) != (b.y > bottom) && first > 0) {
+                m_baseParity[row * m_columns] ^= 1;
+                m_baseParity[row * m_columns + first] ^= 1;
+            }
+        });
+    }
+    for (std::size_t i = 0; i < cells; ++i) m_cellStart[i + 1] += m_cellStart[i];
+    m_cellEdges.resize(m_cellStart[cells]);
+    std::vector<std::uint32_t> cursor(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (std::size_t e = 0; e < n; ++e) {
+        forEachCell(e, [&](std::size_t row, std::size_t first, std::size_t last) {
+            for (std::size_t c = first; c <= last; ++c) m_cellEdges[cursor[row * m_columns + c]++] = static_cast<std::uint32_t>(e);
+        });
+    }
+    for (std::size_t row = 0; row < m_rows; ++row) {
+        for (std::size_t c = 1; c < m_columns; ++c) m_baseParity[row * m_columns + c] ^= m_baseParity[row * m_columns + c - 1];
+    }
+
+    // 3. 行内右侧边奇偶的翻转高度
+    m_toggleStart.assign(cells + 1, 0);
+    for (std::size_t cell = 0; cell < cells; ++cell) {
+        const std::size_t row = cell / m_columns, column = cell % m_columns;
+        const double bottom = rowBottom(row), top = rowTop(row);
+        auto check = [&](const Point &v, std::size_t other) {
+            if (!(v.y > bottom && v.y <= top)) return;
+            std::size_t first, last;
+            if (columnRange(other, row, first, last) && column < first) m_toggleY.push_back(v.y);
+        };
+        for (std::uint32_t k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+            const std::uint32_t e = m_cellEdges[k];
+            check(m_vertices[e], m_prev[e]);                 // 起点处的另一条邻边
+            check(m_vertices[m_next[e]], m_next[e]);         // 终点处的另一条邻边
+        }
+        m_toggleStart[cell + 1] = static_cast<std::uint32_t>(m_toggleY.size());
+    }
+}
+
+/**
+ * @brief 单点查询
+ * @details 本格中的边按 isPointInsidePolygon 的同一公式判定，右侧的边取格子的底线奇偶，再按不高于查询点的翻转高度修正。
+ * 包围盒之外（含右边界与上边界）直接返回 false，这与射线法的结论相同。
+ * @complexity O(1 + k)，k 为所在格子中登记的边数
+ */
+bool PointInPolygonIndex::contains(const Point &point) const
+{
+    if (m_columns == 0) return false;
+    if (!(point.x >= m_minX && point.x < m_maxX && point.y >= m_minY && point.y < m_maxY)) return false;
+
+    const std::size_t cell = rowOf(point.y) * m_columns + columnOf(point.x);
+    bool inside = m_baseParity[cell] != 0;
+    for (std::uint32_t k = m_toggleStart[cell]; k < m_toggleStart[cell + 1]; ++k) {
+        if (m_toggleY[k] <= point.y) inside = !inside;
+    }
+    for (std::uint32_t k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+        const std::uint32_t e = m_cellEdges[k];
+        const Point &p_j = m_vertices[e];
+        const Point &p_i = m_vertices[m_next[e]];
+        if ((p_i.y > point.y) != (p_j.y > point.y)) {
+            const double x_intersect = (p_j.x - p_i.x) * (point.y - p_i.y) / (p_j.y - p_i.y) + p_i.x;
+            if (point.x < x_intersect) inside = !inside;
+        }
+    }
+    return inside;
+}
+
+/**
+ * @brief 批量查询
+ * @details 索引只读，各线程互不干扰；点数少于每线程的最低份额时在调用线程上串行完成。
+ */
+std::vector<char> PointInPolygonIndex::contains(PointSpan points, unsigned threadCount) const
+{
+    const std::size_t n = points.size();
+    std::vector<char> inside(n);
+    const std::size_t minPerThread = 1 << 14; // 每个线程至少分到的点数，少于此值时并行不划算
+    const unsigned T = static_cast<unsigned>(std::min<std::size_t>(ThreadPool::resolveThreadCount(threadCount), n / minPerThread));
+    if (T <= 1) {
+        for (std::size_t i = 0; i < n; ++i) inside[i] = contains(points[i]);
+        return inside;
+    }
+
+    // 线程数超出共享线程池时，为本次查询单独建一个池
+    ThreadPool *pool = &ThreadPool::global();
+    std::unique_ptr<ThreadPool> ownPool;
+    if (T > pool->size()) {
+        ownPool = std::make_unique<ThreadPool>(T);
+        pool = ownPool.get();
+    }
+    pool->parallelFor(T, [&](std::size_t c) {
+        for (std::size_t i = c * n / T, end = (c + 1) * n / T; i < end; ++i) inside[i] = contains(points[i]);
+    });
+    return inside;
+}
+
+} // namespace Geometry
@@ -0,0 +1,63 @@
+#ifndef POINTINPOLYGONINDEX_H
+#define POINTINPOLYGONINDEX_H
+/*PointInPolygonIndex 对同一个多边形预处理一次，之后每次点包含查询只检查查询点所在格子里的边*/
+#include "GeometryTypes.h"
+#include <cstdint>
+
+namespace Geometry {
+
+/**
+ * @brief 预处理的点包含查询索引
+ * @details 包围盒划分为约 n 个格子的均匀网格，每个格子登记穿过它的边。射线法中查询点右侧的边分为三类：
+ * 穿过本格的边逐条判定；整段位于本格左侧的边不计；整段位于本格右侧的边只影响奇偶，
+ * 其贡献等于“格子所在行底线处的奇偶”再按行内这些边端点的高度翻转，两者都在构建时算好存入格子。
+ * 因此查询只与本格中的边数有关，边分布均匀时为 O(1)。结果与 isPointInsidePolygon 一致（奇偶规则，自相交的多边形同样适用），
+ * 唯一的区别是包围盒右边界上的点一律判为外部，射线法在那里只会因舍入得出“内部”。
+ */
+class PointInPolygonIndex
+{
+public:
+    PointInPolygonIndex() = default;
+
+    // 为一个环建立索引，O(n)（边长与格子相当时）
+    explicit PointInPolygonIndex(PointSpan polygon);
+
+    // 为带孔洞的多边形建立索引：外边界与孔洞一起按奇偶规则判定
+    explicit PointInPolygonIndex(const PolygonWithHoles &polygon);
+
+    // 点是否在多边形内部，与 isPointInsidePolygon 的结果相同
+    bool contains(const Point &point) const;
+
+    // 批量查询：inside[i] 为 points[i] 是否在内部；点数较多时分块并行，threadCount 为 0 时使用全部核心
+    std::vector<char> contains(PointSpan points, unsigned threadCount = 0) const;
+
+    std::size_t edgeCount() const { return m_vertices.size(); }
+    std::size_t cellCount() const { return m_columns * m_rows; }
+
+private:
+    void build(const std::vector<PointSpan> &rings);
+    std::size_t columnOf(double x) const;
+    std::size_t rowOf(double y) const;
+    double rowBottom(std::size_t row) const { return m_minY + static_cast<double>(row) * m_cellHeight - m_pad; }
+    double rowTop(std::size_t row) const { return m_minY + static_cast<double>(row + 1) * m_cellHeight + m_pad; }
+    bool columnRange(std::size_t edge, std::size_t row, std::size_t &first, std::size_t &last) const;
+    template <typename Visit>
+    void forEachCell(std::size_t edge, Visit visit) const;
+
+    std::vector<Point> m_vertices;      // 所有环的顶点，边 i 从顶点 i 指向 m_next[i]
+    std::vector<std::uint32_t> m_next;  // 同一环中的下一个顶点
+    std::vector<std::uint32_t> m_prev;  // 同一环中的上一个顶点（即终点为顶点 i 的边）
+    double m_minX = 0.0, m_minY = 0.0, m_maxX = 0.0, m_maxY = 0.0;
+    double m_cellWidth = 1.0, m_cellHeight = 1.0;
+    double m_pad = 0.0;                 // 登记边时向外放宽的距离，吸收坐标换算格子时的舍入
+    std::size_t m_columns = 0, m_rows = 0;
+    std::vector<std::uint32_t> m_cellStart;  // 格子 -> m_cellEdges 中的起始位置（CSR）
+    std::vector<std::uint32_t> m_cellEdges;
+    std::vector<std::uint32_t> m_toggleStart; // 格子 -> m_toggleY 中的起始位置（CSR）
+    std::vector<double> m_toggleY;            // 右侧边的奇偶在这些高度处翻转（查询点 y 不小于它时生效）
+    std::vector<char> m_baseParity;           // 格子所在行底线处，整段位于格子右侧的边数的奇偶
+};
+
+} // namespace Geometry
+
+#endif // POINTINPOLYGONINDEX_H
@@ -0,0 +1,208 @@
+#include "PointInPolygonSimd.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GEOMETRY_HAVE_SSE2 1
+#endif
+
+// AVX2 版本单独以 avx2 目标编译，是否调用由运行时检测决定，因此整个库不需要 -mavx2
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define GEOMETRY_HAVE_AVX2 1
+#define GEOMETRY_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#include <immintrin.h>
+#include <intrin.h>
+#define GEOMETRY_HAVE_AVX2 1
+#define GEOMETRY_TARGET_AVX2
+#endif
+
+namespace Geometry {
+
+namespace {
+
+/**
+ * @brief 按结构数组存放的非水平边
+ * @details 边 p_j -> p_i 与 isPointInsidePolygon 中的记号一致；交点横坐标取 (y - yi) * slope + xi，
+ * 斜率在预处理时算好，内层循环里不再有除法。水平边永远不会被射线计数，直接略去。
+ */
+struct EdgeTable {
+    std::vector<double> yi, yj, xi, slope;
+    std::size_t size() const { return yi.size(); }
+};
+
+EdgeTable buildEdgeTable(PointSpan polygon)
+{
+    EdgeTable edges;
+    const std::size_t n = polygon.size();
+    if (n < 3) return edges;
+    edges.yi.reserve(n);
+    edges.yj.reserve(n);
+    edges.xi.reserve(n);
+    edges.slope.reserve(n);
+    for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+        const Point &p_i = polygon[i];
+        const Point &p_j = polygon[j];
+        if (p_i.y == p_j.y) continue;
+        edges.yi.push_back(p_i.y);
+        edges.yj.push_back(p_j.y);
+        edges.xi.push_back(p_i.x);
+        edges.slope.push_back((p_j.x - p_i.x) / (p_j.y - p_i.y));
+    }
+    return edges;
+}
+
+void maskScalar(const EdgeTable &edges, const double *xs, const double *ys, std::size_t begin, std::size_t end,
+                std::uint64_t *mask)
+{
+    for (std::size_t i = begin; i < end; ++i) {
+        const double x = xs[i], y = ys[i];
+        bool inside = false;
+        for (std::size_t e = 0; e < edges.size(); ++e) {
+            if ((edges.yi[e] > y) != (edges.yj[e] > y) && x < (y - edges.yi[e]) * edges.slope[e] + edges.xi[e]) {
+                inside = !inside;
+            }
+        }
+        if (inside) mask[i / 64] |= std::uint64_t(1) << (i % 64);
+    }
+}
+
+#ifdef GEOMETRY_HAVE_SSE2
+//每轮取 8 个点（4 个寄存器 × 2 道），每条边只读入一次
+void maskSse2(const EdgeTable &edges, const double *xs, const double *ys, std::size_t count, std::uint64_t *mask)
+{
+    constexpr std::size_t Tile = 8;
+    std::size_t i = 0;
+    for (; i + Tile <= count; i += Tile) {
+        __m128d x[4], y[4], acc[4];
+        for (int k = 0; k < 4; ++k) {
+            x[k] = _mm_loadu_pd(xs + i + 2 * k);
+            y[k] = _mm_loadu_pd(ys + i + 2 * k);
+            acc[k] = _mm_setzero_pd();
+        }
+        for (std::size_t e = 0; e < edges.size(); ++e) {
+            const __m128d yi = _mm_set1_pd(edges.yi[e]);
+            const __m128d yj = _mm_set1_pd(edges.yj[e]);
+            const __m128d xi = _mm_set1_pd(edges.xi[e]);
+            const __m128d slope = _mm_set1_pd(edges.slope[e]);
+            for (int k = 0; k < 4; ++k) {
+                const __m128d straddle = _mm_xor_pd(_mm_cmpgt_pd(yi, y[k]), _mm_cmpgt_pd(yj, y[k]));
+                const __m128d xCross = _mm_add_pd(_mm_mul_pd(_mm_sub_pd(y[k], yi), slope), xi);
+                acc[k] = _mm_xor_pd(acc[k], _mm_and_pd(straddle, _mm_cmplt_pd(x[k], xCross)));
+            }
+        }
+        std::uint64_t bits = 0;
+        for (int k = 0; k < 4; ++k) bits |= std::uint64_t(_mm_movemask_pd(acc[k])) << (2 * k);
+        mask[i / 64] |= bits << (i % 64);
+    }
+    maskScalar(edges, xs, ys, i, count, mask);
+}
+#endif
+
+#ifdef GEOMETRY_HAVE_AVX2
+//每轮取 16 个点（4 个寄存器 × 4 道）；16 整除 64，一轮的结果总落在同一个字里
+GEOMETRY_TARGET_AVX2
+void maskAvx2(const EdgeTable &edges, const double *xs, const double *ys, std::size_t count, std::uint64_t *mask)
+{
+    constexpr std::size_t Tile = 16;
+    std::size_t i = 0;
+    for (; i + Tile <= count; i += Tile) {
+        __m256d x[4], y[4], acc[4];
+        for (int k = 0; k < 4; ++k) {
+            x[k] = _mm256_loadu_pd(xs + i + 4 * k);
+            y[k] = _mm256_loadu_pd(ys + i + 4 * k);
+            acc[k] = _mm256_setzero_pd();
+        }
+        for (std::size_t e = 0; e < edges.size(); ++e) {
+            const __m256d yi = _mm256_broadcast_sd(&edges.yi[e]);
+            const __m256d yj = _mm256_broadcast_sd(&edges.yj[e]);
+            const __m256d xi = _mm256_broadcast_sd(&edges.xi[e]);
+            const __m256d slope = _mm256_broadcast_sd(&edges.slope[e]);
+            for (int k = 0; k < 4; ++k) {
+                const __m256d straddle = _mm256_xor_pd(_mm256_cmp_pd(yi, y[k], _CMP_GT_OQ), _mm256_cmp_pd(yj, y[k], _CMP_GT_OQ));
+                const __m256d xCross = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(y[k], yi), slope), xi);
+                acc[k] = _mm256_xor_pd(acc[k], _mm256_and_pd(straddle, _mm256_cmp_pd(x[k], xCross, _CMP_LT_OQ)));
+            }
+        }
+        std::uint64_t bits = 0;
+        for (int k = 0; k < 4; ++k) bits |= std::uint64_t(_mm256_movemask_pd(acc[k])) << (4 * k);
+        mask[i / 64] |= bits << (i % 64);
+    }
+    maskScalar(edges, xs, ys, i, count, mask);
+}
+
+bool cpuHasAvx2()
+{
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    // 需要 CPU 支持 AVX2，且操作系统保存 YMM 寄存器（OSXSAVE 置位、XCR0 的 SSE/AVX 两位均开启）
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    if (!(info[2] & (1 << 27))) return false;
+    if ((_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#endif
+}
+#endif
+
+SimdLevel detectSimdLevel()
+{
+#ifdef GEOMETRY_HAVE_AVX2
+    if (cpuHasAvx2()) return SimdLevel::AVX2;
+#endif
+#ifdef GEOMETRY_HAVE_SSE2
+    return SimdLevel::SSE2;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+} // namespace
+
+SimdLevel bestSimdLevel()
+{
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+/**
+ * @brief 批量点包含判定
+ * @details 外层按固定大小的一组查询点推进，内层扫过所有边：每条边广播到寄存器后同时测试一组点，
+ * 各点的奇偶累积在掩码寄存器里，最后用 movemask 直接写成结果位。不足一组的尾部用标量循环完成。
+ * 判定规则与 isPointInsidePolygon 相同（同样的半开区间与向右射线），只是交点横坐标由预先算好的斜率求出，
+ * 距边界在舍入误差以内的点可能与之不同；各指令集版本之间的结果完全一致。
+ */
+std::vector<std::uint64_t> pointsInPolygonMask(PointSpan polygon, Span<double> xs, Span<double> ys, SimdLevel level)
+{
+    const std::size_t count = std::min(xs.size(), ys.size());
+    std::vector<std::uint64_t> mask((count + 63) / 64, 0);
+    const EdgeTable edges = buildEdgeTable(polygon);
+    if (edges.size() == 0 || count == 0) return mask;
+
+    const SimdLevel best = bestSimdLevel();
+    if (level == SimdLevel::Auto || level > best) level = best;
+    switch (level) {
+#ifdef GEOMETRY_HAVE_AVX2
+    case SimdLevel::AVX2:
+        maskAvx2(edges, xs.data(), ys.data(), count, mask.data());
+        break;
+#endif
+#ifdef GEOMETRY_HAVE_SSE2
+    case SimdLevel::SSE2:
+        maskSse2(edges, xs.data(), ys.data(), count, mask.data());
+        break;
+#endif
+    default:
+        maskScalar(edges, xs.data(), ys.data(), 0, count, mask.data());
+        break;
+    }
+    return mask;
+}
+
+} // namespace Geometry
@@ -0,0 +1,29 @@
+#ifndef POINTINPOLYGONSIMD_H
+#define POINTINPOLYGONSIMD_H
+/*PointInPolygonSimd 是不做预处理的批量点包含判定：查询点以结构数组（SoA）给出，每条边同时测试多个查询点*/
+#include "GeometryTypes.h"
+#include <cstdint>
+
+namespace Geometry {
+
+//批量判定使用的指令集；Auto 表示运行时检测 CPU 后选择最快的一种
+enum class SimdLevel { Auto, Scalar, SSE2, AVX2 };
+
+// 当前 CPU 与编译器都支持的最高级别（结果在首次调用时检测并缓存）
+SimdLevel bestSimdLevel();
+
+/**
+ * @brief 批量判断点 (xs[i], ys[i]) 是否在多边形内部（奇偶规则，与 isPointInsidePolygon 相同的射线法）
+ * @param polygon 多边形顶点（方向任意，可自相交）
+ * @param xs 查询点的 x 坐标
+ * @param ys 查询点的 y 坐标，个数取两者中较小的一个
+ * @param level 指令集；请求的级别不可用时退回到可用的最高级别
+ * @return 按位打包的结果：第 i 个点在内部时 mask[i / 64] 的第 i % 64 位为 1
+ * @complexity O(n·m / 每次并行测试的点数)
+ */
+std::vector<std::uint64_t> pointsInPolygonMask(PointSpan polygon, Span<double> xs, Span<double> ys,
+                                               SimdLevel level = SimdLevel::Auto);
+
+} // namespace Geometry
+
+#endif // POINTINPOLYGONSIMD_H
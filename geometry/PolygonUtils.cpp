@@ -0,0 +1,338 @@
+#include "PolygonUtils.h"
+#include "Predicates.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <set>
+
+namespace Geometry {
+
+/**
+ * @brief 使用鞋带公式(Shoelace Formula)计算多边形的有向面积的两倍
+ *
+ * @details 遍历多边形的所有边，累加每条边与其下一个顶点构成的叉积。
+ * 最终结果的符号可以用来判断多边形顶点的环绕方向。
+ *
+ * @param pts 多边形的顶点列表
+ * @return double
+ * - > 0: 在Qt坐标系下，表示顶点为顺时针环绕。
+ * - < 0: 在Qt坐标系下，表示顶点为逆时针环绕。
+ * - = 0: 多边形退化为线段或面积为零。
+ * @note 此函数是确保耳切法等算法输入方向一致性的关键。
+ */
+double computeAreaSign(PointSpan pts)
+{
+    double sum = 0.0;
+    for (std::size_t i = 0; i < pts.size(); ++i) {
+        const Point &p1 = pts[i];
+        const Point &p2 = pts[(i + 1) % pts.size()];
+        sum += (p1.x * p2.y - p2.x * p1.y);
+    }
+    return sum;
+}
+
+/**
+ * @brief 使用 Shoelace (鞋带) 公式计算多边形面积。
+ * @details 通过计算多边形顶点坐标的叉积和来得到面积。
+ * @complexity O(n)
+ */
+double polygonArea(PointSpan pts)
+{
+    return std::abs(computeAreaSign(pts)) / 2.0;
+}
+
+namespace {
+
+inline bool lexLess(const Point &a, const Point &b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+/**
+ * @brief Shamos–Hoey 扫描线的状态比较器：边 e 指从顶点 e 到 to(e) 的边，按扫描位置上的上下顺序排列
+ * @details 扫描线自左向右（x 相同时自下而上，相当于微微倾斜）推进。两条边都在状态中时，
+ * 左端点较晚到达的那条边的左端点一定落在另一条边的扫描范围内，所以只需一次叉积判断它在另一条边的哪一侧；
+ * 恰好落在另一条边上时改用右端点判断，仍共线时按边号区分。比较只依赖两条边本身，
+ * 因此在遇到第一个交点之前，状态中的相对顺序始终不变。
+ */
+struct EdgeBelow {
+    PointSpan poly;
+    const std::uint32_t *succ = nullptr; //多个环时每个顶点的后继；为空表示 poly 是单个首尾相接的环
+
+    std::size_t to(int e) const { return succ ? succ[e] : (e + 1) % poly.size(); }
+    const Point &left(int e) const
+    {
+        const Point &p = poly[e], &q = poly[to(e)];
+        return lexLess(p, q) ? p : q;
+    }
+    const Point &right(int e) const
+    {
+        const Point &p = poly[e], &q = poly[to(e)];
+        return lexLess(p, q) ? q : p;
+    }
+
+    bool operator()(int a, int b) const
+    {
+        if (a == b) return false;
+        if (!lexLess(left(a), left(b))) {
+            double s = crossProduct(left(b), right(b), left(a));
+            if (s == 0) s = crossProduct(left(b), right(b), right(a));
+            return s != 0 ? s < 0 : a < b;
+        }
+        return !(*this)(b, a);
+    }
+};
+
+//多边形的两条边 i、j（i != j）是否构成非法接触：相邻边只允许在公共顶点处接触，不相邻边不得相交
+bool edgesOverlap(PointSpan poly, std::size_t i, std::size_t j)
+{
+    const std::size_t n = poly.size();
+    if ((j + 1) % n == i) std::swap(i, j);
+    if ((i + 1) % n == j) return edgesFoldBack(poly[i], poly[j], poly[(j + 1) % n]);
+    return edgesIntersect(poly[i], poly[(i + 1) % n], poly[j], poly[(j + 1) % n]);
+}
+
+/**
+ * @brief Shamos–Hoey 扫描：按字典序处理各边的左右端点，只检查在状态中新变为相邻的边对
+ * @param crosses 两条边是否构成非法接触
+ * @param visitPoint 按扫描顺序对每个事件点回调（同一位置可能回调多次），返回 false 时结束
+ * @param inserted 边插入状态后回调，参数为边号及其在状态中的位置，返回 false 时结束
+ * @return 扫描完所有事件且没有发现非法接触时返回 true
+ */
+template <typename Crosses, typename VisitPoint, typename Inserted>
+bool sweepEdges(const EdgeBelow &below, std::size_t edgeCount, Crosses crosses, VisitPoint visitPoint, Inserted inserted)
+{
+    //事件：边号的两倍表示左端点（插入），两倍加一表示右端点（删除）；同一位置上先删除后插入
+    std::vector<std::uint32_t> events(2 * edgeCount);
+    std::iota(events.begin(), events.end(), 0u);
+    auto eventPoint = [&](std::uint32_t ev) -> const Point & {
+        return (ev & 1) ? below.right(static_cast<int>(ev >> 1)) : below.left(static_cast<int>(ev >> 1));
+    };
+    std::sort(events.begin(), events.end(), [&](std::uint32_t a, std::uint32_t b) {
+        const Point &p = eventPoint(a), &q = eventPoint(b);
+        if (p != q) return lexLess(p, q);
+        return (a & 1) > (b & 1);
+    });
+
+    using Status = std::set<int, EdgeBelow>;
+    Status status(below);
+    std::vector<typename Status::iterator> handles(edgeCount, status.end());
+    for (std::uint32_t ev : events) {
+        const int e = static_cast<int>(ev >> 1);
+        if (!visitPoint(e, eventPoint(ev))) return false;
+        if ((ev & 1) == 0) {
+            const auto h = status.insert(e).first;
+            handles[e] = h;
+            if (h != status.begin() && crosses(*std::prev(h), e)) return false;
+            if (std::next(h) != status.end() && crosses(e, *std::next(h))) return false;
+            if (!inserted(e, h, status)) return false;
+        } else {
+            const auto h = handles[e];
+            const auto next = std::next(h);
+            if (h != status.begin() && next != status.end() && crosses(*std::prev(h), *next)) return false;
+            status.erase(h);
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief 检查一个多边形是否为“简单多边形”
+ *
+ * @details “简单多边形”指其任意两条不相邻的边都不会相交（判定沿用 `segmentsIntersect`：
+ * 端点落在另一条边内部也算相交，只在端点处接触不算），相邻的边不沿同一直线折返，且不存在零长度的退化边。
+ * 此函数使用 Shamos–Hoey 扫描线：把每条边的左右端点作为事件按字典序排序，
+ * 扫描线状态是按上下顺序排列边的平衡树，只在插入与删除时检查在状态中新变为相邻的边对。
+ * 若存在相交，最左侧的交点处的两条边在此之前必然在状态中相邻过，所以发现第一个交点即可返回。
+ *
+ * @param poly 多边形顶点列表
+ * @return bool 如果多边形是简单的（没有自相交），则返回 true；否则返回 false
+ *
+ * @note 这是执行三角剖分等高级算法前一个至关重要的合法性检查。
+ * @complexity O(n log n)，其中 n 是多边形的顶点数；发现相交时提前结束。
+ */
+bool isSimplePolygon(PointSpan poly)
+{
+    const std::size_t n = poly.size();
+    if (n <= 3) return true; // 少于等于3个顶点，不可能自相交
+
+    // 检查零长度边（退化边）。简单多边形不允许顶点重合或边长为零。
+    for (std::size_t i = 0; i < n; ++i) {
+        if (poly[i] == poly[(i + 1) % n]) return false;
+    }
+
+    auto crosses = [&](int a, int b) {
+        return edgesOverlap(poly, static_cast<std::size_t>(a), static_cast<std::size_t>(b));
+    };
+    return sweepEdges(EdgeBelow{poly}, n, crosses, [](int, const Point &) { return true; },
+                      [](int, auto, const auto &) { return true; }); // 没有发现自相交时为 true
+}
+
+/**
+ * @brief 检查带孔洞多边形是否合法
+ * @details 各环先去掉相邻重复点与首尾重复点，不足 3 个顶点的孔洞忽略（与三角剖分的预处理一致）。
+ * 所有环的边放在一起做一次 Shamos–Hoey 扫描，除了 isSimplePolygon 的各项检查外：
+ * - 不同的环不得有公共顶点：事件按位置排序，同一位置上出现两个环的事件即失败；
+ * - 孔洞严格位于外边界内部且互不包含：边两两不交时，孔洞最左侧的顶点紧贴下方的那条边（不属于该孔洞）
+ *   必须是外边界的下沿或另一个孔洞的上沿；“下沿/上沿”由边的走向与所在环的环绕方向决定。
+ * 更早扫描到的环都已通过检查，所以只看紧贴的这一条边就够了。
+ * @param polygon 外边界与孔洞（环绕方向任意）
+ * @return 外边界不足 3 个顶点、任一环自相交、环与环相交或接触、孔洞不在外边界内部或相互嵌套时返回 false
+ * @complexity O(n log n)，n 为所有环的顶点总数；发现问题时提前结束
+ */
+bool isSimplePolygonWithHoles(const PolygonWithHoles &polygon)
+{
+    std::vector<Point> pts;
+    std::vector<std::uint32_t> succ, ringOf, ringStart;
+    std::vector<bool> ccw; //各环是否逆时针（有向面积为正）
+    auto appendRing = [&](const Polygon &ring) {
+        const std::size_t first = pts.size();
+        for (const Point &p : ring) {
+            if (pts.size() == first || pts.back() != p) pts.push_back(p);
+        }
+        while (pts.size() > first + 1 && pts.back() == pts[first]) pts.pop_back();
+        if (pts.size() - first < 3) {
+            pts.resize(first);
+            return false;
+        }
+        const auto r = static_cast<std::uint32_t>(ringStart.size());
+        ringStart.push_back(static_cast<std::uint32_t>(first));
+        for (std::size_t i = first; i < pts.size(); ++i) {
+            succ.push_back(static_cast<std::uint32_t>(i + 1 < pts.size() ? i + 1 : first));
+            ringOf.push_back(r);
+        }
+        ccw.push_back(computeAreaSign(PointSpan(pts.data() + first, pts.size() - first)) > 0);
+        return true;
+    };
+    if (!appendRing(polygon.outer)) return false;
+    for (const Polygon &hole : polygon.holes) appendRing(hole);
+    const PointSpan all(pts.data(), pts.size());
+
+    //每个环最左侧（字典序最小）的顶点
+    std::vector<std::uint32_t> leftmost(ringStart);
+    for (std::uint32_t v = 0; v < pts.size(); ++v) {
+        if (lexLess(pts[v], pts[leftmost[ringOf[v]]])) leftmost[ringOf[v]] = v;
+    }
+
+    auto crosses = [&](int a, int b) {
+        if (static_cast<int>(succ[a]) == b) return edgesFoldBack(pts[a], pts[b], pts[succ[b]]);
+        if (static_cast<int>(succ[b]) == a) return edgesFoldBack(pts[b], pts[a], pts[succ[a]]);
+        return edgesIntersect(pts[a], pts[succ[a]], pts[b], pts[succ[b]]);
+    };
+    const Point *lastPoint = nullptr;
+    std::uint32_t lastRing = 0;
+    auto distinctRings = [&](int e, const Point &p) {
+        const bool shared = lastPoint && *lastPoint == p && lastRing != ringOf[e];
+        lastPoint = &p;
+        lastRing = ringOf[e];
+        return !shared;
+    };
+    auto insideRegion = [&](int e, auto h, const auto &status) {
+        const std::uint32_t r = ringOf[e];
+        if (r == 0 || (static_cast<std::uint32_t>(e) != leftmost[r] && succ[e] != leftmost[r])) return true;
+        //该顶点处孔洞的两条边相继插入，跳过同一孔洞的边找到紧贴下方的边
+        while (h != status.begin() && ringOf[*std::prev(h)] == r) --h;
+        if (h == status.begin()) return false;
+        const int below = *std::prev(h);
+        const bool rightward = lexLess(pts[below], pts[succ[below]]);
+        const bool interiorAbove = rightward == ccw[ringOf[below]];
+        return ringOf[below] == 0 ? interiorAbove : !interiorAbove;
+    };
+    return sweepEdges(EdgeBelow{all, succ.data()}, pts.size(), crosses, distinctRings, insideRegion);
+}
+
+/**
+ * @brief 检查多边形是否为凸多边形
+ *
+ * @details 跳过零长度边后，要求所有相邻边的转向（叉积符号）一致，且不出现原路折返的共线边；
+ * 仅凭转向一致还不能排除绕了多圈的星形，所以再统计边方向 x 分量的变号次数，
+ * 简单凸多边形绕一圈恰好变号两次（全部竖直时为零次）。
+ *
+ * @param poly 多边形顶点列表
+ * @return bool 是凸多边形（面积非零）时返回 true
+ * @complexity O(n)
+ */
+bool isConvexPolygon(PointSpan poly)
+{
+    const std::size_t n = poly.size();
+    if (n < 3) return false;
+
+    //从最后一条非零长度边开始，使第一条边也有“前一条边”可比较；x 分量的符号同理取最后一个非零值
+    Point prevEdge{0, 0};
+    int prevXSign = 0;
+    for (std::size_t i = n; i-- > 0;) {
+        const Point edge = poly[(i + 1) % n] - poly[i];
+        if (prevEdge == Point{0, 0}) prevEdge = edge;
+        if (prevXSign == 0) prevXSign = (edge.x > 0) - (edge.x < 0);
+        if (prevEdge != Point{0, 0} && prevXSign != 0) break;
+    }
+    if (prevEdge == Point{0, 0}) return false;
+
+    int turn = 0;       // 已确定的转向：+1 左转，-1 右转
+    int xSignFlips = 0; // 边方向 x 分量的变号次数
+    for (std::size_t i = 0; i < n; ++i) {
+        const Point edge = poly[(i + 1) % n] - poly[i];
+        if (edge == Point{0, 0}) continue;
+
+        const double cross = prevEdge.x * edge.y - prevEdge.y * edge.x;
+        if (cross != 0) {
+            const int s = cross > 0 ? 1 : -1;
+            if (turn != 0 && s != turn) return false;
+            turn = s;
+        } else if (prevEdge.x * edge.x + prevEdge.y * edge.y < 0) {
+            return false; // 原路折返
+        }
+
+        const int xSign = (edge.x > 0) - (edge.x < 0);
+        if (xSign != 0) {
+            if (xSign != prevXSign) ++xSignFlips;
+            prevXSign = xSign;
+        }
+        prevEdge = edge;
+    }
+    return turn != 0 && xSignFlips <= 2;
+}
+
+/**
+ * @brief 使用射线法（Ray Casting）判断一个点是否在多边形内部
+ *
+ * @details 从测试点向右发射一条水平射线，然后统计这条射线与多边形边的交点数量。
+ * 如果交点数量为奇数，则点在多边形内部；如果为偶数，则点在外部。
+ * 这是一个处理非凸多边形的经典算法。
+ *
+ * @param point 要测试的点
+ * @param polygon 多边形的顶点列表（应为封闭的）
+ * @return bool 如果点在多边形内部，返回 true；否则返回 false
+ * @complexity O(n)，其中 n 是多边形的顶点数。
+ */
+bool isPointInsidePolygon(const Point &point, PointSpan polygon)
+{
+    bool inside = false;
+    const std::size_t n = polygon.size();
+    if (n < 3) return false; //如果多边形顶点少于3个，不是合法多边形，直接返回 false
+
+    //循环遍历多边形的每一条边，时间复杂度O(n)
+    for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+        const Point &p_i = polygon[i];
+        const Point &p_j = polygon[j];
+
+        //检查点的Y坐标是否在当前边的Y坐标范围之内
+        bool y_intersect = ((p_i.y > point.y) != (p_j.y > point.y));
+
+        if (y_intersect) {
+            //计算从点向右发出的水平射线与当前边的交点的X坐标（相似三角形线性插值）
+            double x_intersect = (p_j.x - p_i.x) * (point.y - p_i.y) / (p_j.y - p_i.y) + p_i.x;
+
+            //如果交点的X坐标在点的右侧，说明射线穿过了这条边，切换一次内外状态
+            if (point.x < x_intersect) {
+                inside = !inside;
+            }
+        }
+    }
+    return inside;
+}
+
+} // namespace Geometry
@@ -0,0 +1,28 @@
+#ifndef POLYGONUTILS_H
+#define POLYGONUTILS_H
+/*PolygonUtils 收录对单个多边形的基础查询：面积、方向、简单性、凸性、点包含*/
+#include "GeometryTypes.h"
+
+namespace Geometry {
+
+// 鞋带公式求有向面积的两倍（Qt 坐标系下 >0 表示顺时针）
+double computeAreaSign(PointSpan pts);
+
+// 多边形面积（绝对值）
+double polygonArea(PointSpan pts);
+
+// 检查多边形是否为简单多边形（无自相交、无重叠边、无零长度边），Shamos–Hoey 扫描线，O(n log n)，发现相交即返回
+bool isSimplePolygon(PointSpan poly);
+
+// 检查带孔洞多边形是否合法：各环简单，环与环之间不相交也不接触，孔洞严格位于外边界内部且互不包含；一次扫描，O(n log n)
+bool isSimplePolygonWithHoles(const PolygonWithHoles &polygon);
+
+// 检查多边形是否为凸多边形（允许共线顶点与重复顶点，方向任意），O(n)
+bool isConvexPolygon(PointSpan poly);
+
+// 射线法判断点是否在多边形内部
+bool isPointInsidePolygon(const Point &point, PointSpan polygon);
+
+} // namespace Geometry
+
+#endif // POLYGONUTILS_H
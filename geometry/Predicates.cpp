@@ -0,0 +1,655 @@
+#include "Predicates.h"
+#include "Kernel.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace Geometry {
+
+namespace {
+
+/*
+ * 无误差的浮点展开式（Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates"）：
+ * 一个实数表示为若干个按绝对值递增、互不重叠的 double 之和，加法与乘法都不丢失任何位。
+ * 分量中的零随时剔除，展开式至少保留一个分量；最后一个分量的符号就是整个数的符号。
+ */
+
+//a + b = x + y，x 为舍入后的和，y 为舍入误差
+inline void twoSum(double a, double b, double &x, double &y)
+{
+    x = a + b;
+    const double bVirtual = x - a;
+    const double aVirtual = x - bVirtual;
+    y = (a - aVirtual) + (b - bVirtual);
+}
+
+//a - b = x + y
+inline void twoDiff(double a, double b, double &x, double &y)
+{
+    x = a - b;
+    const double bVirtual = a - x;
+    const double aVirtual = x + bVirtual;
+    y = (a - aVirtual) + (bVirtual - b);
+}
+
+//a · b = x + y；有 FMA 指令时直接求误差，否则用 Dekker 拆分（此时编译器也不会把乘加合并，拆分依然正确）
+inline void twoProduct(double a, double b, double &x, double &y)
+{
+    x = a * b;
+#if defined(__FMA__) || defined(__FP_FAST_FMA)
+    y = std::fma(a, b, -x);
+#else
+    auto split = [](double v, double &hi, double &lo) {
+        const double c = 134217729.0 * v; // 2^27 + 1
+        const double big = c - v;
+        hi = c - big;
+        lo = v - hi;
+    };
+    double ahi, alo, bhi, blo;
+    split(a, ahi, alo);
+    split(b, bhi, blo);
+    const double err1 = x - ahi * bhi;
+    const double err2 = err1 - alo * bhi;
+    const double err3 = err2 - ahi * blo;
+    y = alo * blo - err3;
+#endif
+}
+
+//容量为 N 个分量的展开式
+template <int N>
+struct Expansion {
+    double v[N];
+    int n = 0;
+
+    double estimate() const
+    {
+        double sum = 0.0;
+        for (int i = 0; i < n; ++i) sum += v[i];
+        return sum;
+    }
+};
+
+//按绝对值归并两个展开式后逐个累加（fast-expansion-sum，全部用 twoSum）
+int sumExpansion(int elen, const double *e, int flen, const double *f, double *h)
+{
+    int i = 0, j = 0, k = 0;
+    auto next = [&]() { return (j >= flen || (i < elen && std::abs(e[i]) < std::abs(f[j]))) ? e[i++] : f[j++]; };
+    double q = next();
+    while (i < elen || j < flen) {
+        double hh;
+        twoSum(q, next(), q, hh);
+        if (hh != 0) h[k++] = hh;
+    }
+    if (q != 0 || k == 0) h[k++] = q;
+    return k;
+}
+
+//展开式乘以一个 double（scale-expansion）
+int scaleExpansion(int elen, const double *e, double b, double *h)
+{
+    int k = 0;
+    double q, hh;
+    twoProduct(e[0], b, q, hh);
+    if (hh != 0) h[k++] = hh;
+    for (int i = 1; i < elen; ++i) {
+        double product1, product0, sum;
+        twoProduct(e[i], b, product1, product0);
+        twoSum(q, product0, sum, hh);
+        if (hh != 0) h[k++] = hh;
+        twoSum(product1, sum, q, hh);
+        if (hh != 0) h[k++] = hh;
+    }
+    if (q != 0 || k == 0) h[k++] = q;
+    return k;
+}
+
+Expansion<2> difference(double a, double b)
+{
+    Expansion<2> r;
+    double x, y;
+    twoDiff(a, b, x, y);
+    if (y != 0) r.v[r.n++] = y;
+    r.v[r.n++] = x;
+    return r;
+}
+
+template <int A, int B>
+Expansion<A + B> operator+(const Expansion<A> &e, const Expansion<B> &f)
+{
+    Expansion<A + B> r;
+    r.n = sumExpansion(e.n, e.v, f.n, f.v, r.v);
+    return r;
+}
+
+template <int A>
+Expansion<A> operator-(Expansion<A> e)
+{
+    for (int i = 0; i < e.n; ++i) e.v[i] = -e.v[i];
+    return e;
+}
+
+template <int A, int B>
+Expansion<A + B> operator-(const Expansion<A> &e, const Expansion<B> &f)
+{
+    return e + (-f);
+}
+
+//展开式相乘：e 依次乘以 f 的每个分量后累加
+template <int A, int B>
+Expansion<2 * A * B> operator*(const Expansion<A> &e, const Expansion<B> &f)
+{
+    Expansion<2 * A * B> r, next;
+    double scaled[2 * A];
+    r.n = scaleExpansion(e.n, e.v, f.v[0], r.v);
+    for (int i = 1; i < f.n; ++i) {
+        const int m = scaleExpansion(e.n, e.v, f.v[i], scaled);
+        next.n = sumExpansion(r.n, r.v, m, scaled, next.v);
+        std::copy(next.v, next.v + next.n, r.v);
+        r.n = next.n;
+    }
+    return r;
+}
+
+/**
+ * @brief 自适应谓词的计数器
+ * @details 每个线程累加自己的一组计数（只有本线程写入，relaxed 读写即可，不需要加锁的原子加法），
+ * 线程第一次调用谓词时把计数块登记到全局列表，退出时并入 retired。读取时汇总所有线程，
+ * 重置只记下当前的总数作为基线，不去改写其他线程正在累加的计数。
+ */
+enum PredicateCounterSlot { OrientA, OrientB, OrientC, OrientExact, InCircleA, InCircleB, InCircleC, InCircleExact, SlotCount };
+
+struct CounterBlock {
+    std::atomic<std::uint64_t> value[SlotCount] = {};
+};
+
+class CounterRegistry
+{
+public:
+    static CounterRegistry &instance()
+    {
+        static CounterRegistry registry;
+        return registry;
+    }
+
+    void attach(CounterBlock *block)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_live.push_back(block);
+    }
+
+    void detach(CounterBlock *block)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (int s = 0; s < SlotCount; ++s) m_retired[s] += block->value[s].load(std::memory_order_relaxed);
+        m_live.erase(std::find(m_live.begin(), m_live.end(), block));
+    }
+
+    //线程的计数块已析构后仍有调用（来自其他 thread_local 的析构函数），直接记入 retired
+    void addRetired(PredicateCounterSlot slot)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_retired[slot];
+    }
+
+    //所有线程的累计值减去上次重置时的基线
+    std::array<std::uint64_t, SlotCount> read()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::array<std::uint64_t, SlotCount> total = totals();
+        for (int s = 0; s < SlotCount; ++s) total[s] -= m_baseline[s];
+        return total;
+    }
+
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_baseline = totals();
+    }
+
+private:
+    std::array<std::uint64_t, SlotCount> totals() const
+    {
+        std::array<std::uint64_t, SlotCount> total = m_retired;
+        for (const CounterBlock *block : m_live) {
+            for (int s = 0; s < SlotCount; ++s) total[s] += block->value[s].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    std::mutex m_mutex;
+    std::vector<CounterBlock *> m_live;
+    std::array<std::uint64_t, SlotCount> m_retired{};
+    std::array<std::uint64_t, SlotCount> m_baseline{};
+};
+
+//线程退出时把本线程的计数并入 retired
+struct ThreadCounters {
+    CounterBlock block;
+    ThreadCounters() { CounterRegistry::instance().attach(&block); }
+    ~ThreadCounters();
+};
+
+//本线程的计数块。两个变量都是平凡初始化、平凡析构的，读取时没有初始化检查；
+//TLS 模型交给编译器决定，库被编进经 dlopen 加载的共享库时也能正常使用
+thread_local CounterBlock *t_counters = nullptr;
+thread_local bool t_countersDetached = false; // 本线程的计数块已析构
+
+ThreadCounters::~ThreadCounters()
+{
+    CounterRegistry::instance().detach(&block);
+    t_counters = nullptr;
+    t_countersDetached = true;
+}
+
+//首次调用时登记本线程的计数块；线程退出阶段计数块已析构，返回 nullptr
+CounterBlock *attachThreadCounters()
+{
+    if (t_countersDetached) return nullptr;
+    thread_local ThreadCounters owner;
+    t_counters = &owner.block;
+    return t_counters;
+}
+
+inline void count(PredicateCounterSlot slot)
+{
+    CounterBlock *block = t_counters;
+    if (!block && !(block = attachThreadCounters())) {
+        CounterRegistry::instance().addRetired(slot);
+        return;
+    }
+    std::atomic<std::uint64_t> &c = block->value[slot];
+    c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+//Shewchuk 各阶段的误差界系数，ε = 2^-53
+constexpr double kEpsilon = std::numeric_limits<double>::epsilon() / 2;
+constexpr double kResultErrBound = (3.0 + 8.0 * kEpsilon) * kEpsilon;
+constexpr double kOrientErrBoundA = (3.0 + 16.0 * kEpsilon) * kEpsilon;
+constexpr double kOrientErrBoundB = (2.0 + 12.0 * kEpsilon) * kEpsilon;
+constexpr double kOrientErrBoundC = (9.0 + 64.0 * kEpsilon) * kEpsilon * kEpsilon;
+constexpr double kInCircleErrBoundA = (10.0 + 96.0 * kEpsilon) * kEpsilon;
+constexpr double kInCircleErrBoundB = (4.0 + 48.0 * kEpsilon) * kEpsilon;
+constexpr double kInCircleErrBoundC = (44.0 + 576.0 * kEpsilon) * kEpsilon * kEpsilon;
+
+//两分量展开式 hi + lo（lo 为舍入误差，可能为 0）
+Expansion<2> twoTerms(double hi, double lo)
+{
+    Expansion<2> r;
+    if (lo != 0) r.v[r.n++] = lo;
+    r.v[r.n++] = hi;
+    return r;
+}
+
+Expansion<2> product(double a, double b)
+{
+    double x, y;
+    twoProduct(a, b, x, y);
+    return twoTerms(x, y);
+}
+
+//坐标差 a - b 的舍入误差（差值本身已按 a - b 算出）
+inline double diffTail(double a, double b)
+{
+    double x, y;
+    twoDiff(a, b, x, y);
+    return y;
+}
+
+//展开式乘以一个 double
+template <int A>
+Expansion<2 * A> operator*(const Expansion<A> &e, double b)
+{
+    Expansion<2 * A> r;
+    r.n = scaleExpansion(e.n, e.v, b, r.v);
+    return r;
+}
+
+/**
+ * @brief orient2d 在浮点滤波失败后的 B、C、D 三个阶段（Shewchuk 的 orient2dadapt）
+ * @details B：坐标差按舍入后的值参与，两次乘积精确展开后相减，误差只来自坐标差的舍入；
+ * C：坐标差的舍入误差都为 0 时 B 已精确，否则补上一阶修正项再与更紧的误差界比较；
+ * D：把各修正项的乘积全部精确展开，得到精确值。
+ */
+double orient2dStages(const Point &a, const Point &b, const Point &c, double detSum)
+{
+    const double acx = a.x - c.x, bcx = b.x - c.x;
+    const double acy = a.y - c.y, bcy = b.y - c.y;
+
+    const Expansion<4> B = product(acx, bcy) - product(acy, bcx);
+    double det = B.estimate();
+    double errBound = kOrientErrBoundB * detSum;
+    if (det >= errBound || -det >= errBound) {
+        count(OrientB);
+        return det;
+    }
+
+    const double acxTail = diffTail(a.x, c.x), bcxTail = diffTail(b.x, c.x);
+    const double acyTail = diffTail(a.y, c.y), bcyTail = diffTail(b.y, c.y);
+    if (acxTail == 0 && acyTail == 0 && bcxTail == 0 && bcyTail == 0) {
+        count(OrientB);
+        return det;
+    }
+
+    errBound = kOrientErrBoundC * detSum + kResultErrBound * std::abs(det);
+    det += (acx * bcyTail + bcy * acxTail) - (acy * bcxTail + bcx * acyTail);
+    if (det >= errBound || -det >= errBound) {
+        count(OrientC);
+        return det;
+    }
+
+    count(OrientExact);
+    const Expansion<8> C1 = B + (product(acxTail, bcy) - product(acyTail, bcx));
+    const Expansion<12> C2 = C1 + (product(acx, bcyTail) - product(acy, bcxTail));
+    const Expansion<16> D = C2 + (product(acxTail, bcyTail) - product(acyTail, bcxTail));
+    return D.v[D.n - 1];
+}
+
+/**
+ * @brief inCircle 在浮点滤波失败后的 B、C、D 三个阶段（Shewchuk 的 incircleadapt）
+ * @details B、C 两阶段与 orient2d 的做法相同；D 阶段直接交给 inCircleExact，
+ * 那里从坐标差的精确展开式出发，不依赖 B、C 的中间结果。
+ */
+double inCircleStages(const Point &a, const Point &b, const Point &c, const Point &d, double permanent)
+{
+    const double adx = a.x - d.x, bdx = b.x - d.x, cdx = c.x - d.x;
+    const double ady = a.y - d.y, bdy = b.y - d.y, cdy = c.y - d.y;
+
+    const Expansion<4> bc = product(bdx, cdy) - product(cdx, bdy);
+    const Expansion<4> ca = product(cdx, ady) - product(adx, cdy);
+    const Expansion<4> ab = product(adx, bdy) - product(bdx, ady);
+    const Expansion<32> adet = (bc * adx) * adx + (bc * ady) * ady;
+    const Expansion<32> bdet = (ca * bdx) * bdx + (ca * bdy) * bdy;
+    const Expansion<32> cdet = (ab * cdx) * cdx + (ab * cdy) * cdy;
+    double det = (adet + bdet + cdet).estimate();
+    double errBound = kInCircleErrBoundB * permanent;
+    if (det >= errBound || -det >= errBound) {
+        count(InCircleB);
+        return det;
+    }
+
+    const double adxTail = diffTail(a.x, d.x), adyTail = diffTail(a.y, d.y);
+    const double bdxTail = diffTail(b.x, d.x), bdyTail = diffTail(b.y, d.y);
+    const double cdxTail = diffTail(c.x, d.x), cdyTail = diffTail(c.y, d.y);
+    if (adxTail == 0 && bdxTail == 0 && cdxTail == 0 && adyTail == 0 && bdyTail == 0 && cdyTail == 0) {
+        count(InCircleB);
+        return det;
+    }
+
+    errBound = kInCircleErrBoundC * permanent + kResultErrBound * std::abs(det);
+    det += ((adx * adx + ady * ady) * ((bdx * cdyTail + cdy * bdxTail) - (bdy * cdxTail + cdx * bdyTail)) +
+            2.0 * (adx * adxTail + ady * adyTail) * (bdx * cdy - bdy * cdx)) +
+           ((bdx * bdx + bdy * bdy) * ((cdx * adyTail + ady * cdxTail) - (cdy * adxTail + adx * cdyTail)) +
+            2.0 * (bdx * bdxTail + bdy * bdyTail) * (cdx * ady - cdy * adx)) +
+           ((cdx * cdx + cdy * cdy) * ((adx * bdyTail + bdy * adxTail) - (ady * bdxTail + bdx * adyTail)) +
+            2.0 * (cdx * cdxTail + cdy * cdyTail) * (adx * bdy - ady * bdx));
+    if (det >= errBound || -det >= errBound) {
+        count(InCircleC);
+        return det;
+    }
+
+    count(InCircleExact);
+    return inCircleExact(a, b, c, d);
+}
+
+} // namespace
+
+/**
+ * @brief 计算三点之间的二维叉积（向量 p1→p2 与 p1→p3 的有向面积）
+ *
+ * 此函数用于判断由三个点构成的旋转方向：
+ * - 返回值 > 0：表示左转（逆时针方向）
+ * - 返回值 < 0：表示右转（顺时针方向）
+ * - 返回值 = 0：表示三点共线
+ *
+ * @param p1 第一个点（参考原点）
+ * @param p2 第二个点（构成向量 p1→p2）
+ * @param p3 第三个点（构成向量 p1→p3）
+ * @return double 类型叉积结果
+ *
+ * @note 此函数常用于凸包、三角剖分、线段相交判断等几何算法中
+ */
+double crossProduct(const Point &p1, const Point &p2, const Point &p3)
+{
+    return (p2.x - p1.x) * (p3.y - p1.y) - (p2.y - p1.y) * (p3.x - p1.x);
+}
+
+/**
+ * @brief 内切圆测试（InCircle），Delaunay 三角剖分的核心谓词
+ *
+ * @details 以 d 为原点平移后计算 3×3 行列式
+ * | ax-dx  ay-dy  (ax-dx)^2+(ay-dy)^2 |
+ * | bx-dx  by-dy  (bx-dx)^2+(by-dy)^2 |
+ * | cx-dx  cy-dy  (cx-dx)^2+(cy-dy)^2 |
+ * 平移能减小参与运算的数量级，降低舍入误差。
+ *
+ * @return double
+ * - > 0：a、b、c 为逆时针时，d 位于三点的外接圆内部（a、b、c 为顺时针时符号相反）
+ * - = 0：四点共圆
+ * - < 0：d 位于外接圆外部
+ */
+double inCircle(const Point &a, const Point &b, const Point &c, const Point &d)
+{
+    const double adx = a.x - d.x, ady = a.y - d.y;
+    const double bdx = b.x - d.x, bdy = b.y - d.y;
+    const double cdx = c.x - d.x, cdy = c.y - d.y;
+    const double alift = adx * adx + ady * ady;
+    const double blift = bdx * bdx + bdy * bdy;
+    const double clift = cdx * cdx + cdy * cdy;
+    return alift * (bdx * cdy - cdx * bdy) + blift * (cdx * ady - adx * cdy) + clift * (adx * bdy - bdx * ady);
+}
+
+/**
+ * @brief 精确的三点定向 (b - a) × (c - a)
+ * @details 坐标差先写成两分量的展开式（坐标相减本身就可能有舍入），两次展开式乘法相减得到至多 16 个分量的精确值。
+ * 只在浮点滤波无法确定符号时调用，快速路径见 Kernel<FilteredExact>::orient2d。
+ * @return 与精确行列式同号的近似值
+ */
+double orient2dExact(const Point &a, const Point &b, const Point &c)
+{
+    const Expansion<2> bax = difference(b.x, a.x), bay = difference(b.y, a.y);
+    const Expansion<2> cax = difference(c.x, a.x), cay = difference(c.y, a.y);
+    return (bax * cay - bay * cax).estimate();
+}
+
+/**
+ * @brief 精确的内切圆测试，行列式与 inCircle 相同（以 d 为原点）
+ * @details 每个提升项与余子式都是 16 分量的展开式，三项乘积之和至多 1536 个分量；
+ * 与 orient2dExact 一样只作为滤波失败后的回退。
+ */
+double inCircleExact(const Point &a, const Point &b, const Point &c, const Point &d)
+{
+    const Expansion<2> adx = difference(a.x, d.x), ady = difference(a.y, d.y);
+    const Expansion<2> bdx = difference(b.x, d.x), bdy = difference(b.y, d.y);
+    const Expansion<2> cdx = difference(c.x, d.x), cdy = difference(c.y, d.y);
+    const Expansion<16> alift = adx * adx + ady * ady;
+    const Expansion<16> blift = bdx * bdx + bdy * bdy;
+    const Expansion<16> clift = cdx * cdx + cdy * cdy;
+    const Expansion<16> bc = bdx * cdy - cdx * bdy;
+    const Expansion<16> ca = cdx * ady - adx * cdy;
+    const Expansion<16> ab = adx * bdy - bdx * ady;
+    return (alift * bc + blift * ca + clift * ab).estimate();
+}
+
+/**
+ * @brief 自适应精度的三点定向（Shewchuk 的 orient2d）
+ * @details 先用浮点算出行列式的两项，差的绝对值不小于 A 阶段的误差界时直接返回。两项异号或有一项为 0 时
+ * 不会发生相消，这个比较必然成立，因此不必像原实现那样先按符号分支（随机输入下那些分支难以预测）。
+ * 只有三点接近共线时才进入 orient2dStages 逐级提高精度，
+ * 代价与输入离退化的远近相称，不依赖坐标的尺度。
+ * @return 与精确行列式同号的近似值，符号约定同 crossProduct
+ */
+double orient2dAdaptive(const Point &a, const Point &b, const Point &c)
+{
+    const double detLeft = (a.x - c.x) * (b.y - c.y);
+    const double detRight = (a.y - c.y) * (b.x - c.x);
+    const double det = detLeft - detRight;
+    const double detSum = std::abs(detLeft) + std::abs(detRight);
+    if (std::abs(det) >= kOrientErrBoundA * detSum) {
+        count(OrientA);
+        return det;
+    }
+    return orient2dStages(a, b, c, detSum);
+}
+
+/**
+ * @brief 自适应精度的内切圆测试（Shewchuk 的 incircle）
+ * @details A 阶段与 inCircle 的算式相同，另外按各项绝对值算出 permanent 作为误差界的基数；
+ * 四点接近共圆时才进入 inCircleStages。
+ * @return 符号约定同 inCircle，且总是正确
+ */
+double inCircleAdaptive(const Point &a, const Point &b, const Point &c, const Point &d)
+{
+    const double adx = a.x - d.x, ady = a.y - d.y;
+    const double bdx = b.x - d.x, bdy = b.y - d.y;
+    const double cdx = c.x - d.x, cdy = c.y - d.y;
+    const double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    const double cdxady = cdx * ady, adxcdy = adx * cdy;
+    const double adxbdy = adx * bdy, bdxady = bdx * ady;
+    const double alift = adx * adx + ady * ady;
+    const double blift = bdx * bdx + bdy * bdy;
+    const double clift = cdx * cdx + cdy * cdy;
+    const double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+    const double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * alift +
+                             (std::abs(cdxady) + std::abs(adxcdy)) * blift +
+                             (std::abs(adxbdy) + std::abs(bdxady)) * clift;
+    const double errBound = kInCircleErrBoundA * permanent;
+    if (det > errBound || -det > errBound) {
+        count(InCircleA);
+        return det;
+    }
+    return inCircleStages(a, b, c, d, permanent);
+}
+
+PredicateStats predicateStats()
+{
+    const std::array<std::uint64_t, SlotCount> v = CounterRegistry::instance().read();
+    PredicateStats stats;
+    stats.orient2d = {v[OrientA], v[OrientB], v[OrientC], v[OrientExact]};
+    stats.inCircle = {v[InCircleA], v[InCircleB], v[InCircleC], v[InCircleExact]};
+    return stats;
+}
+
+void resetPredicateStats()
+{
+    CounterRegistry::instance().reset();
+}
+
+/**
+ * @brief 判断一个点是否精确地位于一条线段之上
+ *
+ * @details 此函数采用两步检查法：
+ * 1. **包围盒检查**：快速判断点的坐标是否在线段两个端点构成的矩形范围内。
+ * 2. **共线性检查**：用自适应精度的 orient2dAdaptive 判断三点是否精确共线，不使用与坐标尺度有关的容差。
+ * 只有同时满足这两个条件，点才算在线段上。
+ *
+ * @param a 线段的起点
+ * @param b 线段的终点
+ * @param c 要测试的点
+ * @return bool 如果点 c 在线段 ab 上，返回 true；否则返回 false
+ */
+bool onSegment(const Point &a, const Point &b, const Point &c)
+{
+    // 检查c是否在ab的包围盒内
+    if (c.x < std::min(a.x, b.x) || c.x > std::max(a.x, b.x) ||
+        c.y < std::min(a.y, b.y) || c.y > std::max(a.y, b.y)) {
+        return false;
+    }
+    // 检查三点是否共线
+    return orient2dAdaptive(a, b, c) == 0;
+}
+
+/**
+ * @brief 判断两条线段 p1p2 和 q1q2 是否相交（包括端点落在另一条线段内部的情况）
+ *
+ * @details 这是一个标准的线段相交检测算法，分为两部分：
+ * 1. **跨立实验**：通过四次叉积判断，检查两条线段的端点是否分别位于对方所在直线的两侧。
+ * 这能处理绝大多数“X”型的交叉情况。
+ * 2. **共线检查**：处理特殊情况，即当某条线段的一个端点恰好落在另一条线段内部时，
+ * 也判定为相交。叉积精确为 0 时只需再用包围盒确认端点在线段范围内。仅在端点处接触不算相交。
+ * 实现见 Kernel.h 中的 segmentsTouchInterior，按坐标类型实例化的算法直接调用它。
+ *
+ * @param p1 线段1的起点
+ * @param p2 线段1的终点
+ * @param q1 线段2的起点
+ * @param q2 线段2的终点
+ * @return bool 如果两条线段有内部交叉，返回 true；否则返回 false
+ */
+bool segmentsIntersect(const Point &p1, const Point &p2, const Point &q1, const Point &q2)
+{
+    // 四次定向由 FilteredExact 内核精确给出：整数坐标与小数坐标走同一条路径，叉积为 0 就是真正的共线
+    return segmentsTouchInterior<Kernel<FilteredExact>>(p1, p2, q1, q2);
+}
+
+/**
+ * @brief 判断多边形中两条不相邻的边是否相交
+ * @details 在 segmentsIntersect 的基础上，把两条完全重合的边也算作相交：
+ * 它们的端点两两重合，segmentsIntersect 只看到端点接触而不报告。
+ * @return bool 两条边有内部交叉、端点落在对方内部或完全重合时返回 true
+ */
+bool edgesIntersect(const Point &p1, const Point &p2, const Point &q1, const Point &q2)
+{
+    if ((p1 == q1 && p2 == q2) || (p1 == q2 && p2 == q1)) return true;
+    return segmentsIntersect(p1, p2, q1, q2);
+}
+
+/**
+ * @brief 判断相邻的两条边 p→v、v→q 是否在公共顶点 v 处沿原直线折返
+ * @details 三点共线且 p、q 在 v 的同一侧时，两条边有一段重合（“尖刺”），多边形不再是简单的。
+ * 共线性与 segmentsIntersect 一样用 orient2dAdaptive 精确判定，朴素叉积的舍入会把近乎共线的折返漏掉或误报。
+ */
+bool edgesFoldBack(const Point &p, const Point &v, const Point &q)
+{
+    return orient2dAdaptive(v, p, q) == 0 && (p.x - v.x) * (q.x - v.x) + (p.y - v.y) * (q.y - v.y) > 0;
+}
+
+/**
+ * @brief 已知线段 p1p2 与 p3p4 在内部严格交叉时求交点
+ * @details 用克莱姆法则解 P₁ + t(P₂-P₁) = P₃ + u(P₄-P₃)。是否交叉已由精确谓词确定，这里只做构造：
+ * t 限制在 [0, 1] 内，舍入不会把交点推出线段；两线段几乎平行时行列式可能舍入为 0，此时取 t = 0。
+ */
+Point crossingPoint(const Point &p1, const Point &p2, const Point &p3, const Point &p4, double &out_alpha)
+{
+    const double det = (p2.x - p1.x) * (p4.y - p3.y) - (p2.y - p1.y) * (p4.x - p3.x);
+    double t = ((p3.x - p1.x) * (p4.y - p3.y) - (p3.y - p1.y) * (p4.x - p3.x)) / det;
+    if (!(t > 0)) t = 0;
+    else if (t > 1) t = 1;
+    out_alpha = t;
+    return {p1.x + t * (p2.x - p1.x), p1.y + t * (p2.y - p1.y)};
+}
+
+/**
+ * @brief 计算两条线段 p1p2 和 p3p4 的交点
+ * @details 先用四次自适应精度的定向判断两条线段是否在内部严格交叉（每条线段的两个端点严格分居另一条线段两侧），
+ * 平行、共线、端点接触都不算；判定不依赖坐标尺度，也没有容差。确认交叉后再由 crossingPoint 求出交点。
+ *
+ * @param out_alpha [out] 如果相交，此参数将存储交点在线段 p1p2 上的比例位置 (t值)
+ * @return std::optional<Point> 如果线段严格相交，则返回交点；否则返回 std::nullopt。
+ */
+std::optional<Point> getLineSegmentIntersection(const Point &p1, const Point &p2,
+                                                const Point &p3, const Point &p4, double &out_alpha)
+{
+    if (!segmentsCrossProperly<Kernel<FilteredExact>>(p1, p2, p3, p4)) return std::nullopt;
+    return crossingPoint(p1, p2, p3, p4, out_alpha);
+}
+
+/**
+ * @brief 判断一个点是否在三角形内部或边界上
+ *
+ * @details 点在三条有向边的同一侧（或恰在边上）即在三角形内，与顶点顺序无关。
+ * 三次定向都用自适应精度的 orient2dAdaptive，边界上的点总能被准确识别，不需要与坐标尺度有关的容差。
+ * 三角形退化为线段时，点落在任一条边上才算在内。
+ */
+bool Triangle::contains(const Point &pt) const
+{
+    if (orient2dAdaptive(p1, p2, p3) == 0) return onSegment(p1, p2, pt) || onSegment(p2, p3, pt) || onSegment(p3, p1, pt);
+    const double o1 = orient2dAdaptive(p1, p2, pt);
+    const double o2 = orient2dAdaptive(p2, p3, pt);
+    const double o3 = orient2dAdaptive(p3, p1, pt);
+    return (o1 >= 0 && o2 >= 0 && o3 >= 0) || (o1 <= 0 && o2 <= 0 && o3 <= 0);
+}
+
+} // namespace Geometry
@@ -0,0 +1,67 @@
+#ifndef PREDICATES_H
+#define PREDICATES_H
+/*Predicates 收录各算法共用的基础几何谓词：叉积、内切圆测试、点在线段上、线段相交、求交点*/
+#include "GeometryTypes.h"
+#include <cstdint>
+#include <optional>
+
+namespace Geometry {
+
+// 三点叉积（向量 p1→p2 与 p1→p3 的有向面积）
+double crossProduct(const Point &p1, const Point &p2, const Point &p3);
+
+// 内切圆测试：a、b、c 逆时针时，d 在三点外接圆内返回正数，圆上为 0，圆外为负数
+double inCircle(const Point &a, const Point &b, const Point &c, const Point &d);
+
+// 精确的三点定向：符号总是正确（用无误差的浮点展开式求值，慢），返回值为行列式的近似值
+double orient2dExact(const Point &a, const Point &b, const Point &c);
+
+// 精确的内切圆测试：符号约定同 inCircle，且总是正确
+double inCircleExact(const Point &a, const Point &b, const Point &c, const Point &d);
+
+// 自适应精度的三点定向（Shewchuk）：与 crossProduct 同号且符号总是正确；绝大多数调用只做一次浮点求值
+double orient2dAdaptive(const Point &a, const Point &b, const Point &c);
+
+// 自适应精度的内切圆测试：符号约定同 inCircle，且总是正确；只在四点接近共圆时才提高精度
+double inCircleAdaptive(const Point &a, const Point &b, const Point &c, const Point &d);
+
+//自适应谓词在各阶段返回的次数：stageA 为浮点滤波直接确定符号，exact 为退到完全精确的展开式
+struct PredicateCounters {
+    std::uint64_t stageA = 0;
+    std::uint64_t stageB = 0;
+    std::uint64_t stageC = 0;
+    std::uint64_t exact = 0;
+    std::uint64_t total() const { return stageA + stageB + stageC + exact; }
+};
+
+struct PredicateStats {
+    PredicateCounters orient2d;
+    PredicateCounters inCircle;
+};
+
+// 所有线程（含已退出的线程）自上次 resetPredicateStats 以来的累计次数
+PredicateStats predicateStats();
+void resetPredicateStats();
+
+// 判断点 c 是否精确地位于线段 ab 上
+bool onSegment(const Point &a, const Point &b, const Point &c);
+
+// 判断线段 p1p2 与 q1q2 是否在内部严格相交（端点接触不算）
+bool segmentsIntersect(const Point &p1, const Point &p2, const Point &q1, const Point &q2);
+
+// 多边形中不相邻的两条边 p1p2、q1q2 是否相交：segmentsIntersect，或两条边完全重合
+bool edgesIntersect(const Point &p1, const Point &p2, const Point &q1, const Point &q2);
+
+// 相邻的两条边 p→v、v→q 是否沿同一直线折返（在 v 处重叠）
+bool edgesFoldBack(const Point &p, const Point &v, const Point &q);
+
+// 计算线段 p1p2 与 p3p4 的严格内部交点，out_alpha 返回交点在 p1p2 上的比例
+std::optional<Point> getLineSegmentIntersection(const Point &p1, const Point &p2,
+                                                const Point &p3, const Point &p4, double &out_alpha);
+
+// 已知 p1p2 与 p3p4 在内部严格交叉时求交点（只做构造，不做判定），out_alpha 返回交点在 p1p2 上的比例
+Point crossingPoint(const Point &p1, const Point &p2, const Point &p3, const Point &p4, double &out_alpha);
+
+} // namespace Geometry
+
+#endif // PREDICATES_H
@@ -0,0 +1,238 @@
+#include "SegmentIntersection.h"
+#include "Kernel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <set>
+
+namespace Geometry {
+
+namespace {
+
+inline bool lexLess(const Point &a, const Point &b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+//参与扫描的线段：保留原方向（用于求交参数），另存按字典序排好的左右端点
+struct Segment {
+    Point from, to;     // 原多边形中的方向
+    Point left, right;  // left 字典序较小
+    std::size_t edge;   // 在所属多边形中的边号
+    bool inA;           // 属于 A 还是 B
+};
+
+enum class EventType { Right, Cross, Left }; // 同一位置上先删除、再交换、后插入
+
+struct Event {
+    Point pos;
+    EventType type;
+    int a, b; // Left/Right 只用 a；Cross 为交换的两条线段
+
+    //std::priority_queue 是大顶堆，这里反向比较得到按字典序的小顶堆
+    bool operator<(const Event &o) const
+    {
+        if (pos != o.pos) return lexLess(o.pos, pos);
+        return static_cast<int>(type) > static_cast<int>(o.type);
+    }
+};
+
+/**
+ * @brief 扫描线状态的比较器：按线段在当前扫描位置上的 y 值排序
+ * @details 扫描线可以看作略微倾斜的竖线，于是竖直线段在扫描位置 (x, y) 上的取值
+ * 就是被限制在其端点范围内的 y。y 相等时（两线段在此处相交或共享端点）
+ * 按斜率排序，即它们在扫描线右侧的上下关系。
+ */
+struct StatusCompare {
+    const CountedVector<Segment> *segments;
+    const Point *sweep;
+
+    double yAt(const Segment &s) const
+    {
+        if (s.left.x == s.right.x) return std::max(s.left.y, std::min(sweep->y, s.right.y));
+        if (sweep->x <= s.left.x) return s.left.y;
+        if (sweep->x >= s.right.x) return s.right.y;
+        const double t = (sweep->x - s.left.x) / (s.right.x - s.left.x);
+        return s.left.y + t * (s.right.y - s.left.y);
+    }
+
+    static double slope(const Segment &s)
+    {
+        if (s.left.x == s.right.x) return std::numeric_limits<double>::infinity();
+        return (s.right.y - s.left.y) / (s.right.x - s.left.x);
+    }
+
+    bool operator()(int i, int j) const
+    {
+        const Segment &a = (*segments)[i];
+        const Segment &b = (*segments)[j];
+        const double ya = yAt(a), yb = yAt(b);
+        if (ya != yb) return ya < yb;
+        const double sa = slope(a), sb = slope(b);
+        if (sa != sb) return sa < sb;
+        return i < j;
+    }
+};
+
+//状态树中的结点只保存线段号；交点处两条相邻线段直接交换编号，不经过比较器，避免浮点误差破坏顺序
+struct Slot {
+    mutable int segment;
+};
+
+struct SlotCompare {
+    StatusCompare cmp;
+    bool operator()(const Slot &a, const Slot &b) const { return cmp(a.segment, b.segment); }
+};
+
+//扫描线主体，按几何内核 K 实例化；内核只决定“两条边是否交叉”，交点坐标与状态排序仍用 double
+template <typename K>
+class Sweep
+{
+public:
+    Sweep(CountedVector<Segment> segments, AllocationCounter &counter)
+        : m_segments(std::move(segments)),
+          m_status(SlotCompare{StatusCompare{&m_segments, &m_position}}, CountingAllocator<Slot>(&counter)),
+          m_handles(m_segments.size(), m_status.end(), CountingAllocator<Handle>(&counter)),
+          m_events(std::less<Event>(), CountedVector<Event>(CountingAllocator<Event>(&counter))),
+          m_scheduled(CountingAllocator<EdgePair>(&counter)),
+          m_found(CountingAllocator<EdgeIntersection>(&counter))
+    {
+    }
+
+    CountedVector<EdgeIntersection> run()
+    {
+        for (int i = 0; i < static_cast<int>(m_segments.size()); ++i) {
+            m_events.push({m_segments[i].left, EventType::Left, i, -1});
+            m_events.push({m_segments[i].right, EventType::Right, i, -1});
+        }
+
+        while (!m_events.empty()) {
+            const Event e = m_events.top();
+            m_events.pop();
+            m_position = e.pos;
+            switch (e.type) {
+            case EventType::Left: handleLeft(e.a); break;
+            case EventType::Right: handleRight(e.a); break;
+            case EventType::Cross: handleCross(e.a, e.b); break;
+            }
+        }
+        return std::move(m_found);
+    }
+
+private:
+    using Status = std::set<Slot, SlotCompare, CountingAllocator<Slot>>;
+    using Handle = Status::iterator;
+    using EdgePair = std::pair<std::size_t, std::size_t>;
+
+    void handleLeft(int s)
+    {
+        const Handle h = m_status.insert(Slot{s}).first;
+        m_handles[s] = h;
+        if (h != m_status.begin()) check(std::prev(h)->segment, s);
+        if (std::next(h) != m_status.end()) check(s, std::next(h)->segment);
+    }
+
+    void handleRight(int s)
+    {
+        const Handle h = m_handles[s];
+        if (h == m_status.end()) return;
+        const Handle next = std::next(h);
+        if (h != m_status.begin() && next != m_status.end()) check(std::prev(h)->segment, next->segment);
+        m_status.erase(h);
+        m_handles[s] = m_status.end();
+    }
+
+    //交点事件：a 在交点左侧位于 b 之下，越过交点后二者互换
+    void handleCross(int a, int b)
+    {
+        Handle ha = m_handles[a];
+        Handle hb = m_handles[b];
+        if (ha == m_status.end() || hb == m_status.end() || std::next(ha) != hb) return;
+
+        std::swap(ha->segment, hb->segment);
+        m_handles[a] = hb;
+        m_handles[b] = ha;
+        // 现在 b 在下、a 在上
+        if (ha != m_status.begin()) check(std::prev(ha)->segment, b);
+        if (std::next(hb) != m_status.end()) check(a, std::next(hb)->segment);
+    }
+
+    //检查状态中相邻（lower 在 upper 之下）的两条线段；只关心 A 与 B 之间的交点
+    void check(int lower, int upper)
+    {
+        const Segment &s = m_segments[lower];
+        const Segment &t = m_segments[upper];
+        if (s.inA == t.inA) return;
+        const Segment &a = s.inA ? s : t;
+        const Segment &b = s.inA ? t : s;
+
+        if (!m_scheduled.insert({a.edge, b.edge}).second) return;
+        if (!segmentsCrossProperly<K>(K::convert(a.from), K::convert(a.to), K::convert(b.from), K::convert(b.to))) return;
+        double alphaA = 0.0;
+        const Point hit = crossingPoint(a.from, a.to, b.from, b.to, alphaA);
+
+        const Point d = b.to - b.from;
+        const double alphaB = ((hit.x - b.from.x) * d.x + (hit.y - b.from.y) * d.y) / (d.x * d.x + d.y * d.y);
+        m_found.push_back({a.edge, b.edge, hit, alphaA, alphaB});
+
+        // 交点在扫描线左侧（浮点误差）时仍在当前位置交换，保证顺序随后得到纠正
+        const Point pos = lexLess(hit, m_position) ? m_position : hit;
+        m_events.push({pos, EventType::Cross, lower, upper});
+    }
+
+    CountedVector<Segment> m_segments;
+    Point m_position;
+    Status m_status;
+    CountedVector<Handle> m_handles;
+    std::priority_queue<Event, CountedVector<Event>> m_events;
+    std::set<EdgePair, std::less<EdgePair>, CountingAllocator<EdgePair>> m_scheduled; // 已检查过的 (A 边, B 边)
+    CountedVector<EdgeIntersection> m_found;
+};
+
+void appendEdges(PointSpan polygon, bool inA, CountedVector<Segment> &out)
+{
+    const std::size_t n = polygon.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        const Point &p = polygon[i];
+        const Point &q = polygon[(i + 1) % n];
+        if (p == q) continue; // 零长度边不参与求交
+        const bool forward = lexLess(p, q);
+        out.push_back({p, q, forward ? p : q, forward ? q : p, i, inA});
+    }
+}
+
+} // namespace
+
+/**
+ * @brief 用 Bentley–Ottmann 扫描线求两个多边形边界之间的全部交点
+ * @details 把两个多边形的边放进同一条扫描线中：事件队列按字典序处理线段的左端点（插入）、
+ * 右端点（删除）与已发现的交点（交换上下顺序）；扫描线状态是一棵按当前 y 值排序的平衡树。
+ * 只有在状态中相邻过的线段才会被求交，且由于两个多边形各自都是简单多边形，
+ * 只需检查一条 A 边与一条 B 边相邻的情形。是否交叉由按两个多边形的坐标选定的几何内核精确判定
+ * （与 getLineSegmentIntersection 同样只报告内部的真正交叉，但没有容差），内核在入口处选定一次。
+ * @param polygonA 多边形 A（简单多边形）
+ * @param polygonB 多边形 B（简单多边形）
+ * @param counter 记录扫描线内部容器的分配次数与内存峰值
+ * @return 所有交点，未排序
+ * @complexity O((n + m + k) log(n + m))
+ */
+CountedVector<EdgeIntersection> findEdgeIntersections(PointSpan polygonA, PointSpan polygonB,
+                                                      AllocationCounter &counter)
+{
+    CountedVector<Segment> segments{CountingAllocator<Segment>(&counter)};
+    segments.reserve(polygonA.size() + polygonB.size());
+    appendEdges(polygonA, true, segments);
+    appendEdges(polygonB, false, segments);
+    return withKernel(chooseKernel({polygonA, polygonB}),
+                      [&](auto k) { return Sweep<decltype(k)>(std::move(segments), counter).run(); });
+}
+
+std::vector<EdgeIntersection> findEdgeIntersections(PointSpan polygonA, PointSpan polygonB)
+{
+    AllocationCounter counter;
+    const CountedVector<EdgeIntersection> found = findEdgeIntersections(polygonA, polygonB, counter);
+    return std::vector<EdgeIntersection>(found.begin(), found.end());
+}
+
+} // namespace Geometry
@@ -0,0 +1,28 @@
+#ifndef SEGMENTINTERSECTION_H
+#define SEGMENTINTERSECTION_H
+/*SegmentIntersection 用扫描线（Bentley–Ottmann）找出两个多边形边界之间的全部交点*/
+#include "AllocationCounter.h"
+#include "GeometryTypes.h"
+
+namespace Geometry {
+
+//多边形 A 的一条边与多边形 B 的一条边的交点
+struct EdgeIntersection {
+    std::size_t edgeA = 0; // A 中的边 A[edgeA] → A[edgeA+1]
+    std::size_t edgeB = 0; // B 中的边 B[edgeB] → B[edgeB+1]
+    Point point;           // 交点坐标
+    double alphaA = 0.0;   // 交点在 A 边上的参数位置 (0, 1)
+    double alphaB = 0.0;   // 交点在 B 边上的参数位置 (0, 1)
+};
+
+// 求 A、B 两个简单多边形边界之间的所有交点（只报告两条边内部的真正交叉，由几何内核精确判定）
+// 复杂度 O((n + m + k) log(n + m))，k 为交点数
+std::vector<EdgeIntersection> findEdgeIntersections(PointSpan polygonA, PointSpan polygonB);
+
+// 同上，扫描过程中所有容器（含返回值）的分配都记入 counter
+CountedVector<EdgeIntersection> findEdgeIntersections(PointSpan polygonA, PointSpan polygonB,
+                                                      AllocationCounter &counter);
+
+} // namespace Geometry
+
+#endif // SEGMENTINTERSECTION_H
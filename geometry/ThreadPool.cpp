@@ -0,0 +1,105 @@
+#include "ThreadPool.h"
+
+namespace Geometry {
+
+namespace {
+thread_local bool t_insidePool = false; // 当前线程是否正在执行线程池任务
+}
+
+/**
+ * @brief 创建线程池
+ * @param threadCount 参与执行的线程总数，0 表示硬件并发数；会额外创建 threadCount - 1 个工作线程
+ */
+ThreadPool::ThreadPool(unsigned threadCount)
+{
+    const unsigned total = resolveThreadCount(threadCount);
+    m_workers.reserve(total - 1);
+    for (unsigned i = 1; i < total; ++i) {
+        m_workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (std::thread &t : m_workers) t.join();
+}
+
+ThreadPool &ThreadPool::global()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+unsigned ThreadPool::resolveThreadCount(unsigned requested)
+{
+    if (requested > 0) return requested;
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw > 0 ? hw : 1;
+}
+
+/**
+ * @brief 分发任务并等待全部完成
+ * @details 任务下标通过原子计数器动态领取，调用线程与工作线程一起执行，
+ * 因此任务数多于线程数时可以自动负载均衡。任务内部再次调用 parallelFor（嵌套并行）
+ * 或线程池只有一个执行者时，直接在当前线程串行执行，避免死锁。
+ */
+void ThreadPool::parallelFor(std::size_t taskCount, const std::function<void(std::size_t)> &task)
+{
+    if (taskCount == 0) return;
+    if (t_insidePool || m_workers.empty() || taskCount == 1) {
+        for (std::size_t i = 0; i < taskCount; ++i) task(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit(m_submitMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_taskCount = taskCount;
+        m_next.store(0);
+        m_pending = m_workers.size();
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    t_insidePool = true;
+    runTasks();
+    t_insidePool = false;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this]() { return m_pending == 0; });
+    m_task = nullptr;
+}
+
+void ThreadPool::runTasks()
+{
+    for (std::size_t i = m_next.fetch_add(1); i < m_taskCount; i = m_next.fetch_add(1)) {
+        (*m_task)(i);
+    }
+}
+
+void ThreadPool::workerLoop()
+{
+    t_insidePool = true;
+    unsigned long long seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&]() { return m_stop || m_generation != seen; });
+            if (m_stop) return;
+            seen = m_generation;
+        }
+        runTasks();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_pending == 0) m_done.notify_one();
+        }
+    }
+}
+
+} // namespace Geometry
@@ -0,0 +1,55 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+/*ThreadPool 是几何库内部使用的固定大小线程池，只提供“把 N 个任务分发下去并等待完成”这一种用法*/
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Geometry {
+
+class ThreadPool
+{
+public:
+    // threadCount 为 0 时使用硬件并发数；调用 parallelFor 的线程本身也算作一个执行者
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // 参与执行任务的线程总数（工作线程数 + 调用线程）
+    unsigned size() const { return static_cast<unsigned>(m_workers.size()) + 1; }
+
+    // 执行 task(0) ... task(taskCount-1) 并阻塞到全部完成；在任务内部嵌套调用时退化为串行执行
+    void parallelFor(std::size_t taskCount, const std::function<void(std::size_t)> &task);
+
+    // 进程级共享线程池，大小为硬件并发数
+    static ThreadPool &global();
+
+    // 解析用户给出的线程数：0 表示硬件并发数，结果至少为 1
+    static unsigned resolveThreadCount(unsigned requested);
+
+private:
+    void workerLoop();
+    void runTasks();
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_submitMutex; // 同一时刻只允许一个 parallelFor 在进行
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const std::function<void(std::size_t)> *m_task = nullptr;
+    std::size_t m_taskCount = 0;
+    std::atomic<std::size_t> m_next{0};
+    std::size_t m_pending = 0;     // 尚未完成任务的工作线程数
+    unsigned long long m_generation = 0;
+    bool m_stop = false;
+};
+
+} // namespace Geometry
+
+#endif // THREADPOOL_H
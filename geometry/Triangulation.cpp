@@ -0,0 +1,890 @@
+#include "Triangulation.h"
+#include "ConstrainedDelaunay.h"
+#include "Kernel.h"
+#include "PolygonUtils.h"
+#include "Predicates.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <set>
+
+namespace Geometry {
+
+namespace {
+
+//扫描线自上而下推进：y 大者在上，y 相同时 x 小者在上（相当于把扫描线微微倾斜，消除水平边的歧义）
+inline bool isAbove(const Point &p, const Point &q)
+{
+    return p.y > q.y || (p.y == q.y && p.x < q.x);
+}
+
+/**
+ * @brief 多边形的一组环：顶点连续存放，next / prev 给出环上的后继与前驱
+ * @details 外边界逆时针、孔洞顺时针，于是区域内部总在每条有向边的左侧，扫描线与追踪子多边形时不必区分环。
+ */
+struct RingSet {
+    std::vector<Point> pts;
+    std::vector<int> next, prev;
+    std::vector<int> top; // 每个环中最先被扫描到的顶点，top[0] 属于外边界
+};
+
+//把一个环追加到 rings：去掉相邻重复点与首尾重复点，并调整为指定的环绕方向；有效顶点不足 3 个时不追加并返回 false
+bool appendRing(RingSet &rings, PointSpan ring, bool counterClockwise)
+{
+    const std::size_t first = rings.pts.size();
+    for (const Point &p : ring) {
+        if (rings.pts.size() == first || rings.pts.back() != p) rings.pts.push_back(p);
+    }
+    while (rings.pts.size() > first + 1 && rings.pts.back() == rings.pts[first]) rings.pts.pop_back();
+    const std::size_t k = rings.pts.size() - first;
+    if (k < 3) {
+        rings.pts.resize(first);
+        return false;
+    }
+    if ((computeAreaSign(PointSpan(rings.pts.data() + first, k)) > 0) != counterClockwise) {
+        std::reverse(rings.pts.begin() + first, rings.pts.end());
+    }
+    const int begin = static_cast<int>(first), end = static_cast<int>(rings.pts.size());
+    int top = begin;
+    for (int v = begin; v < end; ++v) {
+        rings.next.push_back(v + 1 < end ? v + 1 : begin);
+        rings.prev.push_back(v > begin ? v - 1 : end - 1);
+        if (isAbove(rings.pts[v], rings.pts[top])) top = v;
+    }
+    rings.top.push_back(top);
+    return true;
+}
+
+
+//把坐标量化到 16 位网格后交错各位，得到 32 位 Morton（z-order）编码；包围盒内的点编码必落在两角编码之间
+std::uint32_t mortonCode(const Point &p, const Point &origin, double scale)
+{
+    auto spread = [](std::uint32_t v) {
+        v &= 0xFFFF;
+        v = (v | (v << 8)) & 0x00FF00FF;
+        v = (v | (v << 4)) & 0x0F0F0F0F;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    };
+    const auto qx = static_cast<std::uint32_t>((p.x - origin.x) * scale);
+    const auto qy = static_cast<std::uint32_t>((p.y - origin.y) * scale);
+    return spread(qx) | (spread(qy) << 1);
+}
+
+const std::uint32_t kMortonX = 0x55555555; // x 分量所在的位（偶数位）
+const std::uint32_t kMortonY = 0xAAAAAAAA; // y 分量所在的位（奇数位）
+
+//编码 z 对应的网格点是否落在 [zLo, zHi] 两角围成的矩形内：按位掩码后各分量可以直接当整数比较
+inline bool mortonInBox(std::uint32_t z, std::uint32_t zLo, std::uint32_t zHi)
+{
+    return (z & kMortonX) >= (zLo & kMortonX) && (z & kMortonX) <= (zHi & kMortonX) &&
+           (z & kMortonY) >= (zLo & kMortonY) && (z & kMortonY) <= (zHi & kMortonY);
+}
+
+/**
+ * @brief BIGMIN（Tropf–Herzog）：求大于 z 且落在矩形 [zLo, zHi] 内的最小 Morton 编码
+ * @details 编码区间 [zLo, zHi] 中可能夹着大段矩形外的编码，扫描遇到矩形外的编码时用它直接跳到下一个矩形内的编码。
+ * 从最高位开始比较 z、zLo、zHi 的同一位，按三者的取值收缩矩形或确定答案。
+ * @complexity O(32)
+ */
+std::uint32_t mortonBigMin(std::uint32_t z, std::uint32_t zLo, std::uint32_t zHi)
+{
+    std::uint32_t bigMin = zHi;
+    for (int bit = 31; bit >= 0; --bit) {
+        const std::uint32_t high = 1u << bit;
+        const std::uint32_t lower = ((bit & 1) ? kMortonY : kMortonX) & (high - 1); //同一分量的更低位
+        const unsigned key = ((z >> bit) & 1) << 2 | ((zLo >> bit) & 1) << 1 | ((zHi >> bit) & 1);
+        switch (key) {
+        case 0b001: //z 落在矩形的低半部分：高半部分的最小值是候选，继续在低半部分中找
+            bigMin = (zLo & ~lower) | high;
+            zHi = (zHi & ~high) | lower;
+            break;
+        case 0b011: //矩形整体在 z 之上
+            return zLo;
+        case 0b100: //矩形整体在 z 之下，答案是之前记录的候选
+            return bigMin;
+        case 0b101: //z 落在矩形的高半部分，只需在高半部分中找
+            zLo = (zLo & ~lower) | high;
+            break;
+        default:
+            break;
+        }
+    }
+    return bigMin;
+}
+
+//切耳的结果：Stuck 为一整圈都找不到耳朵，OverBudget 为查找反射顶点的总步数超出预算
+enum class EarClipStatus { Done, Stuck, OverBudget };
+
+/**
+ * @brief 耳切法的核心：对一个逆时针环切耳，输出顶点下标
+ * @details 按几何内核 K 实例化：凸性与“点在三角形内”的定向判断都在内核坐标上进行，Morton 编码仍用 double。
+ * 查找反射顶点的总步数以 8 n log n 为上限：梳齿、深凹的星形等输入最后会切出细长的扇形三角形，
+ * 包围盒罩住几乎所有剩余的反射顶点，且都紧贴在三角形外侧，任何按区域剪枝的查找都要逐个排除，总量为 O(n^2)。
+ * @param vertices 顶点缓冲
+ * @param ring 环上依次经过的顶点下标；桥接孔洞后桥的端点会出现两次
+ * @param out [out] 每个三角形追加三个顶点下标（逆时针）；返回 OverBudget 时已追加的部分由调用方丢弃
+ */
+template <typename K>
+EarClipStatus earClipRingWith(const std::vector<Point> &vertices, const std::vector<int> &ring, std::vector<std::uint32_t> &out)
+{
+    using KPoint = typename K::Point;
+
+    //坐标按环的顺序转换为内核坐标，链表与反射顶点索引都用环上的位置编号
+    const std::size_t n = ring.size();
+    if (n < 3) return EarClipStatus::Stuck;
+    std::vector<KPoint> pts(n);
+    for (std::size_t i = 0; i < n; ++i) pts[i] = K::convert(vertices[ring[i]]);
+
+    //剩余顶点的双向链表
+    std::vector<int> prev(n), next(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        prev[i] = static_cast<int>((i + n - 1) % n);
+        next[i] = static_cast<int>((i + 1) % n);
+    }
+    auto isConvex = [&](int v) { return K::orient2d(pts[prev[v]], pts[v], pts[next[v]]) > 0; };
+
+    //非凸顶点按 Morton 编码排序；alive 用并查集指向下一个仍为非凸的位置（末尾哨兵始终存活）
+    Point lo = toPoint(pts[0]), hi = lo;
+    for (const KPoint &kp : pts) {
+        const Point p = toPoint(kp);
+        lo = {std::min(lo.x, p.x), std::min(lo.y, p.y)};
+        hi = {std::max(hi.x, p.x), std::max(hi.y, p.y)};
+    }
+    const double extent = std::max(hi.x - lo.x, hi.y - lo.y);
+    const double scale = extent > 0 ? 65535.0 / extent : 0.0;
+    //坐标随编码一起存放，扫描编码区间时顺序访问内存
+    struct ReflexEntry {
+        std::uint32_t z;
+        int vertex;
+        KPoint p;
+    };
+    std::vector<ReflexEntry> reflex;
+    for (std::size_t i = 0; i < n; ++i) {
+        const int v = static_cast<int>(i);
+        if (!isConvex(v)) reflex.push_back({mortonCode(toPoint(pts[v]), lo, scale), v, pts[v]});
+    }
+    std::sort(reflex.begin(), reflex.end(), [](const ReflexEntry &a, const ReflexEntry &b) { return a.z < b.z; });
+    std::vector<int> reflexSlot(n, -1);
+    for (std::size_t k = 0; k < reflex.size(); ++k) reflexSlot[reflex[k].vertex] = static_cast<int>(k);
+    std::vector<int> alive(reflex.size() + 1);
+    for (std::size_t k = 0; k < alive.size(); ++k) alive[k] = static_cast<int>(k);
+    auto nextAlive = [&](int k) {
+        int root = k;
+        while (alive[root] != root) root = alive[root];
+        while (alive[k] != root) {
+            const int up = alive[k];
+            alive[k] = root;
+            k = up;
+        }
+        return root;
+    };
+    auto dropReflex = [&](int v) {
+        if (reflexSlot[v] < 0) return;
+        alive[reflexSlot[v]] = reflexSlot[v] + 1;
+        reflexSlot[v] = -1;
+    };
+
+    std::size_t log2n = 1;
+    while ((std::size_t(1) << log2n) < n) ++log2n;
+    const std::size_t budget = 8 * n * log2n;
+    std::size_t work = 0;
+
+    //耳朵判断：p1-p2-p3 为凸角，且包围盒编码区间内没有非凸顶点落在三角形内（含边界）
+    auto isEar = [&](int v) {
+        ++work;
+        const int a = prev[v], c = next[v];
+        const KPoint &p1 = pts[a], &p2 = pts[v], &p3 = pts[c];
+        if (K::orient2d(p1, p2, p3) <= 0) return false;
+        const KPoint boxLo{std::min({p1.x, p2.x, p3.x}), std::min({p1.y, p2.y, p3.y})};
+        const KPoint boxHi{std::max({p1.x, p2.x, p3.x}), std::max({p1.y, p2.y, p3.y})};
+        const std::uint32_t zLo = mortonCode(toPoint(boxLo), lo, scale), zHi = mortonCode(toPoint(boxHi), lo, scale);
+        //从 from 开始倍增步长再二分（跳跃目标通常就在附近），返回编码不小于 z 的第一个存活位置
+        auto firstFrom = [&](std::uint32_t z, int from) {
+            const int size = static_cast<int>(reflex.size());
+            int lower = from, step = 1;
+            while (lower + step < size && reflex[lower + step].z < z) {
+                lower += step;
+                step *= 2;
+            }
+            const auto it = std::lower_bound(reflex.begin() + lower, reflex.begin() + std::min(size, lower + step), z,
+                                             [](const ReflexEntry &e, std::uint32_t key) { return e.z < key; });
+            return nextAlive(static_cast<int>(it - reflex.begin()));
+        };
+        int k = firstFrom(zLo, 0);
+        int misses = 0; //连续落在包围盒外的编码数
+        while (k < static_cast<int>(reflex.size()) && reflex[k].z <= zHi) {
+            ++work;
+            const std::uint32_t z = reflex[k].z;
+            if (!mortonInBox(z, zLo, zHi)) {
+                //偶尔出界时逐个跳过；连续出界说明进入了盒外的一大段编码，用 BIGMIN 一次跳过
+                const std::uint32_t jump = (++misses >= 8) ? mortonBigMin(z, zLo, zHi) : z;
+                k = jump > z ? firstFrom(jump, k) : nextAlive(k + 1);
+                if (jump > z) misses = 0;
+                continue;
+            }
+            misses = 0;
+            const ReflexEntry &entry = reflex[k];
+            k = nextAlive(k + 1);
+            if (entry.vertex == a || entry.vertex == c) continue;
+            const KPoint &q = entry.p;
+            if (q == p1 || q == p2 || q == p3) continue;
+            if (q.x < boxLo.x || q.x > boxHi.x || q.y < boxLo.y || q.y > boxHi.y) continue;
+            if (K::orient2d(p1, p2, q) >= 0 && K::orient2d(p2, p3, q) >= 0 && K::orient2d(p3, p1, q) >= 0) {
+                return false; //三角形内有点，不能剪耳朵
+            }
+        }
+        return true;
+    };
+
+    //候选耳朵：剩余顶点中按环序排列的子链表。切掉一个耳朵只会改变两侧相邻顶点的三角形，
+    //其余顶点要么三角形不变、要么只是少了可能挡住它的反射顶点，所以判定不是耳朵的顶点先移出，
+    //等它成为被切耳朵的邻居时再插回原位，避免每一圈都重新判断整条链
+    std::vector<int> candPrev(prev), candNext(next);
+    std::vector<char> queued(n, 1);
+    std::size_t queuedCount = n;
+    auto unqueue = [&](int v) {
+        candNext[candPrev[v]] = candNext[v];
+        candPrev[candNext[v]] = candPrev[v];
+        queued[v] = 0;
+        --queuedCount;
+    };
+    auto requeue = [&](int v, int before, int after) {
+        if (queued[v]) return;
+        candPrev[v] = before;
+        candNext[v] = after;
+        candNext[before] = v;
+        candPrev[after] = v;
+        queued[v] = 1;
+        ++queuedCount;
+    };
+    auto refill = [&](int from) {
+        int v = from;
+        do {
+            candPrev[v] = prev[v];
+            candNext[v] = next[v];
+            queued[v] = 1;
+            v = next[v];
+        } while (v != from);
+    };
+
+    //耳切主循环：候选为空时重新检查剩余的一整圈，其间一个耳朵都没切掉说明算法无法继续
+    auto emit = [&](int a, int b, int c) {
+        out.push_back(static_cast<std::uint32_t>(ring[a]));
+        out.push_back(static_cast<std::uint32_t>(ring[b]));
+        out.push_back(static_cast<std::uint32_t>(ring[c]));
+    };
+    out.reserve(out.size() + 3 * (n - 2));
+    std::size_t remaining = n;
+    int ear = 0;
+    bool cutSinceRefill = true;
+    while (remaining > 3) {
+        if (work > budget) return EarClipStatus::OverBudget;
+        if (queuedCount == 0) {
+            if (!cutSinceRefill) return EarClipStatus::Stuck; //绕了一整圈仍找不到耳朵 → 算法终止
+            refill(ear);
+            queuedCount = remaining;
+            cutSinceRefill = false;
+        }
+        if (isEar(ear)) {
+            const int a = prev[ear], c = next[ear];
+            emit(a, ear, c);
+            next[a] = c;
+            prev[c] = a;
+            --remaining;
+            //相邻顶点的角只会变小，变凸后就不可能再挡住其他耳朵
+            if (isConvex(a)) dropReflex(a);
+            if (isConvex(c)) dropReflex(c);
+            requeue(a, candPrev[ear], ear);
+            requeue(c, ear, candNext[ear]);
+            unqueue(ear);
+            cutSinceRefill = true;
+            ear = candNext[c]; //与原先沿环推进一样跳过 c，让切下的三角形分布得更均匀
+            continue;
+        }
+        const int following = candNext[ear];
+        unqueue(ear);
+        if (queuedCount > 0) ear = following;
+    }
+
+    //处理最后剩余三角形
+    emit(prev[ear], ear, next[ear]);
+    return EarClipStatus::Done;
+}
+
+//按顶点坐标选定几何内核后切耳；内核只在这里选一次，切耳循环内没有分派
+EarClipStatus earClipRing(const std::vector<Point> &vertices, const std::vector<int> &ring, std::vector<std::uint32_t> &out)
+{
+    return withKernel(chooseKernel(vertices),
+                      [&](auto k) { return earClipRingWith<decltype(k)>(vertices, ring, out); });
+}
+
+//耳切整个 RingSet，定义在单调分解之后（超出预算时要改用它）
+bool earClipRings(const RingSet &rings, std::vector<std::uint32_t> &out);
+
+//剖分结果展开为按值保存顶点的三角形列表
+std::vector<Triangle> expandTriangles(const HalfEdgeMesh &mesh)
+{
+    std::vector<Triangle> triangles;
+    triangles.reserve(mesh.triangleCount());
+    for (std::size_t i = 0; i < mesh.indices.size(); i += 3) {
+        triangles.push_back({mesh.vertices[mesh.indices[i]], mesh.vertices[mesh.indices[i + 1]], mesh.vertices[mesh.indices[i + 2]]});
+    }
+    return triangles;
+}
+
+} // namespace
+
+/**
+ * @brief 使用 Ear Clipping (耳朵裁剪) 算法对简单多边形进行三角剖分。
+ * @details 剩余顶点保存在下标双向链表中，切耳只需 O(1) 地改链接。
+ * 只有非凸（反射或共线）顶点可能落在耳朵三角形内，而切耳只会让相邻顶点变“凸”，
+ * 所以预先把这些顶点按 Morton 编码排序，判断耳朵时只在三角形包围盒对应的编码区间内查找，
+ * 遇到区间内位于包围盒外的编码时用 BIGMIN 跳过；
+ * 顶点变凸或被切掉后用带路径压缩的“下一个存活位置”跳过它。
+ * 候选耳朵沿链表向前推进，切耳后从后继的后继继续；判定不是耳朵的顶点移出候选，直到成为被切耳朵的邻居才重新判断，
+ * 候选耗尽时再检查一整圈，仍找不到耳朵即放弃，避免在退化输入上死循环。
+ * @param polygon 简单多边形的顶点（任意环绕方向，允许首尾重复点）
+ * @return 剖分出的三角形；顶点数不足或算法无法继续时返回 std::nullopt
+ * @note 不在内部调用 isSimplePolygon，简单性由调用方保证。核心循环见 earClipRing。
+ * 梳齿等输入最后会切出罩住大量反射顶点的细长扇形三角形，查找总步数超过 8 n log n 时改用单调分解完成整个剖分。
+ * @complexity O(n log n)：耳朵判断共 O(n) 次，查找反射顶点的步数受上述预算限制。
+ */
+std::optional<std::vector<Triangle>> triangulateEarClipping(PointSpan polygon)
+{
+    //预处理：去掉相邻重复点与首尾重复点，统一为逆时针
+    RingSet rings;
+    if (!appendRing(rings, polygon, true)) return std::nullopt;
+    HalfEdgeMesh mesh;
+    if (!earClipRings(rings, mesh.indices)) return std::nullopt;
+    mesh.vertices = std::move(rings.pts);
+    return expandTriangles(mesh);
+}
+
+namespace {
+
+enum class VertexType { Start, Split, End, Merge, Regular };
+
+/**
+ * @brief 扫描线状态中边的比较器：边 e 指从顶点 e 到其后继的边，且只有“内部在右侧”的下行边才会进入状态
+ * @details 状态中的边两两不相交，新插入的边的上端点总是当前事件点，因此只需判断当前点在已有边的哪一侧。
+ * 同时支持与点比较（透明比较器），用于查找“紧邻某点左侧的边”。
+ */
+struct SweepEdgeLess {
+    using is_transparent = void;
+    const RingSet *rings = nullptr;
+
+    const Point &from(int e) const { return rings->pts[e]; }
+    const Point &to(int e) const { return rings->pts[rings->next[e]]; }
+
+    //点 p 在边 e 的哪一侧：> 0 表示 p 在 e 的右侧（边在点的左边）
+    double side(int e, const Point &p) const { return crossProduct(from(e), to(e), p); }
+
+    bool operator()(int e, const Point &p) const { return side(e, p) > 0; }
+    bool operator()(const Point &p, int e) const { return side(e, p) < 0; }
+    bool operator()(int a, int b) const
+    {
+        if (a == b) return false;
+        //以上端点较晚到达（更靠下）的那条边为准，它的上端点一定落在另一条边的 y 范围内
+        if (isAbove(from(a), from(b))) return !(*this)(b, a);
+        double s = side(b, from(a));
+        if (s == 0) s = side(b, to(a)); //上端点恰在 b 的延长线上时改用下端点判断
+        return s < 0;
+    }
+};
+
+/**
+ * @brief 对一个 y 单调多边形做线性时间三角剖分
+ * @param pts 全部顶点
+ * @param face 单调多边形的顶点下标（逆时针）
+ * @param out [out] 每个三角形追加三个顶点下标（逆时针）
+ * @details 把左右两条链按扫描顺序归并，然后用栈维护尚未剖分的“反射链”：
+ * 新顶点与栈顶不在同一条链时向整条栈连对角线；在同一条链时沿栈回退，直到对角线不再位于多边形内部。
+ * @complexity O(k)，k 为子多边形的顶点数
+ */
+void triangulateMonotonePiece(const std::vector<Point> &pts, const std::vector<int> &face, std::vector<std::uint32_t> &out)
+{
+    const std::size_t k = face.size();
+    if (k < 3) return;
+    auto emit = [&](int a, int b, int c) {
+        if (crossProduct(pts[a], pts[b], pts[c]) < 0) std::swap(b, c);
+        out.push_back(static_cast<std::uint32_t>(a));
+        out.push_back(static_cast<std::uint32_t>(b));
+        out.push_back(static_cast<std::uint32_t>(c));
+    };
+    if (k == 3) {
+        emit(face[0], face[1], face[2]);
+        return;
+    }
+
+    std::size_t top = 0, bottom = 0;
+    for (std::size_t i = 1; i < k; ++i) {
+        if (isAbove(pts[face[i]], pts[face[top]])) top = i;
+        if (isAbove(pts[face[bottom]], pts[face[i]])) bottom = i;
+    }
+
+    //逆时针环绕时，从最高点沿 next 走到最低点是左链，沿 prev 走是右链；两条链各自已按扫描顺序排列
+    struct Item { int v; bool left; };
+    std::vector<Item> order;
+    order.reserve(k);
+    std::size_t l = top, r = (top + k - 1) % k;
+    order.push_back({face[top], true});
+    l = (l + 1) % k;
+    while (l != bottom || r != bottom) {
+        if (r == bottom || (l != bottom && isAbove(pts[face[l]], pts[face[r]]))) {
+            order.push_back({face[l], true});
+            l = (l + 1) % k;
+        } else {
+            order.push_back({face[r], false});
+            r = (r + k - 1) % k;
+        }
+    }
+    order.push_back({face[bottom], !order.back().left}); //最低点视为与栈顶位于不同的链
+
+    std::vector<Item> stack{order[0], order[1]};
+    for (std::size_t j = 2; j < k; ++j) {
+        const Item u = order[j];
+        if (u.left != stack.back().left) {
+            //不同链：与栈中所有相邻顶点对组成三角形
+            for (std::size_t i = 0; i + 1 < stack.size(); ++i) emit(u.v, stack[i].v, stack[i + 1].v);
+            const Item last = stack.back();
+            stack.assign({last, u});
+        } else {
+            //同一条链：只要栈顶的角是凸的就切下一个三角形
+            Item last = stack.back();
+            stack.pop_back();
+            while (!stack.empty()) {
+                const Point &a = pts[stack.back().v], &b = pts[last.v], &c = pts[u.v];
+                const double turn = u.left ? crossProduct(a, b, c) : crossProduct(c, b, a);
+                if (turn <= 0) break;
+                emit(u.v, last.v, stack.back().v);
+                last = stack.back();
+                stack.pop_back();
+            }
+            stack.push_back(last);
+            stack.push_back(u);
+        }
+    }
+}
+/**
+ * @brief 扫描线把多边形（可带孔洞）分解为 y 单调的子多边形
+ * @details 按 de Berg 等《计算几何》中的算法，从上到下处理顶点，在每个分裂点（split）和合并点（merge）处补一条对角线；
+ * 扫描线状态是一棵按 x 排序的平衡树，只保存“内部在右侧”的边及其 helper 顶点。
+ * 孔洞的最高点总是分裂点，它连出的对角线就把孔洞与更早扫描到的环接在一起。
+ * @return 新增的对角线，first 为补对角线时正在处理的顶点；检测到自相交等退化情况时返回 std::nullopt
+ * @complexity O(n log n)，瓶颈在顶点排序与扫描线状态的查找
+ */
+std::optional<std::vector<std::pair<int, int>>> monotoneDiagonals(const RingSet &rings)
+{
+    const std::vector<Point> &pts = rings.pts;
+    const std::size_t n = pts.size();
+
+    //顶点分类
+    std::vector<VertexType> type(n, VertexType::Regular);
+    for (std::size_t i = 0; i < n; ++i) {
+        const Point &a = pts[rings.prev[i]], &v = pts[i], &b = pts[rings.next[i]];
+        const bool prevBelow = isAbove(v, a), nextBelow = isAbove(v, b);
+        if (prevBelow != nextBelow) continue;
+        const double turn = crossProduct(a, v, b);
+        if (turn == 0) return std::nullopt; //原路折返的尖刺，不是简单多边形
+        if (prevBelow) type[i] = turn > 0 ? VertexType::Start : VertexType::Split;
+        else type[i] = turn > 0 ? VertexType::End : VertexType::Merge;
+    }
+
+    std::vector<int> order(n);
+    for (std::size_t i = 0; i < n; ++i) order[i] = static_cast<int>(i);
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return isAbove(pts[a], pts[b]); });
+
+    //扫描线分解为单调多边形，diagonals 记录新增的对角线
+    using Status = std::set<int, SweepEdgeLess>;
+    Status status(SweepEdgeLess{&rings});
+    std::vector<Status::iterator> position(n, status.end());
+    std::vector<int> helper(n, -1);
+    std::vector<std::pair<int, int>> diagonals;
+
+    auto leftEdgeOf = [&](const Point &p) -> int {
+        auto it = status.lower_bound(p);
+        if (it == status.begin()) return -1;
+        return *--it;
+    };
+    //与状态中已有的边等价（重合的边）说明环相交，插入失败
+    auto insertEdge = [&](int e) {
+        const auto inserted = status.insert(e);
+        if (!inserted.second) return false;
+        position[e] = inserted.first;
+        helper[e] = e;
+        return true;
+    };
+    //结束边 e 前，若其 helper 为合并点则需要补对角线
+    auto finishEdge = [&](int e, int v) {
+        if (position[e] == status.end()) return false;
+        if (type[helper[e]] == VertexType::Merge) diagonals.emplace_back(v, helper[e]);
+        status.erase(position[e]);
+        position[e] = status.end();
+        return true;
+    };
+    //把 v 左侧边的 helper 改为 v，必要时先补对角线
+    auto updateLeft = [&](int v) {
+        const int left = leftEdgeOf(pts[v]);
+        if (left < 0) return false;
+        if (type[helper[left]] == VertexType::Merge) diagonals.emplace_back(v, helper[left]);
+        helper[left] = v;
+        return true;
+    };
+
+    for (int v : order) {
+        const int before = rings.prev[v];
+        bool ok = true;
+        switch (type[v]) {
+        case VertexType::Start:
+            ok = insertEdge(v);
+            break;
+        case VertexType::End:
+            ok = finishEdge(before, v);
+            break;
+        case VertexType::Split: {
+            const int left = leftEdgeOf(pts[v]);
+            if (left < 0) return std::nullopt;
+            diagonals.emplace_back(v, helper[left]);
+            helper[left] = v;
+            ok = insertEdge(v);
+            break;
+        }
+        case VertexType::Merge:
+            ok = finishEdge(before, v) && updateLeft(v);
+            break;
+        case VertexType::Regular:
+            if (isAbove(pts[before], pts[v])) { //内部在右侧：位于左链上
+                ok = finishEdge(before, v) && insertEdge(v);
+            } else {
+                ok = updateLeft(v);
+            }
+            break;
+        }
+        if (!ok) return std::nullopt;
+    }
+    return diagonals;
+}
+
+/**
+ * @brief 追踪由环的边与对角线围成的每个面，依次交给 visit
+ * @details 在对角线端点处按极角排序出边，沿 u→v 到达 v 后取 v 的出边中按极角排在 u 之前的那条（即顺时针方向的下一条），
+ * 这样每个面都按逆时针顺序走出。对角线两两不交时，面的个数等于对角线条数减去环数再加 2。
+ * @param visit 回调，参数为一个面的顶点下标（对角线端点在桥接后的面中可能出现多次）
+ * @return 沿环的边反向行走（说明输入不是合法的带孔多边形）时返回 false
+ * @complexity O(n + d log d)，d 为对角线条数
+ */
+template <typename Visit>
+bool traceFaces(const RingSet &rings, const std::vector<std::pair<int, int>> &diagonals, Visit &&visit)
+{
+    const std::vector<Point> &pts = rings.pts;
+    const std::size_t n = pts.size();
+
+    //建立邻接表：每个顶点的出边为 next 以及所有对角线，按从 next 方向开始的逆时针极角排序
+    std::vector<int> degree(n + 1, 0);
+    for (const auto &d : diagonals) {
+        ++degree[d.first + 1];
+        ++degree[d.second + 1];
+    }
+    std::vector<int> start(n + 1, 0);
+    for (std::size_t i = 0; i < n; ++i) start[i + 1] = start[i] + 1 + degree[i + 1];
+    std::vector<int> adj(start[n]);
+    std::vector<int> fill(start.begin(), start.end() - 1);
+    for (std::size_t i = 0; i < n; ++i) adj[fill[i]++] = rings.next[i];
+    for (const auto &d : diagonals) {
+        adj[fill[d.first]++] = d.second;
+        adj[fill[d.second]++] = d.first;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (start[i + 1] - start[i] <= 1) continue;
+        const Point o = pts[i];
+        const Point base = pts[rings.next[i]] - o;
+        //相对 base 的逆时针角度所在的半平面：0 表示 [0, π)，1 表示 [π, 2π)
+        auto half = [&](const Point &w) {
+            const double c = base.x * w.y - base.y * w.x;
+            return (c > 0 || (c == 0 && base.x * w.x + base.y * w.y > 0)) ? 0 : 1;
+        };
+        std::sort(adj.begin() + start[i] + 1, adj.begin() + start[i + 1], [&](int a, int b) {
+            const Point wa = pts[a] - o, wb = pts[b] - o;
+            const int ha = half(wa), hb = half(wb);
+            if (ha != hb) return ha < hb;
+            return wa.x * wb.y - wa.y * wb.x > 0;
+        });
+    }
+
+    std::vector<char> used(adj.size(), 0);
+    std::vector<int> face;
+    for (std::size_t s = 0; s < n; ++s) {
+        for (int h = start[s]; h < start[s + 1]; ++h) {
+            if (used[h]) continue;
+            face.clear();
+            int u = static_cast<int>(s), edge = h;
+            while (!used[edge]) {
+                used[edge] = 1;
+                face.push_back(u);
+                const int v = adj[edge];
+                int k = start[v];
+                while (k < start[v + 1] && adj[k] != u) ++k;
+                if (k == start[v + 1]) { //u 是 v 的 prev，沿环的边到达：取极角最大的出边
+                    edge = start[v + 1] - 1;
+                } else if (k == start[v]) { //沿环的边反向行走，说明走到了外部
+                    return false;
+                } else {
+                    edge = k - 1;
+                }
+                u = v;
+            }
+            if (edge != h || u != static_cast<int>(s)) return false;
+            visit(face);
+        }
+    }
+    return true;
+}
+
+//单调分解 + 逐块线性剖分，三角形的顶点下标追加到 out；r 个环（含外边界）共 n 个顶点时应得到 n + 2r - 4 个三角形
+bool triangulateMonotoneRings(const RingSet &rings, std::vector<std::uint32_t> &out)
+{
+    const auto diagonals = monotoneDiagonals(rings);
+    if (!diagonals) return false;
+    const std::size_t expected = 3 * (rings.pts.size() + 2 * rings.top.size() - 4);
+    out.reserve(out.size() + expected);
+    const std::size_t before = out.size();
+    const bool ok = traceFaces(rings, *diagonals, [&](const std::vector<int> &face) {
+        triangulateMonotonePiece(rings.pts, face, out);
+    });
+    return ok && out.size() - before == expected;
+}
+
+/**
+ * @brief 用桥边把所有孔洞接到外边界上，合并成一个环
+ * @details 单调分解的扫描线在每个孔洞的最高点处向左侧边的 helper 连一条对角线：
+ * helper 比该点更早被扫描到，所以不在同一个孔洞上，且两者之间没有任何边穿过。
+ * 只保留这些对角线作为桥，它们把所有环连成一棵以外边界为根的树，沿区域内部追踪得到唯一的面，
+ * 每座桥在其中正反各走一次。
+ * @return 合并后的环上依次经过的顶点下标，桥的端点出现两次但下标相同；只有外边界时就是 0..n-1
+ * @complexity O(n log n)，选桥相当于对每个孔洞做一次扫描线状态上的 O(log n) 查询
+ */
+std::optional<std::vector<int>> bridgeRings(const RingSet &rings)
+{
+    if (rings.top.size() == 1) {
+        std::vector<int> ring(rings.pts.size());
+        std::iota(ring.begin(), ring.end(), 0);
+        return ring;
+    }
+    const auto diagonals = monotoneDiagonals(rings);
+    if (!diagonals) return std::nullopt;
+    std::vector<char> holeTop(rings.pts.size(), 0);
+    for (std::size_t r = 1; r < rings.top.size(); ++r) holeTop[rings.top[r]] = 1;
+    std::vector<std::pair<int, int>> bridges;
+    bridges.reserve(rings.top.size() - 1);
+    for (const auto &d : *diagonals) {
+        if (holeTop[d.first]) bridges.push_back(d); //最高点是分裂点，它只会作为 first 连出这一条对角线
+    }
+    if (bridges.size() != rings.top.size() - 1) return std::nullopt;
+
+    std::vector<int> merged;
+    int faces = 0;
+    const bool ok = traceFaces(rings, bridges, [&](const std::vector<int> &face) {
+        ++faces;
+        merged = face;
+    });
+    if (!ok || faces != 1) return std::nullopt;
+    return merged;
+}
+
+//孔洞先桥接到外边界上再切耳；查找量超出预算时丢弃已切的三角形，整体改用单调分解
+bool earClipRings(const RingSet &rings, std::vector<std::uint32_t> &out)
+{
+    const auto ring = bridgeRings(rings);
+    if (!ring) return false;
+    const std::size_t before = out.size();
+    const EarClipStatus status = earClipRing(rings.pts, *ring, out);
+    if (status != EarClipStatus::OverBudget) return status == EarClipStatus::Done;
+    out.resize(before);
+    return triangulateMonotoneRings(rings, out);
+}
+
+/**
+ * @brief 按算法剖分外边界与可选的孔洞，得到共享的顶点缓冲与三角形下标（尚未建立半边邻接）
+ * @details 耳切法与单调分解的顶点缓冲是去重、定向后的各环顶点；约束 Delaunay 直接沿用其网格的顶点。
+ * @param outer 外边界
+ * @param holed 带孔洞输入；为空时只剖分 outer
+ */
+std::optional<HalfEdgeMesh> triangulateIndexed(PointSpan outer, const PolygonWithHoles *holed,
+                                               TriangulationAlgorithm algorithm)
+{
+    HalfEdgeMesh mesh;
+    if (algorithm == TriangulationAlgorithm::ConstrainedDelaunay) {
+        const auto cdt = holed ? constrainedDelaunay(*holed) : constrainedDelaunay(outer);
+        if (!cdt) return std::nullopt;
+        mesh.vertices = cdt->vertices;
+        mesh.indices.reserve(cdt->triangles.size() * 3);
+        for (const auto &t : cdt->triangles) {
+            for (int v : t) mesh.indices.push_back(static_cast<std::uint32_t>(v));
+        }
+        return mesh;
+    }
+
+    //孔洞与外边界或彼此相交、接触、嵌套时扫描线的前提不成立，先整体检查一遍（约束 Delaunay 自己会检查）
+    if (holed && !isSimplePolygonWithHoles(*holed)) return std::nullopt;
+    RingSet rings;
+    if (!appendRing(rings, outer, true)) return std::nullopt;
+    if (holed) {
+        for (const Polygon &hole : holed->holes) appendRing(rings, hole, false);
+    }
+    bool ok = false;
+    if (algorithm == TriangulationAlgorithm::Monotone) {
+        ok = triangulateMonotoneRings(rings, mesh.indices);
+    } else {
+        ok = earClipRings(rings, mesh.indices);
+    }
+    if (!ok) return std::nullopt;
+    mesh.vertices = std::move(rings.pts);
+    return mesh;
+}
+
+//写入一次剖分的统计信息
+void recordStats(TriangulationStats *stats, std::size_t vertexCount, std::size_t triangleCount,
+                 std::chrono::steady_clock::time_point begin)
+{
+    if (!stats) return;
+    stats->vertexCount = vertexCount;
+    stats->triangleCount = triangleCount;
+    stats->elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+//带孔洞输入的顶点总数
+std::size_t ringVertexCount(const PolygonWithHoles &polygon)
+{
+    std::size_t count = polygon.outer.size();
+    for (const Polygon &hole : polygon.holes) count += hole.size();
+    return count;
+}
+
+} // namespace
+
+/**
+ * @brief 通过单调多边形分解对简单多边形进行三角剖分
+ * @details 第一步用扫描线把多边形分解为若干 y 单调多边形（见 monotoneDiagonals），
+ * 第二步在对角线端点处按极角排序出边，追踪出每个单调子多边形，
+ * 最后对每块用栈做线性时间剖分。
+ * @param polygon 简单多边形的顶点（任意环绕方向，允许首尾重复点）
+ * @return 剖分出的 n - 2 个三角形（逆时针）；顶点数不足或检测到自相交等退化情况时返回 std::nullopt
+ * @note 为了支持百万级顶点，这里不重复调用 isSimplePolygon，简单性由调用方保证。
+ * @complexity O(n log n)，瓶颈在顶点排序与扫描线状态的查找
+ */
+std::optional<std::vector<Triangle>> triangulateMonotone(PointSpan polygon)
+{
+    RingSet rings;
+    if (!appendRing(rings, polygon, true)) return std::nullopt;
+    HalfEdgeMesh mesh;
+    if (!triangulateMonotoneRings(rings, mesh.indices)) return std::nullopt;
+    mesh.vertices = std::move(rings.pts);
+    return expandTriangles(mesh);
+}
+
+/**
+ * @brief 用桥边把孔洞并入外边界，得到一个弱简单多边形
+ * @param polygon 外边界与孔洞（环绕方向任意，内部统一调整为外边界逆时针、孔洞顺时针），不足 3 个顶点的孔洞被忽略
+ * @return 合并后的环（逆时针），共 n + 2h 个顶点，每座桥的两个端点各出现两次；
+ * 外边界不足 3 个顶点、环相交或接触、孔洞不在外边界内部或相互嵌套时返回 std::nullopt
+ * @note 合法性由 isSimplePolygonWithHoles 检查，也是一次 O(n log n) 的扫描。
+ * @complexity O(n log n)，与孔洞个数无关
+ */
+std::optional<Polygon> bridgeHoles(const PolygonWithHoles &polygon)
+{
+    if (!isSimplePolygonWithHoles(polygon)) return std::nullopt;
+    RingSet rings;
+    if (!appendRing(rings, polygon.outer, true)) return std::nullopt;
+    for (const Polygon &hole : polygon.holes) appendRing(rings, hole, false);
+    const auto ring = bridgeRings(rings);
+    if (!ring) return std::nullopt;
+    Polygon merged;
+    merged.reserve(ring->size());
+    for (int v : *ring) merged.push_back(rings.pts[v]);
+    return merged;
+}
+
+/**
+ * @brief 按指定算法三角剖分，统一记录输入规模、输出三角形数和墙钟耗时
+ * @param polygon 多边形顶点
+ * @param algorithm 使用的算法
+ * @param stats [out] 可选，非空时写入本次计算的统计信息
+ * @return 剖分出的三角形；算法失败时返回 std::nullopt
+ */
+std::optional<std::vector<Triangle>> triangulatePolygon(PointSpan polygon, TriangulationAlgorithm algorithm,
+                                                        TriangulationStats *stats)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    std::optional<std::vector<Triangle>> triangles;
+    if (const auto mesh = triangulateIndexed(polygon, nullptr, algorithm)) triangles = expandTriangles(*mesh);
+    recordStats(stats, polygon.size(), triangles ? triangles->size() : 0, begin);
+    return triangles;
+}
+
+/**
+ * @brief 带孔洞多边形的三角剖分
+ * @details
+ * - 耳切法：先用 bridgeHoles 把孔洞并入外边界，再对合并后的环做耳切；
+ * - 单调多边形分解法：扫描线本身就能处理多个环，孔洞的最高点作为分裂点自然被连出对角线；
+ * - 约束 Delaunay：所有环的边都作为约束，按穿过约束边次数的奇偶性挖去孔洞。
+ * 三种算法都先用 isSimplePolygonWithHoles 检查输入。
+ * @param polygon 外边界与孔洞（环绕方向任意）
+ * @param algorithm 使用的算法
+ * @param stats [out] 可选，vertexCount 为所有环的顶点总数
+ * @return 剖分出的三角形（n 个顶点、h 个孔洞时为 n + 2h - 2 个）；
+ * 环相交或接触、孔洞不在外边界内部或相互嵌套、以及算法失败时返回 std::nullopt
+ */
+std::optional<std::vector<Triangle>> triangulatePolygonWithHoles(const PolygonWithHoles &polygon,
+                                                                 TriangulationAlgorithm algorithm,
+                                                                 TriangulationStats *stats)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    std::optional<std::vector<Triangle>> triangles;
+    if (const auto mesh = triangulateIndexed(polygon.outer, &polygon, algorithm)) triangles = expandTriangles(*mesh);
+    recordStats(stats, ringVertexCount(polygon), triangles ? triangles->size() : 0, begin);
+    return triangles;
+}
+
+/**
+ * @brief 按指定算法三角剖分，输出带半边邻接的索引网格
+ * @details 与 triangulatePolygon 使用同一套算法，但不展开成按值保存的三角形：顶点只存一份，
+ * 每个三角形三个 uint32 下标，并建立半边的反向关系，边界边、相邻三角形都可以 O(1) 查询。
+ * @param polygon 多边形顶点
+ * @param algorithm 使用的算法
+ * @param stats [out] 可选，耗时包含建立邻接的时间
+ * @return 半边网格；算法失败时返回 std::nullopt
+ */
+std::optional<HalfEdgeMesh> triangulatePolygonMesh(PointSpan polygon, TriangulationAlgorithm algorithm,
+                                                   TriangulationStats *stats)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    auto mesh = triangulateIndexed(polygon, nullptr, algorithm);
+    if (mesh) buildHalfEdges(*mesh);
+    recordStats(stats, polygon.size(), mesh ? mesh->triangleCount() : 0, begin);
+    return mesh;
+}
+
+/**
+ * @brief 带孔洞多边形的三角剖分，输出带半边邻接的索引网格
+ * @details 耳切法桥接孔洞时桥的端点使用同一个顶点下标，所以桥边两侧的三角形互为邻居，
+ * 只有外边界与孔洞的边是边界半边。
+ * @param polygon 外边界与孔洞（环绕方向任意）
+ * @param algorithm 使用的算法
+ * @param stats [out] 可选，vertexCount 为所有环的顶点总数
+ * @return 半边网格；算法失败时返回 std::nullopt
+ */
+std::optional<HalfEdgeMesh> triangulatePolygonWithHolesMesh(const PolygonWithHoles &polygon,
+                                                            TriangulationAlgorithm algorithm,
+                                                            TriangulationStats *stats)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    auto mesh = triangulateIndexed(polygon.outer, &polygon, algorithm);
+    if (mesh) buildHalfEdges(*mesh);
+    recordStats(stats, ringVertexCount(polygon), mesh ? mesh->triangleCount() : 0, begin);
+    return mesh;
+}
+
+} // namespace Geometry
@@ -0,0 +1,50 @@
+#ifndef TRIANGULATION_H
+#define TRIANGULATION_H
+/*Triangulation 提供简单多边形（以及带孔洞多边形）三角剖分的纯函数实现*/
+#include "GeometryTypes.h"
+#include "HalfEdgeMesh.h"
+#include <optional>
+
+namespace Geometry {
+
+// Ear Clipping 耳切法：链表 + 按 Morton 编码索引的反射顶点集合，典型输入接近线性；
+// 要求输入是简单多边形，输入不足 3 个顶点或算法无法继续时返回 std::nullopt
+std::optional<std::vector<Triangle>> triangulateEarClipping(PointSpan polygon);
+
+// 单调多边形分解法：扫描线把多边形分解为 y 单调的子多边形，再对每块线性时间剖分，O(n log n)；
+// 要求输入是简单多边形（不做 O(n^2) 的自相交检查），检测到退化输入时返回 std::nullopt
+std::optional<std::vector<Triangle>> triangulateMonotone(PointSpan polygon);
+
+// ConstrainedDelaunay 以多边形边为约束做 Delaunay 剖分（见 ConstrainedDelaunay.h），三角形形状最好，期望 O(n log n)
+enum class TriangulationAlgorithm { EarClipping, Monotone, ConstrainedDelaunay };
+
+//一次三角剖分的统计信息，用于比较不同算法
+struct TriangulationStats {
+    std::size_t vertexCount = 0;   // 输入顶点数 n
+    std::size_t triangleCount = 0; // 输出三角形数（成功时为 n - 2）
+    double elapsedMs = 0.0;        // 墙钟耗时（毫秒）
+};
+
+// 按指定算法三角剖分，并可选地输出统计信息
+std::optional<std::vector<Triangle>> triangulatePolygon(PointSpan polygon, TriangulationAlgorithm algorithm,
+                                                        TriangulationStats *stats = nullptr);
+
+// 用桥边把孔洞并入外边界，输出 n + 2h 个顶点的弱简单多边形（逆时针）；桥由单调分解的扫描线选出，
+// 总计 O(n log n)，孔洞再多也不会退化成逐个孔洞线性搜索。孔洞须两两不交且位于外边界内部
+std::optional<Polygon> bridgeHoles(const PolygonWithHoles &polygon);
+
+// 带孔洞多边形的三角剖分：耳切法先桥接再剖分，单调分解与约束 Delaunay 直接处理多个环
+std::optional<std::vector<Triangle>> triangulatePolygonWithHoles(const PolygonWithHoles &polygon,
+                                                                 TriangulationAlgorithm algorithm,
+                                                                 TriangulationStats *stats = nullptr);
+
+// 与上面两个函数相同，但输出共享顶点的索引网格（uint32 下标 + 半边邻接），边界边与相邻三角形 O(1) 查询
+std::optional<HalfEdgeMesh> triangulatePolygonMesh(PointSpan polygon, TriangulationAlgorithm algorithm,
+                                                   TriangulationStats *stats = nullptr);
+std::optional<HalfEdgeMesh> triangulatePolygonWithHolesMesh(const PolygonWithHoles &polygon,
+                                                            TriangulationAlgorithm algorithm,
+                                                            TriangulationStats *stats = nullptr);
+
+} // namespace Geometry
+
+#endif // TRIANGULATION_H
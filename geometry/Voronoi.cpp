@@ -0,0 +1,101 @@
+#include "Voronoi.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+namespace Geometry {
+
+namespace {
+
+//三角形 abc 的外接圆心，按相对 a 的坐标计算以减小舍入误差
+Point circumcenter(const Point &a, const Point &b, const Point &c)
+{
+    const double bx = b.x - a.x, by = b.y - a.y, cx = c.x - a.x, cy = c.y - a.y;
+    const double d = 2 * (bx * cy - by * cx);
+    const double b2 = bx * bx + by * by, c2 = cx * cx + cy * cy;
+    return {a.x + (cy * b2 - by * c2) / d, a.y + (bx * c2 - cx * b2) / d};
+}
+
+} // namespace
+
+/**
+ * @brief 由 Delaunay 三角网格求 Voronoi 图（对偶图）
+ * @details
+ * 1. 把每个三角形的三条有向边 a→b 按起点 a 分组存成 CSR 数组，a→b 的孪生边 b→a 只需在 b 的出边中查找，
+ *    平均度数为 6，整体线性时间，不需要哈希表或排序；
+ * 2. 按三角形分块并行：每块求出外接圆心，并为每条边生成 Voronoi 边——
+ *    内部边只由下标较小的三角形输出一次（连接两个外接圆心），凸包边输出一条沿外法线方向的射线；
+ * 3. 按块的顺序拼接，结果与线程数无关。
+ */
+VoronoiDiagram voronoiDiagram(const TriangleMesh &delaunay, unsigned threadCount)
+{
+    const auto &tris = delaunay.triangles;
+    const auto &pts = delaunay.vertices;
+    const std::size_t m = tris.size();
+    VoronoiDiagram diagram;
+    if (m == 0) return diagram;
+
+    // 1. 出边 CSR：outgoing[start[a] .. start[a+1]) 是以 a 为起点的 (终点, 三角形)
+    std::vector<int> start(pts.size() + 1, 0);
+    for (const auto &tri : tris) {
+        for (int v : tri) ++start[v + 1];
+    }
+    for (std::size_t v = 0; v < pts.size(); ++v) start[v + 1] += start[v];
+    std::vector<std::pair<int, int>> outgoing(3 * m);
+    {
+        std::vector<int> cursor(start.begin(), start.end() - 1);
+        for (std::size_t t = 0; t < m; ++t) {
+            for (int i = 0; i < 3; ++i) outgoing[cursor[tris[t][i]]++] = {tris[t][(i + 1) % 3], static_cast<int>(t)};
+        }
+    }
+    auto twin = [&](int a, int b) {
+        for (int k = start[b]; k < start[b + 1]; ++k) {
+            if (outgoing[k].first == a) return outgoing[k].second;
+        }
+        return -1;
+    };
+
+    // 2. 分块并行求外接圆心与 Voronoi 边
+    const std::size_t minPerThread = 1 << 15; // 每个线程至少分到的三角形数
+    const unsigned T = static_cast<unsigned>(std::max<std::size_t>(
+        1, std::min<std::size_t>(ThreadPool::resolveThreadCount(threadCount), m / minPerThread)));
+    ThreadPool *pool = &ThreadPool::global();
+    std::unique_ptr<ThreadPool> ownPool;
+    if (T > pool->size()) {
+        ownPool = std::make_unique<ThreadPool>(T);
+        pool = ownPool.get();
+    }
+    diagram.vertices.resize(m);
+    std::vector<std::vector<VoronoiEdge>> chunks(T);
+    pool->parallelFor(T, [&](std::size_t c) {
+        const std::size_t first = c * m / T, last = (c + 1) * m / T;
+        std::vector<VoronoiEdge> &edges = chunks[c];
+        edges.reserve((last - first) * 3 / 2 + 3);
+        for (std::size_t t = first; t < last; ++t) {
+            const auto &tri = tris[t];
+            diagram.vertices[t] = circumcenter(pts[tri[0]], pts[tri[1]], pts[tri[2]]);
+            for (int i = 0; i < 3; ++i) {
+                const int a = tri[i], b = tri[(i + 1) % 3];
+                const int u = twin(a, b);
+                if (u >= 0) {
+                    if (static_cast<std::size_t>(u) > t) edges.push_back({a, b, static_cast<int>(t), u, {}});
+                    continue;
+                }
+                //凸包边：三角形逆时针，外侧在 a→b 的右边
+                const double dx = pts[b].x - pts[a].x, dy = pts[b].y - pts[a].y;
+                const double len = std::hypot(dx, dy);
+                edges.push_back({a, b, static_cast<int>(t), -1, {dy / len, -dx / len}});
+            }
+        }
+    });
+
+    // 3. 按块顺序拼接
+    std::size_t total = 0;
+    for (const auto &edges : chunks) total += edges.size();
+    diagram.edges.reserve(total);
+    for (const auto &edges : chunks) diagram.edges.insert(diagram.edges.end(), edges.begin(), edges.end());
+    return diagram;
+}
+
+} // namespace Geometry
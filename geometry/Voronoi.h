@@ -0,0 +1,32 @@
+#ifndef VORONOI_H
+#define VORONOI_H
+/*Voronoi 由 Delaunay 三角网格求对偶得到 Voronoi 图：三角形的外接圆心是 Voronoi 顶点，相邻三角形的圆心连线是 Voronoi 边*/
+#include "GeometryTypes.h"
+
+namespace Geometry {
+
+//Voronoi 图的一条边，对应一条 Delaunay 边；凸包边对应的 Voronoi 边是一条射线
+struct VoronoiEdge {
+    int site1 = -1;   // 被这条边分开的两个输入点（Delaunay 边的两个端点）
+    int site2 = -1;
+    int vertex1 = -1; // 起点（Voronoi 顶点下标）
+    int vertex2 = -1; // 终点；-1 表示从 vertex1 出发沿 direction 的射线
+    Point direction;  // 射线方向（单位向量，指向凸包外侧），仅射线有效
+};
+
+struct VoronoiDiagram {
+    std::vector<Point> vertices;    // 第 i 个顶点是第 i 个 Delaunay 三角形的外接圆心
+    std::vector<VoronoiEdge> edges; // 每条 Delaunay 边恰好对应一条
+};
+
+/**
+ * @brief 由 Delaunay 三角网格求 Voronoi 图
+ * @param delaunay delaunayTriangulation / delaunayTriangulationParallel 的结果
+ * @param threadCount 线程数，0 表示硬件并发数；三角形较少时单线程执行
+ * @complexity O(n)
+ */
+VoronoiDiagram voronoiDiagram(const TriangleMesh &delaunay, unsigned threadCount = 0);
+
+} // namespace Geometry
+
+#endif // VORONOI_H